@@ -0,0 +1,141 @@
+///
+/// @file ValueLocTable.cpp
+/// @brief 后端记录函数内Value的寄存器与栈内位置的表
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "ValueLocTable.h"
+#include "Function.h"
+#include "RegVariable.h"
+#include "TempVariable.h"
+
+/// @brief 清空表并为函数的Value预留空间，每个函数处理前调用
+/// @param func 要处理的函数
+void ValueLocTable::reset(Function * func)
+{
+    locs.assign(func->getValueCount(), Loc());
+    others.clear();
+}
+
+/// @brief 查找Value的位置，不存在时不创建
+/// @param val Value
+/// @return const Loc* 位置，不存在时为空
+const ValueLocTable::Loc * ValueLocTable::find(Value * val) const
+{
+    int32_t index = val->getValueIndex();
+    if (index >= 0) {
+        return ((size_t) index < locs.size()) ? &locs[index] : nullptr;
+    }
+
+    auto pIter = others.find(val);
+    return (pIter != others.end()) ? &pIter->second : nullptr;
+}
+
+/// @brief 获取Value的位置，不存在时创建
+/// @param val Value
+/// @return Loc& 位置
+ValueLocTable::Loc & ValueLocTable::get(Value * val)
+{
+    int32_t index = val->getValueIndex();
+    if (index < 0) {
+        return others[val];
+    }
+
+    // 后端处理时新建的指令与内存变量的编号可能超出reset时的大小
+    if ((size_t) index >= locs.size()) {
+        locs.resize(index + 1);
+    }
+
+    return locs[index];
+}
+
+/// @brief 获得分配的寄存器编号
+/// @param val Value
+/// @return int32_t 寄存器编号，-1表示没有分配寄存器
+int32_t ValueLocTable::getRegId(Value * val) const
+{
+    // 寄存器变量的寄存器是固定的
+    if (auto * regVal = dyn_cast<RegVariable>(val)) {
+        return regVal->getRegId();
+    }
+
+    const Loc * loc = find(val);
+    if (!loc) {
+        return -1;
+    }
+
+    // 临时变量没有栈内空间，只存在于加载或定值时分配给它的寄存器中
+    if ((loc->regId == -1) && isa<TempVariable>(val)) {
+        return loc->loadRegId;
+    }
+
+    return loc->regId;
+}
+
+/// @brief 设置分配的寄存器编号
+/// @param val Value
+/// @param regId 寄存器编号
+void ValueLocTable::setRegId(Value * val, int32_t regId)
+{
+    get(val).regId = regId;
+}
+
+/// @brief 获得Load用的寄存器编号
+/// @param val Value
+/// @return int32_t 寄存器编号，-1表示没有加载
+int32_t ValueLocTable::getLoadRegId(Value * val) const
+{
+    const Loc * loc = find(val);
+    return loc ? loc->loadRegId : -1;
+}
+
+/// @brief 设置Load用的寄存器编号
+/// @param val Value
+/// @param regId 寄存器编号
+void ValueLocTable::setLoadRegId(Value * val, int32_t regId)
+{
+    get(val).loadRegId = regId;
+}
+
+/// @brief 如是内存变量型Value，则获取基址寄存器和偏移
+/// @param val Value
+/// @param baseRegId 基址寄存器编号
+/// @param offset 相对偏移
+/// @return true 是内存型变量
+/// @return false 不是内存型变量
+bool ValueLocTable::getMemoryAddr(Value * val, int32_t * baseRegId, int64_t * offset) const
+{
+    const Loc * loc = find(val);
+    if (!loc || (loc->baseRegId == -1)) {
+        return false;
+    }
+
+    if (baseRegId) {
+        *baseRegId = loc->baseRegId;
+    }
+    if (offset) {
+        *offset = loc->offset;
+    }
+
+    return true;
+}
+
+/// @brief 设置内存寻址的基址寄存器和偏移
+/// @param val Value
+/// @param baseRegId 基址寄存器编号
+/// @param offset 偏移
+void ValueLocTable::setMemoryAddr(Value * val, int32_t baseRegId, int64_t offset)
+{
+    Loc & loc = get(val);
+    loc.baseRegId = baseRegId;
+    loc.offset = (int32_t) offset;
+}
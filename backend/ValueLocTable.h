@@ -0,0 +1,129 @@
+///
+/// @file ValueLocTable.h
+/// @brief 后端记录函数内Value的寄存器与栈内位置的表
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 寄存器分配与栈空间分配的结果不再保存在IR的Value中，而是由后端按函数内的稠密编号
+/// 保存在数组中。同一份IR可由多个后端或多个线程各自持有一张表，互不干扰。
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Value.h"
+
+class Function;
+
+///
+/// @brief 函数内Value的寄存器与栈内位置表，以Value的稠密编号为下标
+///
+class ValueLocTable {
+
+public:
+    ///
+    /// @brief 一个Value的位置
+    ///
+    struct Loc {
+
+        /// @brief 分配的寄存器编号，-1表示没有分配寄存器
+        int32_t regId = -1;
+
+        /// @brief 加载到寄存器时对应的寄存器编号，-1表示没有加载
+        int32_t loadRegId = -1;
+
+        /// @brief 栈内寻址时的基址寄存器编号，-1表示不在栈内
+        int32_t baseRegId = -1;
+
+        /// @brief 栈内寻址时相对基址寄存器的偏移
+        int32_t offset = 0;
+    };
+
+    ///
+    /// @brief 清空表并为函数的Value预留空间，每个函数处理前调用
+    /// @param func 要处理的函数
+    ///
+    void reset(Function * func);
+
+    ///
+    /// @brief 获得分配的寄存器编号
+    /// @param val Value
+    /// @return int32_t 寄存器编号，-1表示没有分配寄存器
+    ///
+    [[nodiscard]] int32_t getRegId(Value * val) const;
+
+    ///
+    /// @brief 设置分配的寄存器编号
+    /// @param val Value
+    /// @param regId 寄存器编号
+    ///
+    void setRegId(Value * val, int32_t regId);
+
+    ///
+    /// @brief 获得Load用的寄存器编号
+    /// @param val Value
+    /// @return int32_t 寄存器编号，-1表示没有加载
+    ///
+    [[nodiscard]] int32_t getLoadRegId(Value * val) const;
+
+    ///
+    /// @brief 设置Load用的寄存器编号
+    /// @param val Value
+    /// @param regId 寄存器编号
+    ///
+    void setLoadRegId(Value * val, int32_t regId);
+
+    ///
+    /// @brief 如是内存变量型Value，则获取基址寄存器和偏移
+    /// @param val Value
+    /// @param baseRegId 基址寄存器编号
+    /// @param offset 相对偏移
+    /// @return true 是内存型变量
+    /// @return false 不是内存型变量
+    ///
+    bool getMemoryAddr(Value * val, int32_t * baseRegId = nullptr, int64_t * offset = nullptr) const;
+
+    ///
+    /// @brief 设置内存寻址的基址寄存器和偏移
+    /// @param val Value
+    /// @param baseRegId 基址寄存器编号
+    /// @param offset 偏移
+    ///
+    void setMemoryAddr(Value * val, int32_t baseRegId, int64_t offset);
+
+private:
+    ///
+    /// @brief 查找Value的位置，不存在时不创建
+    /// @param val Value
+    /// @return const Loc* 位置，不存在时为空
+    ///
+    [[nodiscard]] const Loc * find(Value * val) const;
+
+    ///
+    /// @brief 获取Value的位置，不存在时创建
+    /// @param val Value
+    /// @return Loc& 位置
+    ///
+    Loc & get(Value * val);
+
+    ///
+    /// @brief 函数内有编号的Value的位置，以编号为下标
+    ///
+    std::vector<Loc> locs;
+
+    ///
+    /// @brief 全局变量、常量等没有函数内编号的Value的位置
+    ///
+    std::unordered_map<Value *, Loc> others;
+};
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorArm32.cpp
 /// @brief ARM32的后端处理实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,11 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>直接遍历与修改InterCode指令序列
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>指令从函数的内存池分配
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>以isa/dyn_cast代替dynamic_cast
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>寄存器与栈内位置记录在按稠密编号索引的位置表中
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>调试输出只在输出调试日志时生成
 /// </table>
 ///
 #include <cstdint>
@@ -33,7 +38,8 @@
 
 /// @brief 构造函数
 /// @param tab 符号表
-CodeGeneratorArm32::CodeGeneratorArm32(Module * _module) : CodeGeneratorAsm(_module)
+CodeGeneratorArm32::CodeGeneratorArm32(Module * _module)
+    : CodeGeneratorAsm(_module), simpleRegisterAllocator(valueLocs)
 {}
 
 /// @brief 析构函数
@@ -86,7 +92,7 @@ void CodeGeneratorArm32::getIRValueStr(Value * val, std::string & str)
 {
     std::string name = val->getName();
     std::string IRName = val->getIRName();
-    int32_t regId = val->getRegId();
+    int32_t regId = valueLocs.getRegId(val);
     int32_t baseRegId;
     int64_t offset;
     std::string showName;
@@ -104,7 +110,7 @@ void CodeGeneratorArm32::getIRValueStr(Value * val, std::string & str)
     if (regId != -1) {
         // 寄存器
         str += "\t@ " + showName + ":" + PlatformArm32::regName[regId];
-    } else if (val->getMemoryAddr(&baseRegId, &offset)) {
+    } else if (valueLocs.getMemoryAddr(val, &baseRegId, &offset)) {
         // 栈内寻址，[fp,#4]
         str += "\t@ " + showName + ":[" + PlatformArm32::regName[baseRegId] + ",#" + std::to_string(offset) + "]";
     }
@@ -118,7 +124,7 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
     registerAllocation(func);
 
     // 获取函数的指令列表
-    std::vector<Instruction *> & IrInsts = func->getInterCode().getInsts();
+    InterCode & IrInsts = func->getInterCode();
 
     // 汇编指令输出前要确保Label的名字有效，必须是程序级别的唯一，而不是函数内的唯一。要全局编号。
     for (auto inst: IrInsts) {
@@ -128,10 +134,10 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
     }
 
     // ILOC代码序列
-    ILocArm32 iloc(module);
+    ILocArm32 iloc(module, valueLocs);
 
     // 指令选择生成汇编指令
-    InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator);
+    InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator, valueLocs);
     instSelector.setShowLinearIR(this->showLinearIR);
     instSelector.run();
 
@@ -157,7 +163,7 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
         }
 
         // 输出指令关联的临时变量信息
-        for (auto inst: func->getInterCode().getInsts()) {
+        for (auto inst: func->getInterCode()) {
             if (inst->hasResultValue()) {
                 std::string str;
                 getIRValueStr(inst, str);
@@ -194,6 +200,9 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
     //  (2) LX寄存器用于函数调用，即R14。没有函数调用的函数可不用保护lx寄存器
     //  (3) R10寄存器用于立即数过大时要通过寄存器寻址，这里简化处理进行预留
 
+    // 寄存器与栈内位置按函数内的稠密编号记录，每个函数重新开始
+    valueLocs.reset(func);
+
     // 至少有FP和LX寄存器需要保护
     std::vector<int32_t> & protectedRegNo = func->getProtectedReg();
     protectedRegNo.clear();
@@ -236,14 +245,14 @@ void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
     for (int k = 0; k < (int) params.size() && k <= 3; k++) {
 
         // 前四个设置分配寄存器
-        params[k]->setRegId(k);
+        valueLocs.setRegId(params[k], k);
     }
 
     // 根据ARM版C语言的调用约定，除前4个外的实参进行值传递，逆序入栈
     int64_t fp_esp = func->getProtectedReg().size() * 4;
     for (int k = 4; k < (int) params.size(); k++) {
 
-        params[k]->setMemoryAddr(ARM32_FP_REG_NO, fp_esp);
+        valueLocs.setMemoryAddr(params[k], ARM32_FP_REG_NO, fp_esp);
 
         // 增加4字节，目前只支持int类型
         fp_esp += params[k]->getType()->getSize();
@@ -254,17 +263,15 @@ void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
 /// @param func 要处理的函数
 void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 {
-    std::vector<Instruction *> newInsts;
-
     // 当前函数的指令列表
-    auto & insts = func->getInterCode().getInsts();
+    InterCode & insts = func->getInterCode();
 
     // 函数返回值用R0寄存器，若函数调用有返回值，则赋值R0到对应寄存器
     // 通过栈传递的实参，采用SP + 偏移的方式殉职，偏移肯定非负。
     for (auto pIter = insts.begin(); pIter != insts.end(); pIter++) {
 
         // 检查是否是函数调用指令，并且含有返回值
-        if (Instanceof(callInst, FuncCallInstruction *, *pIter)) {
+        if (auto * callInst = dyn_cast<FuncCallInstruction>(*pIter)) {
 
             // 实参前四个要寄存器传值，其它参数通过栈传递
 
@@ -288,19 +295,18 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
                 // 新建一个内存变量，把实参的值保存到栈中，以便栈传值，其寻址为SP + 非负偏移
                 MemVariable * newVal = func->newMemVariable(IntegerType::getTypeInt());
-                newVal->setMemoryAddr(ARM32_SP_REG_NO, esp);
+                valueLocs.setMemoryAddr(newVal, ARM32_SP_REG_NO, esp);
                 esp += 4;
 
                 // 引入赋值指令，把实参的值保存到内存变量上
-                Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+                Instruction * assignInst = func->getArena().create<MoveInstruction>(func, newVal, arg);
 
                 // 更换实参变量为内存变量
                 callInst->setOperand(k, newVal);
 
                 // 赋值指令插入到函数调用指令的前面
                 // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                (void) insts.insertBefore(pIter, assignInst);
             }
 
             // ARM32的函数调用约定，前四个参数通过寄存器传递
@@ -310,13 +316,13 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
                 auto arg = callInst->getOperand(k);
 
-                Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+                Instruction * assignInst =
+                    func->getArena().create<MoveInstruction>(func, PlatformArm32::intRegVal[k], arg);
 
                 callInst->setOperand(k, PlatformArm32::intRegVal[k]);
 
                 // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                (void) insts.insertBefore(pIter, assignInst);
             }
 
 #if 0
@@ -325,8 +331,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 auto arg = callInst->getOperand(k);
 
                 // 产生ARG指令
-                pIter = insts.insert(pIter, new ArgInstruction(func, arg));
-                pIter++;
+                (void) insts.insertBefore(pIter, func->getArena().create<ArgInstruction>(func, arg));
             }
 #endif
 
@@ -336,16 +341,17 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
             // 赋值指令
             if (callInst->hasResultValue()) {
 
-                if (callInst->getRegId() == 0) {
+                if (valueLocs.getRegId(callInst) == 0) {
                     // 结果变量的寄存器和返回值寄存器一样，则什么都不需要做
                     ;
                 } else {
                     // 其它情况，需要产生赋值指令
                     // 新建一个赋值操作
-                    Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+                    Instruction * assignInst =
+                        func->getArena().create<MoveInstruction>(func, callInst, PlatformArm32::intRegVal[0]);
 
-                    // 函数调用指令的下一个指令的前面插入指令，因为有Exit指令，+1肯定有效
-                    pIter = insts.insert(pIter + 1, assignInst);
+                    // 函数调用指令的后面插入指令，pIter指向插入的指令，循环时跳过
+                    pIter = insts.insertAfter(pIter, assignInst);
                 }
             }
         }
@@ -359,22 +365,27 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
     int32_t s32_temp; 
     int64_t s64_temp; 
 
+    // 以下的分配过程日志会生成IR名字与指令文本，只在输出调试日志时产生
+    bool debug = minic_log_enabled(LOG_DEBUG);
+
     // ... (前面的注释和局部变量分配日志保持你之前的版本，那部分看起来OK) ...
-    std::cout << "--- Stack Allocation for Function: " << func->getName() << " ---" << std::endl;
+    if (debug) {
+        std::cout << "--- Stack Allocation for Function: " << func->getName() << " ---" << std::endl;
+    }
 
-    int32_t current_fp_negative_offset_size = func->getCurrentFuncFrameSizeNegative(); // 你需要实现这个函数
-                    
-    int32_t sp_esp = current_fp_negative_offset_size; // 初始化 sp_esp
-    std::cout << "Initial sp_esp based on LocalVariables: " << sp_esp << std::endl;
+    // 局部变量与临时变量都从FP开始向低地址依次分配
+    int32_t sp_esp = 0;
 
     // --- 1. 为局部变量 (func->getVarValues()) 分配栈空间 ---
-    std::cout << "--- Processing Local Variables (getVarValues) ---" << std::endl;
+    if (debug) {
+        std::cout << "--- Processing Local Variables (getVarValues) ---" << std::endl;
+    }
     for (auto var : func->getVarValues()) {
         // --- 你之前的局部变量日志逻辑 ---
         std::string has_mem_addr_str = "No";
         int32_t current_base_reg = -1;
         int64_t current_offset = 0;
-        if (var->getMemoryAddr(&current_base_reg, &current_offset)) {
+        if (debug && valueLocs.getMemoryAddr(var, &current_base_reg, &current_offset)) {
             has_mem_addr_str = "Yes (Base: ";
             if (current_base_reg != -1 && current_base_reg < PlatformArm32::maxUsableRegNum) { // 假设 PlatformArm32 有 maxUsableRegNum
                  has_mem_addr_str += PlatformArm32::regName[current_base_reg];
@@ -384,49 +395,61 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
             has_mem_addr_str += ", Offset: " + std::to_string(current_offset) + ")";
         }
 
-        std::cout << "Var: " << var->getName() 
-                  << " (IR: " << var->getIRName() << ")"
-                  << ", Type: " << var->getType()->toString()
-                  << ", RegId: " << var->getRegId()
-                  << ", HasMemAddr: " << has_mem_addr_str
-                  << ", Ptr: " << static_cast<void*>(var) // 打印指针地址
-                  << std::endl;
+        if (debug) {
+            std::cout << "Var: " << var->getName()
+                      << " (IR: " << var->getIRName() << ")"
+                      << ", Type: " << var->getType()->toString()
+                      << ", RegId: " << valueLocs.getRegId(var)
+                      << ", HasMemAddr: " << has_mem_addr_str
+                      << ", Ptr: " << static_cast<void*>(var) // 打印指针地址
+                      << std::endl;
+        }
         // --- 结束你之前的局部变量日志逻辑 ---
 
-        if ((var->getRegId() == -1) && (!var->getMemoryAddr(&s32_temp, &s64_temp))) {
+        if ((valueLocs.getRegId(var) == -1) && (!valueLocs.getMemoryAddr(var, &s32_temp, &s64_temp))) {
             int32_t size = var->getType()->getSize();
+            if (size <= 0) {
+                // 至少分配一个字
+                size = 4;
+            }
             size = (size + 3) & ~3; 
             sp_esp += size;
 
-            std::cout << "  ALLOCATING for Local Var: " << var->getName()
-                      << " (IR: " << var->getIRName() << ")"
-                      << ", Size: " << size
-                      << ", CumulativeOffsetAbs: " << sp_esp
-                      << ", AssignedOffset: " << -sp_esp
-                      << std::endl;
-            var->setMemoryAddr(ARM32_FP_REG_NO, -sp_esp);
+            if (debug) {
+                std::cout << "  ALLOCATING for Local Var: " << var->getName()
+                          << " (IR: " << var->getIRName() << ")"
+                          << ", Size: " << size
+                          << ", CumulativeOffsetAbs: " << sp_esp
+                          << ", AssignedOffset: " << -sp_esp
+                          << std::endl;
+            }
+            valueLocs.setMemoryAddr(var, ARM32_FP_REG_NO, -sp_esp);
             // --- 在这里为 LocalVariable 添加即时验证 (可选，但推荐) ---
-            bool check_addr_lv = var->getMemoryAddr(&s32_temp, &s64_temp);
-            std::cout << "    stackAlloc: AFTER setMemoryAddr for LocalVar " << var->getIRName() 
-                      << ", getMemoryAddr returns: " << (check_addr_lv ? "true" : "false")
-                      << ", base=" << s32_temp << ", offset=" << s64_temp << std::endl;
+            bool check_addr_lv = valueLocs.getMemoryAddr(var, &s32_temp, &s64_temp);
+            if (debug) {
+                std::cout << "    stackAlloc: AFTER setMemoryAddr for LocalVar " << var->getIRName()
+                          << ", getMemoryAddr returns: " << (check_addr_lv ? "true" : "false")
+                          << ", base=" << s32_temp << ", offset=" << s64_temp << std::endl;
+            }
             // --- 结束即时验证 ---
             
-        } else {
+        } else if (debug) {
             std::cout << "  SKIPPING Local Var (already has reg or mem): " << var->getName() << std::endl;
         }
     }
 
     // --- 2. 为临时变量 (指令结果) 分配栈空间 ---
-    std::cout << "--- Processing Temporary Variables (Instruction Results) ---" << std::endl;
-    for (auto inst : func->getInterCode().getInsts()) {
+    if (debug) {
+        std::cout << "--- Processing Temporary Variables (Instruction Results) ---" << std::endl;
+    }
+    for (auto inst : func->getInterCode()) {
         if (inst->hasResultValue()) {
             // --- 详细打印指令结果 Value 的当前状态 ---
             std::string inst_mem_addr_str = "No";
             int32_t inst_current_base_reg = -1;
             int64_t inst_current_offset = 0;
-            bool inst_already_has_addr = inst->getMemoryAddr(&inst_current_base_reg, &inst_current_offset);
-            if (inst_already_has_addr) {
+            bool inst_already_has_addr = valueLocs.getMemoryAddr(inst, &inst_current_base_reg, &inst_current_offset);
+            if (debug && inst_already_has_addr) {
                 inst_mem_addr_str = "Yes (Base: ";
                  if (inst_current_base_reg != -1 && inst_current_base_reg < PlatformArm32::maxUsableRegNum) {
                      inst_mem_addr_str += PlatformArm32::regName[inst_current_base_reg];
@@ -435,38 +458,44 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
                  }
                 inst_mem_addr_str += ", Offset: " + std::to_string(inst_current_offset) + ")";
             }
-            std::cout << "Processing Inst with Result: " << inst->toString()
-                      << " (Value Ptr: " << static_cast<void*>(inst) << ", IRName: " << inst->getIRName() << ")"
-                      << ", Type: " << inst->getType()->toString()
-                      << ", RegId: " << inst->getRegId()
-                      << ", HasMemAddr: " << inst_mem_addr_str
-                      << std::endl;
+            if (debug) {
+                std::cout << "Processing Inst with Result: " << inst->toString()
+                          << " (Value Ptr: " << static_cast<void*>(inst) << ", IRName: " << inst->getIRName() << ")"
+                          << ", Type: " << inst->getType()->toString()
+                          << ", RegId: " << valueLocs.getRegId(inst)
+                          << ", HasMemAddr: " << inst_mem_addr_str
+                          << std::endl;
+            }
             // --- 结束详细打印 ---
             
             // 条件判断使用 inst_already_has_addr 变量，避免重复调用 getMemoryAddr
-            if ((inst->getRegId() == -1) && (!inst_already_has_addr)) {
+            if ((valueLocs.getRegId(inst) == -1) && (!inst_already_has_addr)) {
                 int32_t size = inst->getType()->getSize();
                 size = (size + 3) & ~3; 
                 sp_esp += size;
 
-                std::cout << "  ALLOCATING for Temp (Inst Result of: " << inst->toString() << ")"
-                          << ", Size: " << size
-                          << ", CumulativeOffsetAbs: " << sp_esp
-                          << ", AssignedOffset: " << -sp_esp
-                          << std::endl;
+                if (debug) {
+                    std::cout << "  ALLOCATING for Temp (Inst Result of: " << inst->toString() << ")"
+                              << ", Size: " << size
+                              << ", CumulativeOffsetAbs: " << sp_esp
+                              << ", AssignedOffset: " << -sp_esp
+                              << std::endl;
+                }
                 
                 // **关键：调用 setMemoryAddr**
-                inst->setMemoryAddr(ARM32_FP_REG_NO, -sp_esp);
+                valueLocs.setMemoryAddr(inst, ARM32_FP_REG_NO, -sp_esp);
 
                 // **关键：紧随其后的验证日志**
-                bool check_addr_inst = inst->getMemoryAddr(&s32_temp, &s64_temp); // 使用局部 s32_temp, s64_temp
-                std::cout << "    stackAlloc: AFTER setMemoryAddr for Temp " << inst->getIRName() 
-                          << " (Value Ptr: " << static_cast<void*>(inst) << ")"
-                          << ", getMemoryAddr returns: " << (check_addr_inst ? "true" : "false")
-                          << ", base=" << s32_temp << ", offset=" << s64_temp << std::endl;
+                bool check_addr_inst = valueLocs.getMemoryAddr(inst, &s32_temp, &s64_temp); // 使用局部 s32_temp, s64_temp
+                if (debug) {
+                    std::cout << "    stackAlloc: AFTER setMemoryAddr for Temp " << inst->getIRName()
+                              << " (Value Ptr: " << static_cast<void*>(inst) << ")"
+                              << ", getMemoryAddr returns: " << (check_addr_inst ? "true" : "false")
+                              << ", base=" << s32_temp << ", offset=" << s64_temp << std::endl;
+                }
 
-            } else {
-                 std::cout << "  SKIPPING Temp (Inst Result of: " << inst->toString() << ") (already has reg or mem)" << std::endl;
+            } else if (debug) {
+                std::cout << "  SKIPPING Temp (Inst Result of: " << inst->toString() << ") (already has reg or mem)" << std::endl;
             }
         }
     }
@@ -477,5 +506,7 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
         sp_esp += (maxFuncCallArgCnt - 4) * 4;
     }
     func->setMaxDep(sp_esp);
-    std::cout << "--- Function: " << func->getName() << ", Final Stack Depth (FP- including call args): " << sp_esp << " ---" << std::endl;
+    if (debug) {
+        std::cout << "--- Function: " << func->getName() << ", Final Stack Depth (FP- including call args): " << sp_esp << " ---" << std::endl;
+    }
 }
\ No newline at end of file
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorArm32.h
 /// @brief ARM32的后端处理头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,10 +11,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>寄存器与栈内位置记录在按稠密编号索引的位置表中
 /// </table>
 ///
 #include "CodeGeneratorAsm.h"
 #include "SimpleRegisterAllocator.h"
+#include "ValueLocTable.h"
 
 class CodeGeneratorArm32 : public CodeGeneratorAsm {
 
@@ -60,6 +62,11 @@ protected:
     void getIRValueStr(Value * val, std::string & str);
 
 private:
+    ///
+    /// @brief 当前函数内变量的寄存器与栈内位置，寄存器分配与指令选择共用
+    ///
+    ValueLocTable valueLocs;
+
     ///
     /// @brief 简单的朴素寄存器分配方法
     ///
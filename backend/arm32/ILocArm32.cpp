@@ -2,8 +2,8 @@
 /// @file ILocArm32.cpp
 /// @brief 指令序列管理的实现，ILOC的全称为Intermediate Language for Optimizing Compilers
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>以isa/dyn_cast代替dynamic_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>变量的寄存器与栈内位置从后端的位置表中获取
 /// </table>
 ///
 #include <cstdio>
@@ -122,7 +124,8 @@ std::string ArmInst::outPut()
 
 /// @brief 构造函数
 /// @param _module 符号表
-ILocArm32::ILocArm32(Module * _module)
+/// @param _locs 变量的寄存器与栈内位置表
+ILocArm32::ILocArm32(Module * _module, ValueLocTable & _locs) : locs(_locs)
 {
     this->module = _module;
 }
@@ -379,20 +382,20 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         return;
     }
 
-    if (Instanceof(constVal, ConstInt *, src_var)) {
+    if (auto * constVal = dyn_cast<ConstInt>(src_var)) {
         // 整型常量
         minic_log(LOG_DEBUG, "ILocLoadVar: Loading ConstInt %s (value %d) into reg %s",
                   src_var->getIRName().c_str(), constVal->getVal(), PlatformArm32::getRegNameSafe(rs_reg_no).c_str());
         load_imm(rs_reg_no, constVal->getVal());
-    } else if (src_var->getRegId() != -1 && src_var->getRegId() < PlatformArm32::maxUsableRegNum ) { // 检查 regId 的有效性
+    } else if (locs.getRegId(src_var) != -1 && locs.getRegId(src_var) < PlatformArm32::maxUsableRegNum ) { // 检查 regId 的有效性
         // 源操作数为寄存器变量
-        int32_t src_regId = src_var->getRegId();
+        int32_t src_regId = locs.getRegId(src_var);
         minic_log(LOG_DEBUG, "ILocLoadVar: Src %s is already in reg %s. Target reg is %s.",
                   src_var->getIRName().c_str(), PlatformArm32::getRegNameSafe(src_regId).c_str(), PlatformArm32::getRegNameSafe(rs_reg_no).c_str());
         if (src_regId != rs_reg_no) {
             emit("mov", PlatformArm32::getRegNameSafe(rs_reg_no), PlatformArm32::getRegNameSafe(src_regId));
         }
-    } else if (Instanceof(globalVar, GlobalVariable *, src_var)) {
+    } else if (auto * globalVar = dyn_cast<GlobalVariable>(src_var)) {
         // 全局变量
         minic_log(LOG_DEBUG, "ILocLoadVar: Loading GlobalVariable %s into reg %s",
                   globalVar->getName().c_str(), PlatformArm32::getRegNameSafe(rs_reg_no).c_str());
@@ -407,22 +410,19 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
                   src_var->getName().c_str(), // 原始名称
                   typeid(*src_var).name(),    // 动态类型
                   (void*)src_var,             // 指针地址
-                  src_var->getRegId(),        // 当前（通用）regId
+                  locs.getRegId(src_var),        // 当前（通用）regId
                   PlatformArm32::getRegNameSafe(rs_reg_no).c_str());
 
         // ---- A2: 针对 LocalVariable 的详细日志 ----
-        if (LocalVariable* lv = dynamic_cast<LocalVariable*>(src_var)) {
-            minic_log(LOG_DEBUG, "ILocLoadVar: src_var IS LocalVariable. Ptr: %p, IRName: '%s'. Internal state BEFORE getMemoryAddr: baseRegNo=%d, offset=%d.",
-                      (void*)lv, 
-                      lv->getIRName().c_str(), 
-                      lv->getBaseRegNoForDebug(), // 调用调试 getter
-                      lv->getOffsetForDebug());   // 调用调试 getter
+        if (isa<LocalVariable>(src_var)) {
+            minic_log(LOG_DEBUG, "ILocLoadVar: src_var IS LocalVariable. Ptr: %p, IRName: '%s', Index: %d.",
+                      (void*)src_var, src_var->getIRName().c_str(), src_var->getValueIndex());
         } 
         // ---- 结束 A2 LocalVariable 日志 ----
         // (可以为 TempVariable 和 Instruction 添加类似的 "IS XxxVariable" 日志，但不打印 baseRegNo/offset，因为它们没有)
-        else if (dynamic_cast<TempVariable*>(src_var)) {
+        else if (isa<TempVariable>(src_var)) {
             minic_log(LOG_DEBUG, "ILocLoadVar: src_var IS TempVariable. Ptr: %p, IRName: '%s'.", (void*)src_var, src_var->getIRName().c_str());
-        } else if (dynamic_cast<Instruction*>(src_var) && src_var != nullptr) { // 确保不是 Value 本身，而是 Instruction
+        } else if (isa<Instruction>(src_var)) {
             minic_log(LOG_DEBUG, "ILocLoadVar: src_var IS Instruction result. Ptr: %p, IRName: '%s'.", (void*)src_var, src_var->getIRName().c_str());
         }
 
@@ -430,19 +430,11 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         int32_t var_baseRegId = -1;
         int64_t var_offset = 0; 
     
-        bool has_mem_addr = src_var->getMemoryAddr(&var_baseRegId, &var_offset); 
-
-        // 在调用 getMemoryAddr 之后，再次检查 LocalVariable 的内部状态 (如果它是 LocalVariable)
-        if (LocalVariable* lv_after = dynamic_cast<LocalVariable*>(src_var)) {
-            minic_log(LOG_DEBUG, "ILocLoadVar: LocalVariable (Ptr: %p, IRName: '%s') AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld. Internal base: %d, internal offset: %d.",
-                      (void*)lv_after, lv_after->getIRName().c_str(),
-                      has_mem_addr ? "true" : "false", var_baseRegId, (long long)var_offset,
-                      lv_after->getBaseRegNoForDebug(), lv_after->getOffsetForDebug());
-        } else {
-            minic_log(LOG_DEBUG, "ILocLoadVar: Value (IRName: '%s', Ptr: %p, DynType: %s) AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld.",
-                      src_var->getIRName().c_str(), (void*)src_var, typeid(*src_var).name(),
-                      has_mem_addr ? "true" : "false", var_baseRegId, (long long)var_offset);
-        }
+        bool has_mem_addr = locs.getMemoryAddr(src_var, &var_baseRegId, &var_offset); 
+
+        minic_log(LOG_DEBUG, "ILocLoadVar: Value (IRName: '%s', Ptr: %p, DynType: %s) AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld.",
+                  src_var->getIRName().c_str(), (void*)src_var, typeid(*src_var).name(),
+                  has_mem_addr ? "true" : "false", var_baseRegId, (long long)var_offset);
 
 
         if (has_mem_addr && var_baseRegId != -1 && var_baseRegId < PlatformArm32::maxRegNum) {
@@ -471,7 +463,7 @@ void ILocArm32::lea_var(int rs_reg_no, Value * var)
     int32_t var_baseRegId = -1;
     int64_t var_offset = -1;
 
-    bool result = var->getMemoryAddr(&var_baseRegId, &var_offset);
+    bool result = locs.getMemoryAddr(var, &var_baseRegId, &var_offset);
     if (!result) {
         minic_log(LOG_ERROR, "BUG");
     }
@@ -521,9 +513,9 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
 
     // --- 开始实际的存储逻辑 ---
 
-    if (dest_var->getRegId() != -1 && dest_var->getRegId() < PlatformArm32::maxUsableRegNum) {
+    if (locs.getRegId(dest_var) != -1 && locs.getRegId(dest_var) < PlatformArm32::maxUsableRegNum) {
         // 目标是寄存器变量
-        int dest_reg_id = dest_var->getRegId();
+        int dest_reg_id = locs.getRegId(dest_var);
         std::string dest_reg_name = PlatformArm32::getRegNameSafe(dest_reg_id);
 
         // 再次检查目标寄存器名是否有效 (以防万一 getRegId 返回了有效范围内的错误ID)
@@ -542,7 +534,7 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
         }
         // 如果源和目标是同一个寄存器，则不需要操作
 
-    } else if (Instanceof(globalVar, GlobalVariable *, dest_var)) {
+    } else if (auto * globalVar = dyn_cast<GlobalVariable>(dest_var)) {
         // 目标是全局变量
         minic_log(LOG_DEBUG, "ILocStoreVar: Storing from %s to global variable %s (IRName: %s) (using tmp_reg: %s)",
                   src_reg_name.c_str(), globalVar->getName().c_str(), globalVar->getIRName().c_str(), PlatformArm32::getRegNameSafe(tmp_reg_no).c_str());
@@ -557,41 +549,29 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
                   dest_var->getName().c_str(),
                   typeid(*dest_var).name(),
                   (void*)dest_var,
-                  dest_var->getRegId(), // 这个 getRegId() 应该是 dest_var 的通用寄存器ID
+                  locs.getRegId(dest_var), // 这个 getRegId() 应该是 dest_var 的通用寄存器ID
                   src_reg_name.c_str());
 
         // ---- A2: 针对 LocalVariable 的详细日志 ----
-        LocalVariable* lv_debug = dynamic_cast<LocalVariable*>(dest_var); // 用于日志的临时指针
-        if (lv_debug) {
-            minic_log(LOG_DEBUG, "ILocStoreVar: dest_var IS LocalVariable. Ptr: %p, IRName: '%s'. Internal state BEFORE getMemoryAddr: baseRegNo=%d, offset=%d.",
-                      (void*)lv_debug, 
-                      lv_debug->getIRName().c_str(), 
-                      lv_debug->getBaseRegNoForDebug(),
-                      lv_debug->getOffsetForDebug());
+        if (isa<LocalVariable>(dest_var)) {
+            minic_log(LOG_DEBUG, "ILocStoreVar: dest_var IS LocalVariable. Ptr: %p, IRName: '%s', Index: %d.",
+                      (void*)dest_var, dest_var->getIRName().c_str(), dest_var->getValueIndex());
         } 
         // ---- 结束 A2 LocalVariable 日志 ----
-        else if (dynamic_cast<TempVariable*>(dest_var)) {
+        else if (isa<TempVariable>(dest_var)) {
             minic_log(LOG_DEBUG, "ILocStoreVar: dest_var IS TempVariable. Ptr: %p, IRName: '%s'.", (void*)dest_var, dest_var->getIRName().c_str());
-        } else if (dynamic_cast<Instruction*>(dest_var)) { 
+        } else if (isa<Instruction>(dest_var)) {
              minic_log(LOG_DEBUG, "ILocStoreVar: dest_var IS Instruction result. Ptr: %p, IRName: '%s'.", (void*)dest_var, dest_var->getIRName().c_str());
         }
 
 
         int32_t dest_baseRegId = -1;
         int64_t dest_offset = 0; 
-        bool has_mem_addr = dest_var->getMemoryAddr(&dest_baseRegId, &dest_offset);
-
-        // 在调用 getMemoryAddr 之后，再次检查 LocalVariable 的内部状态
-        if (lv_debug) { // 使用之前 dynamic_cast 的结果
-            minic_log(LOG_DEBUG, "ILocStoreVar: LocalVariable (Ptr: %p, IRName: '%s') AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld. Internal state AFTER: baseRegNo=%d, internal offset=%d.",
-                      (void*)lv_debug, lv_debug->getIRName().c_str(),
-                      has_mem_addr ? "true" : "false", dest_baseRegId, (long long)dest_offset,
-                      lv_debug->getBaseRegNoForDebug(), lv_debug->getOffsetForDebug());
-        } else {
-             minic_log(LOG_DEBUG, "ILocStoreVar: Value (IRName: '%s', Ptr: %p, DynType: %s) AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld.",
-                      dest_var->getIRName().c_str(), (void*)dest_var, typeid(*dest_var).name(),
-                      has_mem_addr ? "true" : "false", dest_baseRegId, (long long)dest_offset);
-        }
+        bool has_mem_addr = locs.getMemoryAddr(dest_var, &dest_baseRegId, &dest_offset);
+
+        minic_log(LOG_DEBUG, "ILocStoreVar: Value (IRName: '%s', Ptr: %p, DynType: %s) AFTER getMemoryAddr. Return: %s. Effective baseRegId: %d, offset: %lld.",
+                  dest_var->getIRName().c_str(), (void*)dest_var, typeid(*dest_var).name(),
+                  has_mem_addr ? "true" : "false", dest_baseRegId, (long long)dest_offset);
 
         if (has_mem_addr && dest_baseRegId != -1 && dest_baseRegId < PlatformArm32::maxRegNum) {
             minic_log(LOG_DEBUG, "ILocStoreVar: Proceeding to store_base for %s into [%s, #%lld] from %s",
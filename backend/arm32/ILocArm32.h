@@ -2,8 +2,8 @@
 /// @file ILocArm32.h
 /// @brief 指令序列管理的头文件，ILOC的全称为Intermediate Language for Optimizing Compilers
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>以isa/dyn_cast代替dynamic_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>变量的寄存器与栈内位置从后端的位置表中获取
 /// </table>
 ///
 #pragma once
@@ -20,8 +22,7 @@
 #include <set> // <--- 添加这个
 #include <vector> // 确保包含 (如果 ArmInst.h 或其他地方需要)
 #include "Module.h"
-
-#define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
+#include "ValueLocTable.h"
 
 /// @brief 底层汇编指令：ARM32
 struct ArmInst {
@@ -90,6 +91,9 @@ class ILocArm32 {
     /// @brief 符号表
     Module * module;
 
+    /// @brief 变量的寄存器与栈内位置表
+    ValueLocTable & locs;
+
 
     /// @brief 加载符号值 ldr r0,=g; ldr r0,[r0]
     /// @param rsReg 结果寄存器号
@@ -105,7 +109,8 @@ class ILocArm32 {
 public:
     /// @brief 构造函数
     /// @param _module 符号表-模块
-    ILocArm32(Module * _module);
+    /// @param _locs 变量的寄存器与栈内位置表
+    ILocArm32(Module * _module, ValueLocTable & _locs);
 
     /// @brief 析构函数
     ~ILocArm32();
@@ -2,8 +2,8 @@
 /// @file InstSelectorArm32.cpp
 /// @brief 指令选择器-ARM32的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,11 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>直接遍历与修改InterCode指令序列
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>翻译用的赋值指令改为栈上对象
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>以isa/dyn_cast代替dynamic_cast
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>变量的寄存器与栈内位置从后端的位置表中获取
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>调试输出只在输出调试日志时生成
 /// </table>
 ///
 #include <cstdio>
@@ -33,7 +38,7 @@
 #include "BranchConditionalInstruction.h"
 #include <iostream>
 // ---- 确保这个辅助函数在这里定义 ----
-static std::string getValueDetailsForInstSelector(Value* var) { // 我之前建议用这个名字
+static std::string getValueDetailsForInstSelector(Value* var, const ValueLocTable & locs) { // 我之前建议用这个名字
     if (!var) return "null_Value_ptr"; // 更明确一点
     std::string ir_name_str = var->getIRName(); 
     std::string name_str = var->getName();
@@ -41,7 +46,7 @@ static std::string getValueDetailsForInstSelector(Value* var) { // 我之前建
     if (var->getType()) {
         type_str = var->getType()->toString();
     }
-    int32_t reg_id_val = var->getLoadRegId(); // 或 getRegId()
+    int32_t reg_id_val = locs.getLoadRegId(var); // 或 getRegId()
 
     // 使用更安全的字符串拼接或 ostringstream 以避免复杂的 + 操作
     std::string details = "'";
@@ -61,11 +66,14 @@ static std::string getValueDetailsForInstSelector(Value* var) { // 我之前建
 /// @param _irCode 指令
 /// @param _iloc ILoc
 /// @param _func 函数
-InstSelectorArm32::InstSelectorArm32(vector<Instruction *> & _irCode,
+/// @param allocator 寄存器分配器
+/// @param _locs 变量的寄存器与栈内位置表
+InstSelectorArm32::InstSelectorArm32(InterCode & _irCode,
                                      ILocArm32 & _iloc,
                                      Function * _func,
-                                     SimpleRegisterAllocator & allocator)
-    : ir(_irCode), iloc(_iloc), func(_func), simpleRegisterAllocator(allocator)
+                                     SimpleRegisterAllocator & allocator,
+                                     ValueLocTable & _locs)
+    : ir(_irCode), iloc(_iloc), func(_func), simpleRegisterAllocator(allocator), locs(_locs)
 {
     translator_handlers[IRInstOperator::IRINST_OP_ENTRY] = &InstSelectorArm32::translate_entry;
     translator_handlers[IRInstOperator::IRINST_OP_EXIT] = &InstSelectorArm32::translate_exit;
@@ -114,16 +122,15 @@ void InstSelectorArm32::run()
 void InstSelectorArm32::translate(Instruction * inst)
 {
     // --- 新增的详细日志 ---
-    if (inst) {
-        std::string inst_str_repr = inst->toString(); 
+    if (inst && minic_log_enabled(LOG_DEBUG)) {
         minic_log(LOG_DEBUG, "InstSelector::translate: ENTRY for IR: %s (Ptr: %p, DynType: %s)",
-                  inst_str_repr.c_str(), (void*)inst, typeid(*inst).name());
+                  inst->toString().c_str(), (void*)inst, typeid(*inst).name());
 
         // 特别关注 BinaryInstruction (以及其他你感兴趣的类型)
         // 首先声明用于 getMemoryAddr 的变量
         int32_t temp_instr_base_reg; 
         int64_t temp_instr_offset;
-        bool instr_has_addr = inst->getMemoryAddr(&temp_instr_base_reg, &temp_instr_offset);
+        bool instr_has_addr = locs.getMemoryAddr(inst, &temp_instr_base_reg, &temp_instr_offset);
 
         minic_log(LOG_DEBUG, "  InstSelector::translate (Inst Ptr: %p): Initial MemAddr check -> HasAddr: %s, Base: %d, Offset: %lld",
                   (void*)inst,
@@ -132,8 +139,8 @@ void InstSelectorArm32::translate(Instruction * inst)
                   instr_has_addr ? (long long)temp_instr_offset : 0 // 只在有地址时打印有效值
                   );
         
-        // 如果你想针对特定类型做更详细的检查，可以继续用 dynamic_cast
-        // if (dynamic_cast<BinaryInstruction*>(inst)) {
+        // 如果你想针对特定类型做更详细的检查，可以继续用 dyn_cast
+        // if (isa<BinaryInstruction>(inst)) {
         //     // 这里的 instr_has_addr, temp_instr_base_reg, temp_instr_offset 已经包含了信息
         //     minic_log(LOG_DEBUG, "    (Specifically a BinaryInstruction)");
         // }
@@ -181,7 +188,7 @@ void InstSelectorArm32::translate_nop(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_label(Instruction * inst)
 {
-    Instanceof(labelInst, LabelInstruction *, inst);
+    auto * labelInst = cast<LabelInstruction>(inst);
 
     minic_log(LOG_DEBUG, "InstSelector: Translating LABEL IR: %s. ASM output will be: %s:", 
 		labelInst->toString().c_str(), labelInst->getName().c_str()); // getName() 应该是 IR 中的标签名，如 .L4
@@ -192,11 +199,11 @@ void InstSelectorArm32::translate_label(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_goto(Instruction * inst)
 {
-    Instanceof(gotoInst, GotoInstruction *, inst); // 使用你的 Instanceof 宏
+    auto * gotoInst = dyn_cast_or_null<GotoInstruction>(inst);
 
-    if (!gotoInst) { // 总是好的做法是检查 dynamic_cast/Instanceof 的结果
+    if (!gotoInst) {
         minic_log(LOG_ERROR, "InstSelector: translate_goto called with non-GotoInstruction or null instruction.");
-        if (inst) { // 如果 inst 不是 null，但 dynamic_cast 失败
+        if (inst) { // 如果 inst 不是 null，但不是goto指令
              minic_log(LOG_ERROR, "InstSelector: Instruction was: %s", inst->toString().c_str());
         }
         return;
@@ -283,8 +290,8 @@ void InstSelectorArm32::translate_assign(Instruction * inst)
     Value * result = inst->getOperand(0);
     Value * arg1 = inst->getOperand(1);
 
-    int32_t arg1_regId = arg1->getRegId();
-    int32_t result_regId = result->getRegId();
+    int32_t arg1_regId = locs.getRegId(arg1);
+    int32_t result_regId = locs.getRegId(result);
 
     if (arg1_regId != -1) {
         // 寄存器 => 内存
@@ -326,8 +333,8 @@ void InstSelectorArm32::translate_one_operator(Instruction * inst, const std::st
     }
 
     // 分配或获取寄存器
-    int32_t arg_reg_no = arg->getRegId();
-    int32_t result_reg_no = inst->getRegId();
+    int32_t arg_reg_no = locs.getRegId(arg);
+    int32_t result_reg_no = locs.getRegId(inst);
     int32_t load_arg_reg_no, load_result_reg_no;
 
     // 处理源操作数
@@ -372,24 +379,26 @@ void InstSelectorArm32::translate_two_operator(Instruction * inst, string operat
     Value * arg1 = inst->getOperand(0);
     Value * arg2 = inst->getOperand(1);
 
-    int32_t arg1_reg_no = arg1->getRegId();
-    int32_t arg2_reg_no = arg2->getRegId();
-    int32_t result_reg_no = inst->getRegId();
+    int32_t arg1_reg_no = locs.getRegId(arg1);
+    int32_t arg2_reg_no = locs.getRegId(arg2);
+    int32_t result_reg_no = locs.getRegId(inst);
     int32_t load_result_reg_no, load_arg1_reg_no, load_arg2_reg_no;
-	  // --- 打印 Value* 地址 ---
-    std::cout << "  translate_two_operator: inst (result) (Value*) at address: " << static_cast<void*>(result)
-              << ", IRName: " << result->getIRName() << std::endl;
-    if (arg1) { // 使用 arg1
-        std::cout << "  translate_two_operator: arg1 (Value*) at address: " << static_cast<void*>(arg1)
-                  << ", IRName: " << arg1->getIRName() << std::endl;
-    } else {
-        std::cout << "  translate_two_operator: arg1 is nullptr" << std::endl;
-    }
-    if (arg2) { // 使用 arg2
-        std::cout << "  translate_two_operator: arg2 (Value*) at address: " << static_cast<void*>(arg2)
-                  << ", IRName: " << arg2->getIRName() << std::endl;
-    } else {
-        std::cout << "  translate_two_operator: arg2 is nullptr" << std::endl;
+    // --- 打印 Value* 地址，只在输出调试日志时生成IR名字 ---
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::cout << "  translate_two_operator: inst (result) (Value*) at address: " << static_cast<void*>(result)
+                  << ", IRName: " << result->getIRName() << std::endl;
+        if (arg1) { // 使用 arg1
+            std::cout << "  translate_two_operator: arg1 (Value*) at address: " << static_cast<void*>(arg1)
+                      << ", IRName: " << arg1->getIRName() << std::endl;
+        } else {
+            std::cout << "  translate_two_operator: arg1 is nullptr" << std::endl;
+        }
+        if (arg2) { // 使用 arg2
+            std::cout << "  translate_two_operator: arg2 (Value*) at address: " << static_cast<void*>(arg2)
+                      << ", IRName: " << arg2->getIRName() << std::endl;
+        } else {
+            std::cout << "  translate_two_operator: arg2 is nullptr" << std::endl;
+        }
     }
     // --- 结束打印 ---
     // 看arg1是否是寄存器，若是则寄存器寻址，否则要load变量到寄存器中
@@ -492,7 +501,7 @@ void InstSelectorArm32::translate_neg_int32(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_call(Instruction * inst)
 {
-    FuncCallInstruction * callInst = dynamic_cast<FuncCallInstruction *>(inst);
+    FuncCallInstruction * callInst = dyn_cast_or_null<FuncCallInstruction>(inst);
 	if (!callInst) {
         minic_log(LOG_ERROR, "Translate CALL: Instruction is not FuncCallInstruction.");
         return;
@@ -524,15 +533,13 @@ void InstSelectorArm32::translate_call(Instruction * inst)
 
             // 新建一个内存变量，用于栈传值到形参变量中
             MemVariable * newVal = func->newMemVariable((Type *) PointerType::get(arg->getType()));
-            newVal->setMemoryAddr(ARM32_SP_REG_NO, esp);
+            locs.setMemoryAddr(newVal, ARM32_SP_REG_NO, esp);
             esp += 4;
 
-            Instruction * assignInst = new MoveInstruction(func, newVal, arg);
-
-            // 翻译赋值指令
-            translate_assign(assignInst);
+            MoveInstruction assignInst(func, newVal, arg);
 
-            delete assignInst;
+            // 翻译赋值指令，赋值指令只用于翻译，不加入函数
+            translate_assign(&assignInst);
         }
 
         for (int32_t k = 0; k < operandNum && k < 4; k++) {
@@ -543,12 +550,10 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             // 如果是临时变量，该变量可更改为寄存器变量即可，或者设置寄存器号
             // 如果不是，则必须开辟一个寄存器变量，然后赋值即可
 
-            Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
-
-            // 翻译赋值指令
-            translate_assign(assignInst);
+            MoveInstruction assignInst(func, PlatformArm32::intRegVal[k], arg);
 
-            delete assignInst;
+            // 翻译赋值指令，赋值指令只用于翻译，不加入函数
+            translate_assign(&assignInst);
         }
     }
 
@@ -565,12 +570,10 @@ void InstSelectorArm32::translate_call(Instruction * inst)
     if (callInst->hasResultValue()) {
 
         // 新建一个赋值操作
-        Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+        MoveInstruction assignInst(func, callInst, PlatformArm32::intRegVal[0]);
 
-        // 翻译赋值指令
-        translate_assign(assignInst);
-
-        delete assignInst;
+        // 翻译赋值指令，赋值指令只用于翻译，不加入函数
+        translate_assign(&assignInst);
     }
 
     // 函数调用后清零，使得下次可正常统计
@@ -587,7 +590,7 @@ void InstSelectorArm32::translate_arg(Instruction * inst)
     Value * src = inst->getOperand(0);
 
     // 当前统计的ARG指令个数
-    int32_t regId = src->getRegId();
+    int32_t regId = locs.getRegId(src);
 
     if (realArgCount < 4) {
         // 前四个参数
@@ -602,7 +605,7 @@ void InstSelectorArm32::translate_arg(Instruction * inst)
     } else {
         // 必须是内存分配，若不是则出错
         int32_t baseRegId;
-        bool result = src->getMemoryAddr(&baseRegId);
+        bool result = locs.getMemoryAddr(src, &baseRegId);
         if ((!result) || (baseRegId != ARM32_SP_REG_NO)) {
 
             minic_log(LOG_ERROR, "第%d个ARG指令对象不是SP寄存器寻址", argCount + 1);
@@ -615,7 +618,7 @@ void InstSelectorArm32::translate_arg(Instruction * inst)
 
 
 void InstSelectorArm32::translate_cmp(Instruction * inst) {
-    CmpInstruction *cmpInst = dynamic_cast<CmpInstruction *>(inst);
+    CmpInstruction *cmpInst = dyn_cast_or_null<CmpInstruction>(inst);
     if (!cmpInst) {
         minic_log(LOG_ERROR, "Translate CMP: Instruction is not a CmpInstruction.");
         return;
@@ -636,7 +639,7 @@ void InstSelectorArm32::translate_cmp(Instruction * inst) {
     }
 
     // 1. 确保源操作数在寄存器中
-    int32_t src1_reg_id = src1_val->getRegId(); // 使用你统一的 getRegId()
+    int32_t src1_reg_id = locs.getRegId(src1_val); // 使用你统一的 getRegId()
     bool src1_is_temp_alloc = false;
     if (src1_reg_id == -1) {
         src1_reg_id = simpleRegisterAllocator.Allocate(src1_val);
@@ -661,7 +664,7 @@ void InstSelectorArm32::translate_cmp(Instruction * inst) {
     }
 
     if (!src2_is_immediate_for_cmp) {
-        src2_reg_id = src2_val->getRegId();
+        src2_reg_id = locs.getRegId(src2_val);
         if (src2_reg_id == -1) {
             src2_reg_id = simpleRegisterAllocator.Allocate(src2_val);
             if (src2_reg_id == -1) { 
@@ -722,7 +725,7 @@ void InstSelectorArm32::translate_cmp(Instruction * inst) {
 
 
 void InstSelectorArm32::translate_branch_cond(Instruction * inst) {
-    BranchConditionalInstruction *bcInst = dynamic_cast<BranchConditionalInstruction *>(inst);
+    BranchConditionalInstruction *bcInst = dyn_cast_or_null<BranchConditionalInstruction>(inst);
     if (!bcInst) {
         minic_log(LOG_ERROR, "Translate BC: Instruction (ptr %p, IR: %s) is not a BranchConditionalInstruction.",
                   (void*)inst, inst ? inst->toString().c_str() : "null_instr");
@@ -734,14 +737,16 @@ void InstSelectorArm32::translate_branch_cond(Instruction * inst) {
     LabelInstruction *false_target = bcInst->getFalseTarget();
 
     // --- 详细日志：打印指令和操作数信息 ---
-    std::string cond_val_str = cond_val ? getValueDetailsForInstSelector(cond_val) : "null_cond_val"; // 使用 getValueDetails 辅助函数
-    std::string true_target_str = true_target ? "'" + true_target->getName() + "' (IR: '" + true_target->getIRName() + "')" : "null_true_target";
-    std::string false_target_str = false_target ? "'" + false_target->getName() + "' (IR: '" + false_target->getIRName() + "')" : "null_false_target";
-
-    minic_log(LOG_DEBUG, "InstSelector: Translating BRANCH_COND. IR: %s", inst->toString().c_str());
-    minic_log(LOG_DEBUG, "  Condition Value: %s", cond_val_str.c_str());
-    minic_log(LOG_DEBUG, "  True Target: %s", true_target_str.c_str());
-    minic_log(LOG_DEBUG, "  False Target: %s", false_target_str.c_str());
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::string cond_val_str = cond_val ? getValueDetailsForInstSelector(cond_val, locs) : "null_cond_val"; // 使用 getValueDetails 辅助函数
+        std::string true_target_str = true_target ? "'" + true_target->getName() + "' (IR: '" + true_target->getIRName() + "')" : "null_true_target";
+        std::string false_target_str = false_target ? "'" + false_target->getName() + "' (IR: '" + false_target->getIRName() + "')" : "null_false_target";
+
+        minic_log(LOG_DEBUG, "InstSelector: Translating BRANCH_COND. IR: %s", inst->toString().c_str());
+        minic_log(LOG_DEBUG, "  Condition Value: %s", cond_val_str.c_str());
+        minic_log(LOG_DEBUG, "  True Target: %s", true_target_str.c_str());
+        minic_log(LOG_DEBUG, "  False Target: %s", false_target_str.c_str());
+    }
     // --- 结束日志 ---
 
     if (!cond_val || !true_target || !false_target) {
@@ -755,8 +760,8 @@ void InstSelectorArm32::translate_branch_cond(Instruction * inst) {
     }
 
     // 1. 确保条件值 cond_val (i1, 应该是 0 或 1) 在寄存器中
-    int32_t cond_reg_id = cond_val->getRegId(); // 尝试获取已分配的寄存器
-                                             // (现在 Value 基类应该能正确返回 allocatedRegisterId_)
+    int32_t cond_reg_id = locs.getRegId(cond_val); // 尝试获取已分配的寄存器
+                                             // (临时变量在位置表中记录了定值时分配的寄存器)
     bool allocated_now = false;
 
     if (cond_reg_id == -1 || cond_reg_id >= PlatformArm32::maxUsableRegNum) { // 如果未分配或ID无效
@@ -2,8 +2,8 @@
 /// @file InstSelectorArm32.h
 /// @brief 指令选择器-ARM32
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>直接遍历与修改InterCode指令序列
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>变量的寄存器与栈内位置从后端的位置表中获取
 /// </table>
 ///
 #pragma once
@@ -31,7 +33,7 @@ using namespace std;
 class InstSelectorArm32 {
 
     /// @brief 所有的IR指令
-    std::vector<Instruction *> & ir;
+    InterCode & ir;
 
     /// @brief 指令变换
     ILocArm32 & iloc;
@@ -136,6 +138,11 @@ protected:
     ///
     SimpleRegisterAllocator & simpleRegisterAllocator;
 
+    ///
+    /// @brief 变量的寄存器与栈内位置表
+    ///
+    ValueLocTable & locs;
+
     ///
     /// @brief 函数实参累计
     ///
@@ -154,10 +161,13 @@ public:
     /// @param _irCode IR指令
     /// @param _func 函数
     /// @param _iloc 后端指令
-    InstSelectorArm32(std::vector<Instruction *> & _irCode,
+    /// @param allocator 寄存器分配器
+    /// @param _locs 变量的寄存器与栈内位置表
+    InstSelectorArm32(InterCode & _irCode,
                       ILocArm32 & _iloc,
                       Function * _func,
-                      SimpleRegisterAllocator & allocator);
+                      SimpleRegisterAllocator & allocator,
+                      ValueLocTable & _locs);
 
     ///
     /// @brief 析构函数
@@ -2,8 +2,8 @@
 /// @file SimpleRegisterAllocator.h
 /// @brief 简单或朴素的寄存器分配器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>寄存器分配结果记录在后端的位置表中
 /// </table>
 ///
 #pragma once
@@ -19,6 +20,7 @@
 
 #include "BitMap.h"
 #include "Value.h"
+#include "ValueLocTable.h"
 #include "PlatformArm32.h"
 
 class SimpleRegisterAllocator {
@@ -26,8 +28,9 @@ class SimpleRegisterAllocator {
 public:
     ///
     /// @brief Construct a new Simple Register Allocator object
+    /// @param _locs 记录变量Load寄存器的位置表
     ///
-    SimpleRegisterAllocator();
+    explicit SimpleRegisterAllocator(ValueLocTable & _locs);
 
     ///
     /// @brief 尝试按指定的寄存器编号进行分配，若能分配，则直接分配，否则从小达到的次序分配一个寄存器。
@@ -64,6 +67,11 @@ protected:
     void bitmapSet(int32_t no);
 
 protected:
+    ///
+    /// @brief 变量的位置表，变量关联的Load寄存器记录在其中
+    ///
+    ValueLocTable & locs;
+
     ///
     /// @brief 寄存器位图：1已被占用，0未被使用
     ///
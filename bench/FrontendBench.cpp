@@ -0,0 +1,390 @@
+///
+/// @file FrontendBench.cpp
+/// @brief 三种前端（flex/bison、antlr4、递归下降）的性能对比测试
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 按参数生成MiniC源程序，对每种前端统计词法与语法分析直到产生AST的耗时，输出：
+/// 每秒处理的记号数、每秒产生的AST节点数、分析期间的内存峰值增量，
+/// 以及在指定位置插入语法错误后前端返回的耗时（首个错误的报告时间）。
+///
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "AST.h"
+#include "Antlr4Executor.h"
+#include "FlexBisonExecutor.h"
+#include "MiniCGenerator.h"
+#include "RecursiveDescentExecutor.h"
+#include "RecursiveDescentFlex.h"
+
+///
+/// @brief 一次前端分析的测量结果
+///
+struct BenchResult {
+
+    /// @brief 耗时，单位秒
+    double seconds;
+
+    /// @brief 产生的AST节点数
+    uint32_t nodes;
+
+    /// @brief 内存峰值相对于分析前的增量，单位KB
+    long peakKB;
+
+    /// @brief 前端是否分析成功
+    bool ok;
+};
+
+///
+/// @brief 前端的名字与创建函数
+///
+struct FrontEnd {
+    const char * name;
+    FrontEndExecutor * (*create)(const std::string & file);
+};
+
+static const FrontEnd frontEnds[] = {
+    {"flex/bison", [](const std::string & file) -> FrontEndExecutor * { return new FlexBisonExecutor(file); }},
+    {"antlr4", [](const std::string & file) -> FrontEndExecutor * { return new Antlr4Executor(file); }},
+    {"recursive-descent",
+     [](const std::string & file) -> FrontEndExecutor * { return new RecursiveDescentExecutor(file); }},
+};
+
+/// @brief 选项
+static struct option long_options[] = {
+    {"help", no_argument, nullptr, 'h'},
+    {"functions", required_argument, nullptr, 'f'},
+    {"nesting", required_argument, nullptr, 'n'},
+    {"expr-depth", required_argument, nullptr, 'e'},
+    {"identifiers", required_argument, nullptr, 'i'},
+    {"statements", required_argument, nullptr, 's'},
+    {"error-position", required_argument, nullptr, 'p'},
+    {"repeat", required_argument, nullptr, 'r'},
+    {"seed", required_argument, nullptr, 'S'},
+    {"keep", required_argument, nullptr, 'k'},
+    {nullptr, 0, nullptr, 0},
+};
+
+/// @brief 显示帮助
+/// @param exeName 程序名
+static void showHelp(const char * exeName)
+{
+    printf("%s [options]\n", exeName);
+    printf("Options:\n");
+    printf("  -h, --help                 Show this help message\n");
+    printf("  -f, --functions=N          Number of generated functions (default 200)\n");
+    printf("  -n, --nesting=N            Block nesting depth inside each function (default 3)\n");
+    printf("  -e, --expr-depth=N         Expression tree depth (default 4)\n");
+    printf("  -i, --identifiers=N        Local variables per function (default 8)\n");
+    printf("  -s, --statements=N         Statements per block (default 8)\n");
+    printf("  -p, --error-position=PCT   Where to put the syntax error, 0-100 percent of functions (default 50)\n");
+    printf("  -r, --repeat=N             Runs per front end, the fastest is reported (default 5)\n");
+    printf("  -S, --seed=N               Random seed of the generator (default 1)\n");
+    printf("  -k, --keep=FILE            Also write the generated source to FILE\n");
+}
+
+///
+/// @brief 读取/proc/self/status中的内存项
+/// @param key 项目名，如VmHWM、VmRSS
+/// @return long 大小，单位KB，不支持时返回0
+///
+static long readStatusKB(const char * key)
+{
+    FILE * fp = fopen("/proc/self/status", "r");
+    if (!fp) {
+        return 0;
+    }
+
+    char line[256];
+    size_t keyLen = strlen(key);
+    long kb = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, key, keyLen) == 0 && line[keyLen] == ':') {
+            kb = strtol(line + keyLen + 1, nullptr, 10);
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    return kb;
+}
+
+///
+/// @brief 把内存峰值VmHWM重置为当前的VmRSS，Linux 4.0以上支持
+///
+static void resetPeakRSS()
+{
+    FILE * fp = fopen("/proc/self/clear_refs", "w");
+    if (fp) {
+        fputs("5", fp);
+        fclose(fp);
+    }
+}
+
+///
+/// @brief 把源程序写入临时文件
+/// @param source 源程序
+/// @param keep 不为空时同时写入的文件
+/// @return std::string 临时文件路径，失败时为空
+///
+static std::string writeSource(const std::string & source, const char * keep = nullptr)
+{
+    char path[] = "/tmp/minic-bench-XXXXXX.c";
+    int fd = mkstemps(path, 2);
+    if (fd < 0) {
+        return "";
+    }
+
+    bool ok = write(fd, source.data(), source.size()) == (ssize_t) source.size();
+    close(fd);
+
+    if (keep) {
+        FILE * fp = fopen(keep, "w");
+        if (fp) {
+            fwrite(source.data(), 1, source.size(), fp);
+            fclose(fp);
+        }
+    }
+
+    return ok ? path : "";
+}
+
+///
+/// @brief 统计源程序的记号数，三种前端的词法相同，采用递归下降前端的扫描器统计
+/// @param source 源程序
+/// @return size_t 记号数，不含文件结束
+///
+static size_t countTokens(const std::string & source)
+{
+    std::vector<char> buf(source.size() + RD_SCAN_PADDING, '\0');
+    memcpy(buf.data(), source.data(), source.size());
+
+    std::vector<RDToken> tokens;
+    std::string diagnostics;
+    (void) rd_scan(buf.data(), source.size(), tokens, diagnostics);
+
+    return tokens.empty() ? 0 : tokens.size() - 1;
+}
+
+///
+/// @brief 在子进程中前端分析一次
+///
+/// 每次分析都在新的子进程中进行，内存峰值不受之前分析遗留的堆空间影响，
+/// 前端崩溃时也只是该次分析失败。子进程中屏蔽标准输出与错误输出。
+///
+/// @param fe 前端
+/// @param file 源文件
+/// @return BenchResult 测量结果
+///
+static BenchResult runOnce(const FrontEnd & fe, const std::string & file)
+{
+    BenchResult result{};
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return result;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+
+        close(fds[0]);
+
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        dup2(null, STDERR_FILENO);
+
+        resetPeakRSS();
+        long baseKB = readStatusKB("VmRSS");
+
+        auto start = std::chrono::steady_clock::now();
+
+        FrontEndExecutor * executor = fe.create(file);
+        result.ok = executor->run();
+        std::unique_ptr<ASTContext> astContext = executor->takeASTContext();
+        delete executor;
+
+        auto stop = std::chrono::steady_clock::now();
+
+        result.seconds = std::chrono::duration<double>(stop - start).count();
+        result.nodes = astContext->getNodeCount();
+        result.peakKB = readStatusKB("VmHWM") - baseKB;
+
+        ssize_t n = write(fds[1], &result, sizeof(result));
+        _exit(n == (ssize_t) sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+
+    if (pid < 0 || read(fds[0], &result, sizeof(result)) != (ssize_t) sizeof(result)) {
+        // 子进程异常退出
+        result = BenchResult{};
+    }
+
+    close(fds[0]);
+
+    if (pid > 0) {
+        (void) waitpid(pid, nullptr, 0);
+    }
+
+    return result;
+}
+
+///
+/// @brief 多次分析取最快的一次，内存峰值取最大值
+/// @param fe 前端
+/// @param file 源文件
+/// @param repeat 次数
+/// @return BenchResult 测量结果
+///
+static BenchResult runBest(const FrontEnd & fe, const std::string & file, int repeat)
+{
+    BenchResult best = runOnce(fe, file);
+
+    for (int r = 1; r < repeat; ++r) {
+        BenchResult cur = runOnce(fe, file);
+        if (cur.seconds < best.seconds) {
+            cur.peakKB = std::max(cur.peakKB, best.peakKB);
+            best = cur;
+        } else {
+            best.peakKB = std::max(cur.peakKB, best.peakKB);
+        }
+    }
+
+    return best;
+}
+
+int main(int argc, char * argv[])
+{
+    MiniCGenOptions opts;
+    int errorPercent = 50;
+    int repeat = 5;
+    const char * keep = nullptr;
+
+    int ch;
+    while ((ch = getopt_long(argc, argv, "hf:n:e:i:s:p:r:S:k:", long_options, nullptr)) != -1) {
+        switch (ch) {
+            case 'f':
+                opts.functions = atoi(optarg);
+                break;
+            case 'n':
+                opts.nesting = atoi(optarg);
+                break;
+            case 'e':
+                opts.exprDepth = atoi(optarg);
+                break;
+            case 'i':
+                opts.identifiers = atoi(optarg);
+                break;
+            case 's':
+                opts.statements = atoi(optarg);
+                break;
+            case 'p':
+                errorPercent = atoi(optarg);
+                break;
+            case 'r':
+                repeat = std::max(1, atoi(optarg));
+                break;
+            case 'S':
+                opts.seed = (uint32_t) strtoul(optarg, nullptr, 10);
+                break;
+            case 'k':
+                keep = optarg;
+                break;
+            case 'h':
+                showHelp(argv[0]);
+                return 0;
+            default:
+                showHelp(argv[0]);
+                return 1;
+        }
+    }
+
+    // 正确的源程序
+    std::string source = generate_minic(opts);
+    std::string file = writeSource(source, keep);
+
+    // 在指定位置的函数内插入语法错误的源程序
+    MiniCGenOptions errorOpts = opts;
+    errorOpts.errorFunction = std::min(opts.functions - 1, opts.functions * std::max(0, errorPercent) / 100);
+    std::string errorFile = writeSource(generate_minic(errorOpts));
+
+    if (file.empty() || errorFile.empty()) {
+        fprintf(stderr, "cannot write the generated source to /tmp\n");
+        return 1;
+    }
+
+    size_t tokens = countTokens(source);
+
+    printf("source: %zu bytes, %zu tokens, %d functions, nesting %d, expr depth %d, %d identifiers\n",
+           source.size(),
+           tokens,
+           opts.functions,
+           opts.nesting,
+           opts.exprDepth,
+           opts.identifiers);
+    printf("syntax error in function %d (%d%%), best of %d runs\n\n", errorOpts.errorFunction, errorPercent, repeat);
+
+    printf("%-18s %10s %14s %14s %10s %10s %16s\n",
+           "front end",
+           "time ms",
+           "tokens/s",
+           "AST nodes/s",
+           "AST nodes",
+           "peak KB",
+           "first error ms");
+
+    for (const FrontEnd & fe: frontEnds) {
+
+        BenchResult ok = runBest(fe, file, repeat);
+        if (!ok.ok) {
+            printf("%-18s failed on the valid source\n", fe.name);
+            continue;
+        }
+
+        BenchResult err = runBest(fe, errorFile, repeat);
+
+        printf("%-18s %10.3f %14.0f %14.0f %10u %10ld %13.3f%s\n",
+               fe.name,
+               ok.seconds * 1e3,
+               tokens / ok.seconds,
+               ok.nodes / ok.seconds,
+               ok.nodes,
+               ok.peakKB,
+               err.seconds * 1e3,
+               // 错误恢复后仍然返回成功的前端加标记
+               err.ok ? " *" : "  ");
+    }
+
+    printf("\n* the front end recovered from the syntax error and still returned an AST\n");
+
+    unlink(file.c_str());
+    unlink(errorFile.c_str());
+
+    return 0;
+}
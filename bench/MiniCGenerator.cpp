@@ -0,0 +1,209 @@
+///
+/// @file MiniCGenerator.cpp
+/// @brief 前端性能测试用的MiniC源程序生成器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <random>
+
+#include "MiniCGenerator.h"
+
+/// @brief 全局变量个数
+#define GEN_GLOBAL_COUNT 4
+
+namespace {
+
+///
+/// @brief 源程序生成器，按深度优先生成函数、语句块与表达式
+///
+class MiniCGenerator {
+
+public:
+    explicit MiniCGenerator(const MiniCGenOptions & _opts) : opts(_opts), rng(_opts.seed)
+    {}
+
+    /// @brief 生成整个程序
+    std::string run()
+    {
+        out += "int";
+        for (int i = 0; i < GEN_GLOBAL_COUNT; ++i) {
+            out += i ? ", g" : " g";
+            out += std::to_string(i);
+        }
+        out += ";\n\n";
+
+        for (int f = 0; f < opts.functions; ++f) {
+            function(f);
+        }
+
+        return std::move(out);
+    }
+
+private:
+    /// @brief 生成一个函数定义
+    /// @param index 函数序号
+    void function(int index)
+    {
+        out += "int f" + std::to_string(index) + "()\n{\n";
+
+        indent = 1;
+        if (opts.identifiers > 0) {
+            line("int");
+            for (int i = 0; i < opts.identifiers; ++i) {
+                out += i ? ", v" : " v";
+                out += std::to_string(i);
+            }
+            out += ";\n";
+        }
+
+        if (index == opts.errorFunction) {
+            // 缺少右操作数，三种前端都会报语法错误
+            line(variable() + " = " + variable() + " + ;\n");
+        }
+
+        statements(opts.nesting);
+
+        line("return ");
+        expr(opts.exprDepth);
+        out += ";\n}\n\n";
+    }
+
+    /// @brief 生成一个语句块内的语句序列，中间位置嵌套下一层语句块
+    /// @param depth 剩余的嵌套深度
+    void statements(int depth)
+    {
+        for (int s = 0; s < opts.statements; ++s) {
+
+            if (depth > 0 && s == opts.statements / 2) {
+                line("{\n");
+                ++indent;
+                statements(depth - 1);
+                --indent;
+                line("}\n");
+                continue;
+            }
+
+            // 赋值语句或者以表达式为实参的函数调用语句
+            bool call = pick(4) == 0;
+            line(call ? std::string("putint(") : variable() + " = ");
+            expr(opts.exprDepth);
+            out += call ? ");\n" : ";\n";
+        }
+    }
+
+    /// @brief 生成表达式
+    /// @param depth 表达式树的剩余深度
+    void expr(int depth)
+    {
+        if (depth <= 0) {
+            leaf();
+            return;
+        }
+
+        switch (pick(8)) {
+            case 0:
+                out += "-";
+                expr(depth - 1);
+                break;
+            case 1:
+                out += "(";
+                expr(depth - 1);
+                out += ")";
+                break;
+            default: {
+                static const char * ops[] = {" + ", " - ", " * ", " / ", " % "};
+                expr(depth - 1);
+                out += ops[pick(5)];
+                expr((int) pick((uint32_t) depth));
+                break;
+            }
+        }
+    }
+
+    /// @brief 生成叶子：变量或者十进制、十六进制、八进制的整数
+    void leaf()
+    {
+        switch (pick(6)) {
+            case 0:
+                out += std::to_string(pick(1000));
+                break;
+            case 1:
+                out += "0x" + hex(pick(4096));
+                break;
+            case 2:
+                out += "0" + std::to_string(pick(7) + 1);
+                break;
+            default:
+                out += variable();
+                break;
+        }
+    }
+
+    /// @brief 随机选取一个局部变量，没有局部变量时选全局变量
+    std::string variable()
+    {
+        if (opts.identifiers > 0 && pick(4) != 0) {
+            return "v" + std::to_string(pick((uint32_t) opts.identifiers));
+        }
+
+        return "g" + std::to_string(pick(GEN_GLOBAL_COUNT));
+    }
+
+    /// @brief 按当前缩进输出一行的开头
+    void line(const std::string & text)
+    {
+        out.append((size_t) indent * 4, ' ');
+        out += text;
+    }
+
+    /// @brief 十六进制文本
+    static std::string hex(uint32_t v)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string s;
+        do {
+            s.insert(s.begin(), digits[v & 15]);
+            v >>= 4;
+        } while (v);
+        return s;
+    }
+
+    /// @brief 取[0, n)范围内的随机数
+    uint32_t pick(uint32_t n)
+    {
+        return n ? (uint32_t) (rng() % n) : 0;
+    }
+
+    /// @brief 生成参数
+    const MiniCGenOptions & opts;
+
+    /// @brief 随机数发生器
+    std::mt19937 rng;
+
+    /// @brief 生成的程序文本
+    std::string out;
+
+    /// @brief 当前缩进层次
+    int indent = 0;
+};
+
+} // namespace
+
+///
+/// @brief 按参数生成MiniC源程序
+/// @param opts 生成参数
+/// @return std::string 源程序文本
+///
+std::string generate_minic(const MiniCGenOptions & opts)
+{
+    return MiniCGenerator(opts).run();
+}
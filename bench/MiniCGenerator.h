@@ -0,0 +1,56 @@
+///
+/// @file MiniCGenerator.h
+/// @brief 前端性能测试用的MiniC源程序生成器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+///
+/// @brief 源程序生成的参数
+///
+/// 生成的程序只使用三种前端都支持的文法：全局与局部变量声明、赋值、return、
+/// 语句块、带参数的函数调用以及加减乘除取模与求负的表达式。
+///
+struct MiniCGenOptions {
+
+    /// @brief 函数个数，每个函数的函数体都按下面的参数生成
+    int functions = 200;
+
+    /// @brief 函数体内语句块的嵌套深度
+    int nesting = 3;
+
+    /// @brief 表达式树的深度
+    int exprDepth = 4;
+
+    /// @brief 每个函数的局部变量个数
+    int identifiers = 8;
+
+    /// @brief 每个语句块的语句个数
+    int statements = 8;
+
+    /// @brief 插入语法错误的函数序号，小于0时不插入
+    int errorFunction = -1;
+
+    /// @brief 随机数种子，相同参数与种子生成相同的程序
+    uint32_t seed = 1;
+};
+
+///
+/// @brief 按参数生成MiniC源程序
+/// @param opts 生成参数
+/// @return std::string 源程序文本
+///
+std::string generate_minic(const MiniCGenOptions & opts);
@@ -2,8 +2,8 @@
 /// @file AST.cpp
 /// @brief 抽象语法树AST管理的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.7
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,25 +12,41 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>标识符改为驻留编号
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>AST节点改为内存池分配
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>节点精简，IR产生信息移到附加表
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>子树重新编号，支持并入其它线程的子树
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>free_ast改为free_all_ast，明确释放当前线程的所有AST
+/// <tr><td>2026-10-16 <td>1.7     <td>zenglj  <td>AST的内存池与节点编号改为执行器持有的上下文，随根节点交给调用者
 /// </table>
 ///
+#include <algorithm>
+#include <cassert>
 #include <cstdarg>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "AST.h"
 #include "AttrType.h"
 #include "Types/IntegerType.h"
 #include "Types/VoidType.h"
 
-/* 整个AST的根节点 */
-ast_node * ast_root = nullptr;
+/// @brief 当前线程创建AST节点所用的上下文，由ASTContextScope设置
+static thread_local ASTContext * currentContext = nullptr;
+
+/// @brief 获取当前上下文中AST节点所用的内存池
+/// @return Arena& 内存池
+static Arena & ast_arena()
+{
+    return ast_context().getArena();
+}
 
 /// @brief 创建指定节点类型的节点
 /// @param _node_type 节点类型
 /// @param _line_no 行号
 ast_node::ast_node(ast_operator_type _node_type, Type * _type, int64_t _line_no)
-    : node_type(_node_type), line_no(-1), type(_type)
+    : node_type(_node_type), id(ast_context().newNodeId()), line_no(-1), type(_type)
 {}
 
 /// @brief 构造函数
@@ -57,7 +73,7 @@ ast_node::ast_node(var_id_attr attr) : ast_node(ast_operator_type::AST_OP_LEAF_V
 /// @brief 针对标识符ID的叶子构造函数
 /// @param _id 标识符ID
 /// @param _line_no 行号
-ast_node::ast_node(std::string _id, int64_t _line_no)
+ast_node::ast_node(SymbolId _id, int64_t _line_no)
     : ast_node(ast_operator_type::AST_OP_LEAF_VAR_ID, VoidType::getType(), _line_no)
 {
     name = _id;
@@ -92,7 +108,7 @@ bool ast_node::isLeafNode()
 /// @return 创建的节点
 ast_node * ast_node::New(ast_operator_type type, ...)
 {
-    ast_node * parent_node = new ast_node(type);
+    ast_node * parent_node = ast_arena().create<ast_node>(type);
 
     va_list valist;
 
@@ -136,7 +152,7 @@ ast_node * ast_node::insert_son_node(ast_node * node)
 /// @param attr 无符号整数字面量
 ast_node * ast_node::New(digit_int_attr attr)
 {
-    ast_node * node = new ast_node(attr);
+    ast_node * node = ast_arena().create<ast_node>(attr);
 
     return node;
 }
@@ -145,7 +161,7 @@ ast_node * ast_node::New(digit_int_attr attr)
 /// @param attr 字符型字面量
 ast_node * ast_node::New(var_id_attr attr)
 {
-    ast_node * node = new ast_node(attr);
+    ast_node * node = ast_arena().create<ast_node>(attr);
 
     return node;
 }
@@ -153,9 +169,9 @@ ast_node * ast_node::New(var_id_attr attr)
 /// @brief 创建标识符的叶子节点
 /// @param id 词法值
 /// @param line_no 行号
-ast_node * ast_node::New(std::string id, int64_t lineno)
+ast_node * ast_node::New(SymbolId id, int64_t lineno)
 {
-    ast_node * node = new ast_node(id, lineno);
+    ast_node * node = ast_arena().create<ast_node>(id, lineno);
 
     return node;
 }
@@ -166,35 +182,81 @@ ast_node * ast_node::New(std::string id, int64_t lineno)
 /// @return 创建的节点
 ast_node * ast_node::New(Type * type)
 {
-    ast_node * node = new ast_node(type);
+    ast_node * node = ast_arena().create<ast_node>(type);
 
     return node;
 }
 
-/// @brief 递归清理抽象语法树
-/// @param node AST的节点
-void ast_node::Delete(ast_node * node)
+/// @brief 构造函数
+/// @param context 作用域内创建节点所用的上下文
+ASTContextScope::ASTContextScope(ASTContext & context) : saved(currentContext)
 {
-    if (node) {
+    currentContext = &context;
+}
 
-        for (auto child: node->sons) {
-            ast_node::Delete(child);
-        }
+/// @brief 析构函数，恢复原来的上下文
+ASTContextScope::~ASTContextScope()
+{
+    currentContext = saved;
+}
 
-        // 这里没有必要清理孩子，由于下面就要删除该节点
-        // node->sons.clear();
-    }
+///
+/// @brief 获取当前线程的AST上下文，创建节点前必须先用ASTContextScope设置
+/// @return ASTContext& 上下文
+///
+ASTContext & ast_context()
+{
+    assert(currentContext != nullptr && "AST节点只能在ASTContextScope内创建");
 
-    // 清理node资源
-    delete node;
+    return *currentContext;
 }
 
 ///
-/// @brief AST资源清理
+/// @brief 按当前上下文的计数给子树的节点重新编号，用于并入其它上下文中创建的子树
+/// @param root 子树的根节点
 ///
-void free_ast(ast_node * root)
+void renumber_ast(ast_node * root)
 {
-    ast_node::Delete(root);
+    if (root == nullptr) {
+        return;
+    }
+
+    ASTContext & context = ast_context();
+
+    // 显式栈先根遍历，避免深的子树递归过深
+    std::vector<ast_node *> stack{root};
+
+    while (!stack.empty()) {
+
+        ast_node * node = stack.back();
+        stack.pop_back();
+
+        node->id = context.newNodeId();
+
+        for (size_t k = node->sons.size(); k > 0; --k) {
+            if (node->sons[k - 1] != nullptr) {
+                stack.push_back(node->sons[k - 1]);
+            }
+        }
+    }
+}
+
+/// @brief 追加孩子，空间不足时从AST内存池中重新分配两倍的空间
+/// @param node 孩子节点
+void ast_node_list::push_back(ast_node * node)
+{
+    if (count == capacity) {
+
+        // 旧的空间留在内存池中，随AST一起释放
+        uint32_t newCapacity = capacity ? capacity * 2 : 2;
+        ast_node ** newItems = ast_arena().allocateArray<ast_node *>(newCapacity);
+        std::copy(items, items + count, newItems);
+
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    items[count++] = node;
 }
 
 /// @brief 创建函数定义类型的内部AST节点
@@ -205,19 +267,19 @@ void free_ast(ast_node * root)
 /// @return 创建的节点
 ast_node * create_func_def(ast_node * type_node, ast_node * name_node, ast_node * block_node, ast_node * params_node)
 {
-    ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->line_no);
+    ast_node * node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->line_no);
 
     // 设置函数名
     node->name = name_node->name;
 
     // 如果没有参数，则创建参数节点
     if (!params_node) {
-        params_node = new ast_node(ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS);
+        params_node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS);
     }
 
     // 如果没有函数体，则创建函数体，也就是语句块
     if (!block_node) {
-        block_node = new ast_node(ast_operator_type::AST_OP_BLOCK);
+        block_node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_BLOCK);
     }
 
     (void) node->insert_son_node(type_node);
@@ -242,10 +304,6 @@ ast_node * create_func_def(type_attr & type, var_id_attr & id, ast_node * block_
     // 创建标识符终结符节点
     ast_node * id_node = ast_node::New(id.id, id.lineno);
 
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-    free(id.id);
-    id.id = nullptr;
-
     return create_func_def(type_node, id_node, block_node, params_node);
 }
 
@@ -260,7 +318,7 @@ ast_node * create_contain_node(ast_operator_type node_type,
                                ast_node * second_child,
                                ast_node * third_child)
 {
-    ast_node * node = new ast_node(node_type);
+    ast_node * node = ast_arena().create<ast_node>(node_type);
 
     if (first_child) {
         (void) node->insert_son_node(first_child);
@@ -304,14 +362,14 @@ ast_node * create_type_node(type_attr & attr)
 /// @return 创建的节点
 ast_node * create_func_call(ast_node * funcname_node, ast_node * params_node)
 {
-    ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_CALL);
+    ast_node * node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_CALL);
 
     // 设置调用函数名
     node->name = funcname_node->name;
 
     // 如果没有参数，则创建参数节点
     if (!params_node) {
-        params_node = new ast_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
+        params_node = ast_arena().create<ast_node>(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
     }
 
     (void) node->insert_son_node(funcname_node);
@@ -349,10 +407,6 @@ ast_node * createVarDeclNode(Type * type, var_id_attr & id)
     // 创建标识符终结符节点
     ast_node * id_node = ast_node::New(id.id, id.lineno);
 
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-    free(id.id);
-    id.id = nullptr;
-
     // 创建变量定义节点
     ast_node * decl_node = create_contain_node(ast_operator_type::AST_OP_VAR_DECL, type_node, id_node);
 
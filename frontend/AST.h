@@ -2,8 +2,8 @@
 /// @file AST.h
 /// @brief 抽象语法树AST管理的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.7
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,12 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>标识符改为驻留编号
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>AST节点改为内存池分配
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>节点精简，IR产生信息移到附加表
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>子树重新编号，支持并入其它线程的子树
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>free_ast改为free_all_ast，明确释放当前线程的所有AST
+/// <tr><td>2026-10-16 <td>1.7     <td>zenglj  <td>AST的内存池与节点编号改为执行器持有的上下文，随根节点交给调用者
 /// </table>
 ///
 #pragma once
@@ -21,8 +27,8 @@
 #include <string>
 #include <vector>
 
+#include "Arena.h"
 #include "AttrType.h"
-#include "IRCode.h"
 #include "Value.h"
 #include "VoidType.h"
 
@@ -151,6 +157,64 @@ enum class ast_operator_type : int {
     AST_OP_MAX,
 };
 
+class ast_node;
+
+///
+/// @brief AST节点的孩子列表，空间从AST内存池中分配，不需要析构
+///
+class ast_node_list {
+public:
+    /// @brief 第一个孩子的位置
+    ast_node ** begin() const
+    {
+        return items;
+    }
+
+    /// @brief 最后一个孩子之后的位置
+    ast_node ** end() const
+    {
+        return items + count;
+    }
+
+    /// @brief 孩子个数
+    size_t size() const
+    {
+        return count;
+    }
+
+    /// @brief 是否没有孩子
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /// @brief 获取第index个孩子
+    ast_node *& operator[](size_t index) const
+    {
+        return items[index];
+    }
+
+    /// @brief 获取最后一个孩子
+    ast_node * back() const
+    {
+        return items[count - 1];
+    }
+
+    /// @brief 追加孩子，空间不足时从AST内存池中重新分配两倍的空间
+    /// @param node 孩子节点
+    void push_back(ast_node * node);
+
+private:
+    /// @brief 孩子数组
+    ast_node ** items = nullptr;
+
+    /// @brief 孩子个数
+    uint32_t count = 0;
+
+    /// @brief 孩子数组的容量
+    uint32_t capacity = 0;
+};
+
 ///
 /// @brief 抽象语法树AST的节点描述类
 ///
@@ -159,32 +223,32 @@ public:
     /// @brief 节点类型
     ast_operator_type node_type;
 
+    /// @brief 节点编号，创建时按顺序分配，IR产生等阶段可用作附加信息表的下标
+    uint32_t id;
+
     /// @brief 行号信息，主要针对叶子节点有用
-    int64_t line_no;
+    int32_t line_no;
 
-    /// @brief 节点值的类型，可用于函数返回值类型
-    Type * type;
+    /// @brief 节点的属性值，按节点类型只有一个有效
+    union {
+        /// @brief 无符号整数字面量值，AST_OP_LEAF_LITERAL_UINT有效
+        uint32_t integer_val;
 
-    /// @brief 无符号整数字面量值
-    uint32_t integer_val;
+        /// @brief float类型字面量值，AST_OP_LEAF_LITERAL_FLOAT有效
+        float float_val;
 
-    /// @brief float类型字面量值
-    float float_val;
+        /// @brief 变量名，或者函数名，驻留后的编号，可通过symbol_name获取字符串
+        SymbolId name = SYMBOL_NONE;
+    };
 
-    /// @brief 变量名，或者函数名
-    std::string name;
+    /// @brief 节点值的类型，可用于函数返回值类型
+    Type * type;
 
     /// @brief 父节点
     ast_node * parent = nullptr;
 
     /// @brief 孩子节点
-    std::vector<ast_node *> sons;
-
-    /// @brief 线性IR指令块，可包含多条IR指令，用于线性IR指令产生用
-    InterCode blockInsts;
-
-    /// @brief 线性IR指令或者运行产生的Value，用于线性IR指令产生用
-    Value * val = nullptr;
+    ast_node_list sons;
 
     ///
     /// @brief 在进入block等节点时是否要进行作用域管理。默认要做。
@@ -210,7 +274,7 @@ public:
     /// @brief 针对标识符ID的叶子构造函数
     /// @param _id 标识符ID
     /// @param _line_no 行号
-    ast_node(std::string id, int64_t _line_no);
+    ast_node(SymbolId id, int64_t _line_no);
 
     /// @brief 判断是否是叶子节点
     /// @param type 节点类型
@@ -241,26 +305,101 @@ public:
     /// @brief 创建标识符的叶子节点
     /// @param id 词法值
     /// @param line_no 行号
-    static ast_node * New(std::string id, int64_t lineno);
+    static ast_node * New(SymbolId id, int64_t lineno);
 
     /// @brief 创建具备指定类型的节点
     /// @param type 节点值类型
     /// @param line_no 行号
     /// @return 创建的节点
     static ast_node * New(Type * type);
+};
 
-    ///
-    /// @brief 释放节点
-    /// @param node
-    ///
-    static void Delete(ast_node * node);
+///
+/// @brief AST的上下文，持有一次分析所产生的AST节点的内存池与节点编号的计数
+///
+/// 前端执行器各自持有一个上下文，分析时由ASTContextScope设为当前线程的上下文，
+/// 节点都从中分配并编号，因此节点编号在一个上下文内唯一，IR产生的附加表按节点个数分配。
+/// 分析结束后上下文与根节点一起交给调用者，与分析所在的线程无关，线程退出后AST仍然有效；
+/// 释放上下文即整体释放其中的所有AST。
+///
+class ASTContext {
+
+public:
+    ASTContext() = default;
+
+    ASTContext(const ASTContext &) = delete;
+    ASTContext & operator=(const ASTContext &) = delete;
+
+    /// @brief 获取节点所在的内存池
+    /// @return Arena& 内存池
+    Arena & getArena()
+    {
+        return arena;
+    }
+
+    /// @brief 获取已创建的节点个数，节点编号都小于该值
+    /// @return uint32_t 节点个数
+    [[nodiscard]] uint32_t getNodeCount() const
+    {
+        return nodeCount;
+    }
+
+    /// @brief 分配一个节点编号
+    /// @return uint32_t 节点编号
+    uint32_t newNodeId()
+    {
+        return nodeCount++;
+    }
+
+    /// @brief 接管other的所有内存块，other中的节点之后随本上下文释放，
+    /// 其节点编号与本上下文的重叠，并入时需用renumber_ast重新编号
+    /// @param other 被接管的上下文，之后为空
+    void adopt(ASTContext & other)
+    {
+        arena.adopt(other.arena);
+        other.nodeCount = 0;
+    }
+
+private:
+    /// @brief 节点与孩子列表所在的内存池
+    Arena arena;
+
+    /// @brief 已创建的节点个数
+    uint32_t nodeCount = 0;
 };
 
-/// @brief AST资源清理
-void free_ast(ast_node * root);
+///
+/// @brief 在作用域内把指定的上下文设为当前线程的AST上下文，退出作用域时恢复原来的上下文
+///
+class ASTContextScope {
+
+public:
+    /// @brief 构造函数
+    /// @param context 作用域内创建节点所用的上下文
+    explicit ASTContextScope(ASTContext & context);
+
+    /// @brief 析构函数，恢复原来的上下文
+    ~ASTContextScope();
 
-/// @brief抽象语法树的根节点指针
-extern ast_node * ast_root;
+    ASTContextScope(const ASTContextScope &) = delete;
+    ASTContextScope & operator=(const ASTContextScope &) = delete;
+
+private:
+    /// @brief 原来的上下文
+    ASTContext * saved;
+};
+
+///
+/// @brief 获取当前线程的AST上下文，创建节点前必须先用ASTContextScope设置
+/// @return ASTContext& 上下文
+///
+ASTContext & ast_context();
+
+///
+/// @brief 按当前上下文的计数给子树的节点重新编号，用于并入其它上下文中创建的子树
+/// @param root 子树的根节点
+///
+void renumber_ast(ast_node * root);
 
 /// @brief 创建AST的内部节点，请注意可追加孩子节点，请按次序依次加入，最多3个
 /// @param node_type 节点类型
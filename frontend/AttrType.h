@@ -2,8 +2,8 @@
 /// @file AttrType.h
 /// @brief 文法符号的属性类型
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,12 +11,15 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>标识符改为驻留编号
 /// </table>
 ///
 #pragma once
 
 #include <cstdint>
 
+#include "Symbol.h"
+
 ///
 /// @brief 基本类型枚举类
 ///
@@ -48,7 +51,7 @@ typedef struct digit_real_attr {
 /// @brief 词法与语法通信的标识符（变量名、函数名等）
 ///
 typedef struct var_id_attr {
-    char * id;      // 标识符名称
+    SymbolId id;    // 标识符名称，驻留后的编号
     int64_t lineno; // 行号
 } var_id_attr;
 
@@ -2,8 +2,8 @@
 /// @file FrontEndExecutor.h
 /// @brief 前端分析执行器的接口类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,10 +11,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>AST的内存池与节点编号改为执行器持有的上下文，随根节点交给调用者
 /// </table>
 ///
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "AST.h"
@@ -50,6 +52,16 @@ public:
         return astRoot;
     }
 
+    ///
+    /// @brief 取走抽象语法树的上下文，之后由调用者持有，释放上下文时整体释放AST。
+    /// 未取走时AST随执行器析构而释放
+    /// @return std::unique_ptr<ASTContext> 上下文
+    ///
+    std::unique_ptr<ASTContext> takeASTContext()
+    {
+        return std::move(astContext);
+    }
+
 protected:
     ///
     /// @brief 要解析的文件路径
@@ -59,5 +71,10 @@ protected:
     ///
     /// @brief  抽象语法树的根
     ///
-    ast_node * astRoot;
+    ast_node * astRoot = nullptr;
+
+    ///
+    /// @brief 抽象语法树的上下文，run中设为当前线程的上下文，AST的节点都在其中
+    ///
+    std::unique_ptr<ASTContext> astContext = std::make_unique<ASTContext>();
 };
@@ -2,8 +2,8 @@
 /// @file Graph.cpp
 /// @brief 利用graphviz图形化显示AST，本文件采用C语言实现，没有采用C++的类实现，注意AST的遍历方式和其它的不同
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,19 +12,20 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>标识符改为驻留编号
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>增加文本、JSON、DOT格式的输出，可指定函数与深度
 /// </table>
 ///
 
+#include <cstdio>
 #include <vector>
 
 #include "AST.h"
+#include "Common.h"
+#include "Graph.h"
 
 using namespace std;
 
-#ifdef USE_GRAPHVIZ
-
-#include <gvc.h>
-
 /// @brief 转换运算符成字符串
 /// @param astnode AST节点
 /// @return 运算符对应的字符串
@@ -40,7 +41,7 @@ string getNodeName(ast_node * astnode)
             nodeName = to_string(astnode->float_val);
             break;
         case ast_operator_type::AST_OP_LEAF_VAR_ID:
-            nodeName = astnode->name;
+            nodeName = symbol_name(astnode->name);
             break;
         case ast_operator_type::AST_OP_LEAF_TYPE:
             nodeName = astnode->type->toString();
@@ -149,8 +150,12 @@ string getNodeName(ast_node * astnode)
     return nodeName;
 }
 
+#ifdef USE_GRAPHVIZ
+
+#include <gvc.h>
+
 /// @brief AST遍历的函数类型声明
-Agnode_t * graph_visit_ast_node(Agraph_t *, ast_node *);
+Agnode_t * graph_visit_ast_node(Agraph_t *, ast_node *, int);
 
 /// @brief 叶子节点图形产生
 /// @param g graphviz的Agraph_t
@@ -188,8 +193,9 @@ Agnode_t * genLeafGraphNode(Agraph_t * g, ast_node * astnode)
 /// @brief 内部节点图形产生，包含父子关系的边等
 /// @param g graphviz的Agraph_t
 /// @param astnode 内部节点
+/// @param depth 剩余可输出的深度，为0时不再输出孩子，小于0时不限制
 /// @return 创建的图形节点
-Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode)
+Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode, int depth)
 {
     std::vector<Agnode_t *> son_nodes;
 
@@ -201,10 +207,10 @@ Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode)
 
     // 遍历AST内部结点的孩子，获取创建孩子的图形结点，递归
     // 这里用到了C++向量的容器遍历方法之一，从头开始到尾部
-    std::vector<ast_node *>::iterator pIter;
-    for (pIter = astnode->sons.begin(); pIter != astnode->sons.end(); ++pIter) {
+    ast_node ** pIter;
+    for (pIter = astnode->sons.begin(); depth != 0 && pIter != astnode->sons.end(); ++pIter) {
 
-        Agnode_t * son_node = graph_visit_ast_node(g, *pIter);
+        Agnode_t * son_node = graph_visit_ast_node(g, *pIter, depth - 1);
         if (son_node) {
             // 有孩子则加入，否则忽略
             son_nodes.push_back(son_node);
@@ -243,8 +249,9 @@ Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode)
 /// @brief 遍历抽象语法树节点产生图片，递归
 /// @param g graphviz的Agraph_t
 /// @param astnode AST的节点
+/// @param depth 剩余可输出的深度，小于0时不限制
 /// @return 创建的图形
-Agnode_t * graph_visit_ast_node(Agraph_t * g, ast_node * astnode)
+Agnode_t * graph_visit_ast_node(Agraph_t * g, ast_node * astnode, int depth)
 {
     // 非法节点
     if (nullptr == astnode) {
@@ -258,7 +265,7 @@ Agnode_t * graph_visit_ast_node(Agraph_t * g, ast_node * astnode)
         graph_node = genLeafGraphNode(g, astnode);
     } else {
         // 内部运算符节点
-        graph_node = genInternalGraphNode(g, astnode);
+        graph_node = genInternalGraphNode(g, astnode, depth);
     }
 
     return graph_node;
@@ -267,7 +274,9 @@ Agnode_t * graph_visit_ast_node(Agraph_t * g, ast_node * astnode)
 /// @brief 抽象语法树AST的图形化显示，这里用C语言实现
 /// @param root 抽象语法树的根
 /// @param filePath 转换成图形的文件名，主要要通过文件名后缀来区分图片的类型，如png，svg，pdf等皆可
-void OutputAST(ast_node * root, const std::string filePath)
+/// @param maxDepth 输出的最大深度，小于0时不限制
+/// @return true 成功 false 失败
+static bool OutputASTImage(ast_node * root, const std::string & filePath, int maxDepth)
 {
     // 创建GV的上下文
     GVC_t * gv = gvContext();
@@ -282,7 +291,7 @@ void OutputAST(ast_node * root, const std::string filePath)
     agsafeset(g, (char *) "dpi", (char *) "600", (char *) "");
 
     // 遍历AST产生图形的结点以及相关边
-    (void) graph_visit_ast_node(g, root);
+    (void) graph_visit_ast_node(g, root, maxDepth);
 
     // 设置图形的布局
     gvLayout(gv, g, "dot");
@@ -304,10 +313,250 @@ void OutputAST(ast_node * root, const std::string filePath)
     gvFreeLayout(gv, g);
     agclose(g);
     gvFreeContext(gv);
+
+    return true;
 }
 #else
-void OutputAST(ast_node * root, const std::string filePath)
+static bool OutputASTImage(ast_node * root, const std::string & filePath, int maxDepth)
 {
-    // 不使用Graphviz输出抽象语法树，默认什么都不做
+    // 没有Graphviz不能输出图片，可改用文本、JSON或DOT格式
+    minic_log(LOG_ERROR, "没有启用Graphviz，不能输出图片(%s)，请使用.txt、.json或.dot后缀", filePath.c_str());
+
+    return false;
 }
 #endif
+
+/// @brief 流式输出的格式
+enum class ASTDumpFormat {
+    /// @brief 缩进的文本
+    TEXT,
+
+    /// @brief JSON
+    JSON,
+
+    /// @brief Graphviz的DOT文本
+    DOT,
+};
+
+/// @brief 流式输出遍历时的栈帧
+struct ASTDumpFrame {
+
+    /// @brief 节点
+    ast_node * node;
+
+    /// @brief 下一个要访问的孩子序号
+    uint32_t next;
+
+    /// @brief 节点深度，根为0
+    int depth;
+};
+
+/// @brief 节点的显示名，函数定义与调用追加函数名
+/// @param node AST节点
+/// @return 显示名
+static string dumpLabel(ast_node * node)
+{
+    string label = getNodeName(node);
+
+    if (node->node_type == ast_operator_type::AST_OP_FUNC_DEF ||
+        node->node_type == ast_operator_type::AST_OP_FUNC_CALL) {
+        label += " ";
+        label += symbol_name(node->name);
+    }
+
+    return label;
+}
+
+/// @brief 输出带转义的字符串，JSON与DOT的字符串转义规则在这里用到的字符上相同
+/// @param fp 输出文件
+/// @param str 字符串
+static void dumpQuoted(FILE * fp, const string & str)
+{
+    fputc('"', fp);
+    for (char c: str) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', fp);
+        }
+        fputc(c, fp);
+    }
+    fputc('"', fp);
+}
+
+/// @brief 进入节点时的输出
+/// @param fp 输出文件
+/// @param format 格式
+/// @param node 节点
+/// @param parent 父节点，根节点为空
+/// @param index 节点在父节点中的孩子序号
+/// @param depth 深度
+/// @param truncated 是否因深度限制不再输出孩子
+static void dumpEnter(FILE * fp,
+                      ASTDumpFormat format,
+                      ast_node * node,
+                      ast_node * parent,
+                      uint32_t index,
+                      int depth,
+                      bool truncated)
+{
+    string label = dumpLabel(node);
+
+    switch (format) {
+        case ASTDumpFormat::TEXT:
+            fprintf(fp, "%*s%s", depth * 2, "", label.c_str());
+            if (node->line_no >= 0) {
+                fprintf(fp, " @%d", (int) node->line_no);
+            }
+            fputs(truncated ? " ...\n" : "\n", fp);
+            break;
+
+        case ASTDumpFormat::JSON:
+            if (index > 0) {
+                fputc(',', fp);
+            }
+            fputs("{\"op\":", fp);
+            dumpQuoted(fp, label);
+            if (node->line_no >= 0) {
+                fprintf(fp, ",\"line\":%d", (int) node->line_no);
+            }
+            if (truncated) {
+                fputs(",\"truncated\":true", fp);
+            } else if (!node->sons.empty()) {
+                fputs(",\"children\":[", fp);
+            }
+            break;
+
+        case ASTDumpFormat::DOT:
+            fprintf(fp, "  n%u [label=", node->id);
+            dumpQuoted(fp, truncated ? label + " ..." : label);
+            fputs(node->isLeafNode() ? ", shape=record, style=filled, fillcolor=yellow];\n" : "];\n", fp);
+            if (parent) {
+                fprintf(fp, "  n%u -> n%u;\n", parent->id, node->id);
+            }
+            break;
+    }
+}
+
+/// @brief 离开节点时的输出
+/// @param fp 输出文件
+/// @param format 格式
+/// @param node 节点
+/// @param truncated 是否因深度限制没有输出孩子
+static void dumpLeave(FILE * fp, ASTDumpFormat format, ast_node * node, bool truncated)
+{
+    if (format == ASTDumpFormat::JSON) {
+        fputs(!truncated && !node->sons.empty() ? "]}" : "}", fp);
+    }
+}
+
+/// @brief 边遍历边输出AST，采用显式栈，不受AST深度的限制
+/// @param fp 输出文件
+/// @param format 格式
+/// @param root 根节点
+/// @param maxDepth 最大深度，小于0时不限制
+static void dumpAST(FILE * fp, ASTDumpFormat format, ast_node * root, int maxDepth)
+{
+    if (format == ASTDumpFormat::DOT) {
+        fputs("digraph ast {\n  node [fontname=\"SimSun\"];\n", fp);
+    }
+
+    std::vector<ASTDumpFrame> stack;
+
+    bool truncated = maxDepth == 0 && !root->sons.empty();
+    dumpEnter(fp, format, root, nullptr, 0, 0, truncated);
+    if (truncated) {
+        dumpLeave(fp, format, root, truncated);
+    } else {
+        stack.push_back({root, 0, 0});
+    }
+
+    while (!stack.empty()) {
+
+        ASTDumpFrame & frame = stack.back();
+
+        if (frame.next == frame.node->sons.size()) {
+            dumpLeave(fp, format, frame.node, false);
+            stack.pop_back();
+            continue;
+        }
+
+        uint32_t index = frame.next++;
+        ast_node * child = frame.node->sons[index];
+        int depth = frame.depth + 1;
+
+        truncated = depth == maxDepth && !child->sons.empty();
+        dumpEnter(fp, format, child, frame.node, index, depth, truncated);
+
+        if (truncated) {
+            dumpLeave(fp, format, child, truncated);
+        } else {
+            // push_back可能使frame失效，之后不能再使用
+            stack.push_back({child, 0, depth});
+        }
+    }
+
+    if (format == ASTDumpFormat::DOT) {
+        fputs("}\n", fp);
+    } else if (format == ASTDumpFormat::JSON) {
+        fputc('\n', fp);
+    }
+}
+
+/// @brief 抽象语法树AST的输出
+/// @param root 抽象语法树的根
+/// @param filePath 输出的文件名，根据后缀决定格式
+/// @param opts 输出的选项，可指定函数与最大深度
+/// @return true 成功 false 失败
+bool OutputAST(ast_node * root, const std::string & filePath, const ASTOutputOptions & opts)
+{
+    if (!root) {
+        return false;
+    }
+
+    // 只输出指定的函数
+    if (!opts.funcName.empty()) {
+
+        ast_node * funcNode = nullptr;
+        for (auto son: root->sons) {
+            if (son->node_type == ast_operator_type::AST_OP_FUNC_DEF && symbol_name(son->name) == opts.funcName) {
+                funcNode = son;
+                break;
+            }
+        }
+
+        if (!funcNode) {
+            minic_log(LOG_ERROR, "AST中没有找到函数(%s)", opts.funcName.c_str());
+            return false;
+        }
+
+        root = funcNode;
+    }
+
+    string fileExtName;
+    string::size_type pos = filePath.find_last_of('.');
+    if (pos != string::npos) {
+        fileExtName = filePath.substr(pos + 1);
+    }
+
+    ASTDumpFormat format;
+    if (fileExtName == "txt" || fileExtName == "ast") {
+        format = ASTDumpFormat::TEXT;
+    } else if (fileExtName == "json") {
+        format = ASTDumpFormat::JSON;
+    } else if (fileExtName == "dot" || fileExtName == "gv") {
+        format = ASTDumpFormat::DOT;
+    } else {
+        return OutputASTImage(root, filePath, opts.maxDepth);
+    }
+
+    FILE * fp = fopen(filePath.c_str(), "w");
+    if (!fp) {
+        minic_log(LOG_ERROR, "文件(%s)不能打开", filePath.c_str());
+        return false;
+    }
+
+    dumpAST(fp, format, root, opts.maxDepth);
+
+    fclose(fp);
+
+    return true;
+}
@@ -2,8 +2,8 @@
 /// @file Graph.h
 /// @brief 利用graphviz图形化显示AST的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>增加文本、JSON、DOT格式的输出，可指定函数与深度
 /// </table>
 ///
 #pragma once
@@ -20,8 +21,34 @@
 #include "AST.h"
 
 ///
-/// @brief 抽象语法树AST的图形化显示，这里用C语言实现
+/// @brief 抽象语法树AST输出的选项
+///
+struct ASTOutputOptions {
+
+    /// @brief 只输出该函数的子树，为空时输出整个AST
+    std::string funcName;
+
+    /// @brief 输出的最大深度，根为0，小于0时不限制
+    int maxDepth = -1;
+};
+
+///
+/// @brief 转换AST节点成显示用的字符串
+/// @param astnode AST节点
+/// @return std::string 运算符或者叶子的值
+///
+std::string getNodeName(ast_node * astnode);
+
+///
+/// @brief 抽象语法树AST的输出
+///
+/// 根据文件名后缀决定输出的格式：
+/// .txt/.ast为缩进的文本，.json为JSON，.dot/.gv为DOT文本，这三种边遍历边写文件，不进行布局，适合大的AST；
+/// 其它后缀如png，svg，pdf等借助Graphviz布局后输出图片。
+///
 /// @param root 抽象语法树的根
-/// @param filePath 转换成图形的文件名，主要要通过文件名后缀来区分图片的类型，如png，svg，pdf等皆可
+/// @param filePath 输出的文件名
+/// @param opts 输出的选项，可指定函数与最大深度
+/// @return true 成功 false 失败
 ///
-void OutputAST(ast_node * root, std::string filePath);
+bool OutputAST(ast_node * root, const std::string & filePath, const ASTOutputOptions & opts = ASTOutputOptions());
@@ -0,0 +1,346 @@
+///
+/// @file Antlr4ASTBuilder.cpp
+/// @brief Antlr4的具体语法树直接构建AST
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <string>
+
+#include "Antlr4ASTBuilder.h"
+
+/// @brief 遍历CST产生AST
+/// @param root CST语法树的根结点
+/// @return AST的根节点
+ast_node * MiniCASTBuilder::run(MiniCParser::CompileUnitContext * root)
+{
+    return buildCompileUnit(root);
+}
+
+/// @brief 非终结运算符compileUnit的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildCompileUnit(MiniCParser::CompileUnitContext * ctx)
+{
+    // compileUnit: (funcDef | varDecl)* EOF
+
+    ast_node * compileUnitNode = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
+
+    // 必须先加入全局变量后加入函数，确保全局变量先声明后使用
+    for (auto varCtx: ctx->varDecl()) {
+        (void) compileUnitNode->insert_son_node(buildVarDecl(varCtx));
+    }
+
+    for (auto funcCtx: ctx->funcDef()) {
+        (void) compileUnitNode->insert_son_node(buildFuncDef(funcCtx));
+    }
+
+    return compileUnitNode;
+}
+
+/// @brief 非终结运算符funcDef的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildFuncDef(MiniCParser::FuncDefContext * ctx)
+{
+    // funcDef : T_INT T_ID T_L_PAREN T_R_PAREN block;
+
+    if (!ctx->T_INT() || !ctx->T_ID()) {
+        return nullptr;
+    }
+
+    // 函数返回类型
+    type_attr funcReturnType{BasicType::TYPE_INT, (int64_t) ctx->T_INT()->getSymbol()->getLine()};
+
+    // 函数名
+    var_id_attr funcId{intern_symbol(ctx->T_ID()->getText()), (int64_t) ctx->T_ID()->getSymbol()->getLine()};
+
+    // 函数体，形参目前没有
+    ast_node * blockNode = buildBlock(ctx->block());
+
+    return create_func_def(funcReturnType, funcId, blockNode, nullptr);
+}
+
+/// @brief 非终结运算符block的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildBlock(MiniCParser::BlockContext * ctx)
+{
+    // block : T_L_BRACE blockItemList? T_R_BRACE;
+    // blockItemList : blockItem+;
+
+    if (!ctx) {
+        return nullptr;
+    }
+
+    ast_node * blockNode = create_contain_node(ast_operator_type::AST_OP_BLOCK);
+
+    if (auto listCtx = ctx->blockItemList()) {
+        for (auto itemCtx: listCtx->blockItem()) {
+
+            // 空语句返回空指针，insert_son_node不会加入
+            (void) blockNode->insert_son_node(buildBlockItem(itemCtx));
+        }
+    }
+
+    return blockNode;
+}
+
+/// @brief 非终结运算符blockItem的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildBlockItem(MiniCParser::BlockItemContext * ctx)
+{
+    // blockItem : statement | varDecl
+    if (auto stmtCtx = ctx->statement()) {
+        return buildStatement(stmtCtx);
+    } else if (auto declCtx = ctx->varDecl()) {
+        return buildVarDecl(declCtx);
+    }
+
+    return nullptr;
+}
+
+/// @brief 非终结运算符statement的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildStatement(MiniCParser::StatementContext * ctx)
+{
+    // statement: T_RETURN expr T_SEMICOLON # returnStatement
+    // | lVal T_ASSIGN expr T_SEMICOLON # assignStatement
+    // | block  # blockStatement
+    // | expr ? T_SEMICOLON #expressionStatement;
+
+    // 带标签的产生式由不同的上下文子类区分，只有这里和unaryExp需要类型判断
+    if (auto assignCtx = dynamic_cast<MiniCParser::AssignStatementContext *>(ctx)) {
+
+        ast_node * lvalNode = assignCtx->lVal() ? buildId(assignCtx->lVal()->T_ID()) : nullptr;
+        ast_node * exprNode = buildExpr(assignCtx->expr());
+
+        return ast_node::New(ast_operator_type::AST_OP_ASSIGN, lvalNode, exprNode, nullptr);
+    } else if (auto returnCtx = dynamic_cast<MiniCParser::ReturnStatementContext *>(ctx)) {
+
+        return create_contain_node(ast_operator_type::AST_OP_RETURN, buildExpr(returnCtx->expr()));
+    } else if (auto blockCtx = dynamic_cast<MiniCParser::BlockStatementContext *>(ctx)) {
+
+        return buildBlock(blockCtx->block());
+    } else if (auto exprCtx = dynamic_cast<MiniCParser::ExpressionStatementContext *>(ctx)) {
+
+        // 空语句返回空指针
+        return buildExpr(exprCtx->expr());
+    }
+
+    return nullptr;
+}
+
+/// @brief 非终结运算符expr的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildExpr(MiniCParser::ExprContext * ctx)
+{
+    // expr: addExp;
+
+    return ctx ? buildAddExp(ctx->addExp()) : nullptr;
+}
+
+/// @brief 非终结符addExp的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildAddExp(MiniCParser::AddExpContext * ctx)
+{
+    // addExp : mulExp (addOp mulExp)*; 左结合
+
+    if (!ctx) {
+        return nullptr;
+    }
+
+    ast_node * left = buildMulExp(ctx->mulExp(0));
+
+    for (size_t k = 0;; ++k) {
+
+        auto opCtx = ctx->addOp(k);
+        if (!opCtx) {
+            break;
+        }
+
+        ast_operator_type op = opCtx->T_ADD() ? ast_operator_type::AST_OP_ADD : ast_operator_type::AST_OP_SUB;
+        ast_node * right = buildMulExp(ctx->mulExp(k + 1));
+
+        left = ast_node::New(op, left, right, nullptr);
+    }
+
+    return left;
+}
+
+/// @brief 非终结符mulExp的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildMulExp(MiniCParser::MulExpContext * ctx)
+{
+    // mulExp : unaryExp (mulOp unaryExp)*; 左结合
+
+    if (!ctx) {
+        return nullptr;
+    }
+
+    ast_node * left = buildUnaryExp(ctx->unaryExp(0));
+
+    for (size_t k = 0;; ++k) {
+
+        auto opCtx = ctx->mulOp(k);
+        if (!opCtx) {
+            break;
+        }
+
+        ast_operator_type op;
+        if (opCtx->T_MUL()) {
+            op = ast_operator_type::AST_OP_MUL;
+        } else if (opCtx->T_DIV()) {
+            op = ast_operator_type::AST_OP_DIV;
+        } else if (opCtx->T_MOD()) {
+            op = ast_operator_type::AST_OP_MOD;
+        } else {
+            op = ast_operator_type::AST_OP_MAX;
+        }
+
+        ast_node * right = buildUnaryExp(ctx->unaryExp(k + 1));
+
+        left = ast_node::New(op, left, right, nullptr);
+    }
+
+    return left;
+}
+
+/// @brief 非终结符unaryExp的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildUnaryExp(MiniCParser::UnaryExpContext * ctx)
+{
+    // unaryExp: T_SUB unaryExp # negativeExpr
+    // | primaryExp # primaryExpr
+    // | T_ID T_L_PAREN realParamList? T_R_PAREN # functionCallExpr;
+
+    if (auto primaryCtx = dynamic_cast<MiniCParser::PrimaryExprContext *>(ctx)) {
+
+        return buildPrimaryExp(primaryCtx->primaryExp());
+    } else if (auto negCtx = dynamic_cast<MiniCParser::NegativeExprContext *>(ctx)) {
+
+        ast_node * operandNode = buildUnaryExp(negCtx->unaryExp());
+
+        return ast_node::New(ast_operator_type::AST_OP_NEG, operandNode, nullptr, nullptr);
+    } else if (auto callCtx = dynamic_cast<MiniCParser::FunctionCallExprContext *>(ctx)) {
+
+        ast_node * funcNameNode = buildId(callCtx->T_ID());
+        ast_node * paramListNode = buildRealParamList(callCtx->realParamList());
+
+        return create_func_call(funcNameNode, paramListNode);
+    }
+
+    return nullptr;
+}
+
+/// @brief 非终结符primaryExp的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
+{
+    // primaryExp: T_L_PAREN expr T_R_PAREN | T_DIGIT | lVal;
+
+    if (!ctx) {
+        return nullptr;
+    }
+
+    if (auto digit = ctx->T_DIGIT()) {
+
+        // 无符号整型字面量，支持十六进制、八进制与十进制
+        std::string raw = digit->getText();
+        uint32_t val;
+        if (raw.size() > 1 && raw[0] == '0' && (raw[1] == 'x' || raw[1] == 'X')) {
+            val = (uint32_t) std::stoul(raw, nullptr, 16);
+        } else if (raw.size() > 1 && raw[0] == '0') {
+            val = (uint32_t) std::stoul(raw, nullptr, 8);
+        } else {
+            val = (uint32_t) std::stoul(raw, nullptr, 10);
+        }
+
+        return ast_node::New(digit_int_attr{val, (int64_t) digit->getSymbol()->getLine()});
+    } else if (auto lvalCtx = ctx->lVal()) {
+
+        return buildId(lvalCtx->T_ID());
+    }
+
+    // 带有括号的表达式
+    return buildExpr(ctx->expr());
+}
+
+/// @brief 非终结符realParamList的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildRealParamList(MiniCParser::RealParamListContext * ctx)
+{
+    // realParamList : expr (T_COMMA expr)*;
+
+    // 没有实参时由create_func_call创建空的实参节点
+    if (!ctx) {
+        return nullptr;
+    }
+
+    ast_node * paramListNode = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
+
+    for (auto paramCtx: ctx->expr()) {
+        (void) paramListNode->insert_son_node(buildExpr(paramCtx));
+    }
+
+    return paramListNode;
+}
+
+/// @brief 非终结符varDecl的遍历
+/// @param ctx CST上下文
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildVarDecl(MiniCParser::VarDeclContext * ctx)
+{
+    // varDecl: basicType varDef (T_COMMA varDef)* T_SEMICOLON;
+    // basicType: T_INT;
+    // varDef: T_ID;
+
+    ast_node * stmtNode = create_contain_node(ast_operator_type::AST_OP_DECL_STMT);
+
+    type_attr typeAttr{BasicType::TYPE_VOID, -1};
+    if (ctx->basicType() && ctx->basicType()->T_INT()) {
+        typeAttr.type = BasicType::TYPE_INT;
+        typeAttr.lineno = (int64_t) ctx->basicType()->T_INT()->getSymbol()->getLine();
+    }
+
+    for (auto varCtx: ctx->varDef()) {
+
+        ast_node * typeNode = create_type_node(typeAttr);
+        ast_node * idNode = buildId(varCtx->T_ID());
+
+        // 变量定义节点，孩子为类型与变量名
+        (void) stmtNode->insert_son_node(
+            ast_node::New(ast_operator_type::AST_OP_VAR_DECL, typeNode, idNode, nullptr));
+    }
+
+    return stmtNode;
+}
+
+/// @brief 标识符终结符创建叶子节点，含lVal与varDef
+/// @param id 标识符终结符
+/// @return AST的节点
+ast_node * MiniCASTBuilder::buildId(antlr4::tree::TerminalNode * id)
+{
+    if (!id) {
+        return nullptr;
+    }
+
+    return ast_node::New(intern_symbol(id->getText()), (int64_t) id->getSymbol()->getLine());
+}
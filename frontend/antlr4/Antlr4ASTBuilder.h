@@ -0,0 +1,102 @@
+///
+/// @file Antlr4ASTBuilder.h
+/// @brief Antlr4的具体语法树直接构建AST
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "AST.h"
+#include "AttrType.h"
+#include "MiniCParser.h"
+
+///
+/// @brief 遍历具体语法树产生抽象语法树
+///
+/// 每个非终结符对应一个build函数，参数是具体的上下文类型，直接返回AST节点，
+/// 不经过访问者的二次分派与std::any的装箱拆箱。
+/// 语法错误恢复后上下文的孩子可能缺失，build函数对空的上下文返回nullptr。
+///
+class MiniCASTBuilder {
+
+public:
+    /// @brief 遍历CST产生AST
+    /// @param root CST语法树的根结点
+    /// @return AST的根节点
+    ast_node * run(MiniCParser::CompileUnitContext * root);
+
+protected:
+    /// @brief 非终结运算符compileUnit的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildCompileUnit(MiniCParser::CompileUnitContext * ctx);
+
+    /// @brief 非终结运算符funcDef的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildFuncDef(MiniCParser::FuncDefContext * ctx);
+
+    /// @brief 非终结运算符block的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildBlock(MiniCParser::BlockContext * ctx);
+
+    /// @brief 非终结运算符blockItem的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildBlockItem(MiniCParser::BlockItemContext * ctx);
+
+    /// @brief 非终结运算符statement的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildStatement(MiniCParser::StatementContext * ctx);
+
+    /// @brief 非终结运算符expr的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildExpr(MiniCParser::ExprContext * ctx);
+
+    /// @brief 非终结符addExp的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildAddExp(MiniCParser::AddExpContext * ctx);
+
+    /// @brief 非终结符mulExp的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildMulExp(MiniCParser::MulExpContext * ctx);
+
+    /// @brief 非终结符unaryExp的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildUnaryExp(MiniCParser::UnaryExpContext * ctx);
+
+    /// @brief 非终结符primaryExp的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildPrimaryExp(MiniCParser::PrimaryExpContext * ctx);
+
+    /// @brief 非终结符realParamList的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildRealParamList(MiniCParser::RealParamListContext * ctx);
+
+    /// @brief 非终结符varDecl的遍历
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ast_node * buildVarDecl(MiniCParser::VarDeclContext * ctx);
+
+    /// @brief 标识符终结符创建叶子节点，含lVal与varDef
+    /// @param id 标识符终结符
+    /// @return AST的节点
+    ast_node * buildId(antlr4::tree::TerminalNode * id);
+};
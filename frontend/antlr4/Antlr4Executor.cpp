@@ -2,8 +2,8 @@
 /// @file Antlr4Executor.cpp
 /// @brief antlr4的词法与语法分析解析器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,13 +11,16 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>采用SLL/LL两阶段语法分析
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>改为直接构建AST，不再经过std::any
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>AST创建在执行器的上下文中
 /// </table>
 ///
 #include <iostream>
 
 #include "AST.h"
 #include "Antlr4Executor.h"
-#include "Antlr4CSTVisitor.h"
+#include "Antlr4ASTBuilder.h"
 #include "MiniCLexer.h"
 #include "Common.h"
 
@@ -25,6 +28,9 @@
 /// @return true: 成功 false：错误
 bool Antlr4Executor::run()
 {
+    // AST节点都创建在执行器的上下文中
+    ASTContextScope astScope(*astContext);
+
     std::ifstream ifs;
     ifs.open(filename);
     if (!ifs.is_open()) {
@@ -44,18 +50,40 @@ bool Antlr4Executor::run()
     // 利用antlr4进行分析，从compileUnit开始分析输入字符串
     MiniCParser parser{&tokenStream};
 
+    // 预测用的DFA缓存在MiniCParser的静态数据中，同一进程内的所有分析器实例共享，
+    // 这里不能调用clearDFA，以便多个文件编译时后续的分析可直接利用已有的DFA
+
+    // 第一阶段：SLL预测，出错立即放弃，不输出错误信息。正确的源程序绝大部分在此阶段完成
+    auto interpreter = parser.getInterpreter<antlr4::atn::ParserATNSimulator>();
+    interpreter->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+    parser.removeErrorListeners();
+    parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+
+    MiniCParser::CompileUnitContext * cstRoot;
+    try {
+        cstRoot = parser.compileUnit();
+    } catch (antlr4::ParseCancellationException &) {
+
+        // 第二阶段：SLL失败可能是真的语法错误，也可能是SLL能力不足，采用完整的LL重新分析，
+        // 并恢复缺省的错误处理，以便给出准确的错误信息
+        tokenStream.seek(0);
+        parser.reset();
+        parser.addErrorListener(&antlr4::ConsoleErrorListener::INSTANCE);
+        parser.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::LL);
+
+        cstRoot = parser.compileUnit();
+    }
+
     // 从具体语法树的根结点进行深度优先遍历，生成抽象语法树
-    auto cstRoot = parser.compileUnit();
     if (!cstRoot) {
         minic_log(LOG_ERROR, "Antlr4的词语与语法分析错误");
         return false;
     }
 
-    /// 新建遍历器对具体语法树进行分析，产生抽象语法树
-    MiniCCSTVisitor visitor;
-
-    // 遍历产生抽象语法树
-    astRoot = visitor.run(cstRoot);
+    // 遍历具体语法树，直接产生抽象语法树
+    MiniCASTBuilder builder;
+    astRoot = builder.run(cstRoot);
 
     return true;
 }
@@ -11,25 +11,13 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>改为可重入的纯语法分析器
 /// </table>
 ///
 #pragma once
 
 #include "AttrType.h"
 
-/// @brief yyparse的类型声明
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void * YYPARSE_PARAM);
-#else
-int yyparse();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void);
-#else
-int yyparse();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
+// yyparse的原型由bison根据%parse-param生成在MiniCBison.h中，即
+// int yyparse(yyscan_t scanner, ast_node ** root);
 #include "MiniCBison.h"
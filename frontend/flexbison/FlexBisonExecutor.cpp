@@ -2,8 +2,8 @@
 /// @file FlexBisonExecutor.cpp
 /// @brief Flex+Bison词语与语法分析执行器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,44 +11,85 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>普通文件通过mmap映射后交给flex扫描
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>改用可重入的扫描器与纯语法分析器，支持多线程
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>AST创建在执行器的上下文中
 /// </table>
 ///
 #include "FlexBisonExecutor.h"
 #include "BisonParser.h"
 #include "FlexLexer.h"
+#include "MappedFile.h"
 
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool FlexBisonExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    yyin = fopen(filename.c_str(), "r");
-    if (yyin == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
+    // AST节点都创建在执行器的上下文中，与运行所在的线程无关，结束后随根节点交给调用者
+    ASTContextScope astScope(*astContext);
+
+    // 每次分析都创建独立的扫描器状态，不同线程中的执行器互不干扰
+    yyscan_t scanner;
+    if (yylex_init(&scanner) != 0) {
+        printf("Can't create scanner for file %s\n", filename.c_str());
         return false;
     }
 
+    // flex要求扫描缓冲区以两个YY_END_OF_BUFFER_CHAR(即0)结尾
+    MappedFile source;
+    YY_BUFFER_STATE buffer = nullptr;
+    FILE * fp = nullptr;
+
+    // 普通文件直接映射到内存，flex在映射区上原地扫描，避免逐块read与拷贝
+    if (source.open(filename, 2)) {
+        buffer = yy_scan_buffer(source.data(), source.size() + 2, scanner);
+
+        // yy_scan_buffer不初始化缓冲区的行号，需要设置从第1行开始
+        if (buffer != nullptr) {
+            yyset_lineno(1, scanner);
+        }
+    }
+
+    if (buffer == nullptr) {
+
+        // 管道等不能映射的输入，仍采用stdio方式读取
+        fp = fopen(filename.c_str(), "r");
+        if (fp == nullptr) {
+            printf("Can't open file %s\n", filename.c_str());
+            yylex_destroy(scanner);
+            return false;
+        }
+
+        yyset_in(fp, scanner);
+    }
+
     // 如果要查看LALR的移进与归约过程，请设置yydebug为1
 #ifdef BISON_DEBUG_ENABLE
     yydebug = 1;
 #endif
 
-    // 词法、语法分析生成抽象语法树AST
-    bool result = yyparse();
-    if (0 != result) {
-        printf("yyparse failed\n");
+    // 词法、语法分析生成抽象语法树AST，根节点通过参数返回
+    ast_node * root = nullptr;
+    int result = yyparse(scanner, &root);
 
-        // 关闭文件
-        fclose(yyin);
+    // 释放扫描缓冲区与扫描器，映射区由source析构时解除
+    if (buffer != nullptr) {
+        yy_delete_buffer(buffer, scanner);
+    }
 
+    yylex_destroy(scanner);
+
+    if (fp != nullptr) {
+        fclose(fp);
+    }
+
+    if (0 != result) {
+        printf("yyparse failed\n");
         return false;
     }
 
     // 设置抽象语法树的根节点
-    astRoot = ast_root;
-
-    // 关闭文件
-    fclose(yyin);
+    astRoot = root;
 
     return true;
-}
\ No newline at end of file
+}
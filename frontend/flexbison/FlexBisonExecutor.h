@@ -11,8 +11,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>普通文件通过mmap映射后交给flex扫描
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>改用可重入的扫描器与纯语法分析器，支持多线程
 /// </table>
 ///
+#pragma once
+
 #include "FrontEndExecutor.h"
 
 class FlexBisonExecutor : public FrontEndExecutor {
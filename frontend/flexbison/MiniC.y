@@ -2,22 +2,42 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
-// bison生成的头文件
-//#include "BisonParser.h"
-
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
 #include "AttrType.h"
+%}
+
+// 这部分内容会输出到MiniCBison.h中，语法分析器与词法分析器的接口依赖这些类型
+%code requires {
+class ast_node;
+
+// 可重入扫描器的状态句柄，与flex生成的定义保持一致
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+}
+
+// 词法分析器的原型依赖YYSTYPE，因此放在YYSTYPE定义之后
+%code {
+// 词法分析头文件
+#include "FlexLexer.h"
+
 // LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg);
+}
 
-%}
+// 生成纯语法分析器，不再使用yylval、yylineno、ast_root等全局变量，可多线程同时分析不同的文件
+%define api.pure full
+
+// 词法分析器的状态通过参数传递给yylex
+%lex-param {yyscan_t scanner}
+
+// 语法分析的上下文：scanner为词法分析器状态，root用于返回抽象语法树的根节点
+%parse-param {yyscan_t scanner} {ast_node ** root}
 
 // 联合体声明，用于后续终结符和非终结符号属性指定使用
 %union {
@@ -115,14 +135,14 @@ CompileUnit : FuncDef {
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		$$ = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, $1);
 
-		// 设置到全局变量中
-		ast_root = $$;
+		// 通过语法分析上下文返回根节点
+		*root = $$;
 	}
 	| VarDecl {
 
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		$$ = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, $1);
-		ast_root = $$;
+		*root = $$;
 	}
 	| CompileUnit FuncDef {
 
@@ -151,7 +171,6 @@ FuncDef : BasicType T_ID T_L_PAREN T_R_PAREN Block  {
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
 		$$ = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
 	;
@@ -237,7 +256,7 @@ VarDeclExpr: BasicType VarDef {
         // 需要从 $1 (AST_OP_DECL_STMT) 中获取类型信息
         // 假设 $1 的第一个子节点 (AST_OP_VAR_DECL) 的第一个子节点是类型节点
         if (!$1 || $1->sons.empty() || !$1->sons[0] || $1->sons[0]->sons.empty() || !$1->sons[0]->sons[0]->type) {
-            yyerror("Internal error: Cannot extract type from previous VarDeclExpr");
+            yyerror(scanner, root, "Internal error: Cannot extract type from previous VarDeclExpr");
             YYABORT;
         }
         ast_node * type_node_for_new_var = ast_node::New($1->sons[0]->sons[0]->type);
@@ -256,14 +275,12 @@ VarDeclExpr: BasicType VarDef {
 VarDef : T_ID {
 		// 变量ID，无初始化
         // 使用现有的 ast_node::New(var_id_attr) 创建叶子节点
-		$$ = ast_node::New($1); 
-		free($1.id);
+		$$ = ast_node::New($1);
 	}
 	| T_ID T_ASSIGN Expr { // 变量ID，带初始化
         // $1 是 T_ID (var_id_attr)
         // $3 是 Expr (ast_node*)
         ast_node* id_node = ast_node::New($1); // 创建代表变量名的叶子节点
-        free($1.id); // 释放词法分析器分配的id字符串
 
         // 创建一个 AST_OP_INIT 节点，其子节点是 id_node 和 $3 (初始化表达式)
         $$ = create_contain_node(ast_operator_type::AST_OP_INIT, id_node, $3, nullptr);
@@ -324,13 +341,13 @@ WhileStmt : T_WHILE T_L_PAREN Expr T_R_PAREN Statement {
 
 BreakStmt : T_BREAK T_SEMICOLON {
         $$ = create_contain_node(ast_operator_type::AST_OP_BREAK);
-        if ($$) $$->line_no = yylineno; // 确保 $$ 非空后设置行号
+        if ($$) $$->line_no = yyget_lineno(scanner); // 确保 $$ 非空后设置行号
     }
     ;
 
 ContinueStmt : T_CONTINUE T_SEMICOLON {
         $$ = create_contain_node(ast_operator_type::AST_OP_CONTINUE);
-        if ($$) $$->line_no = yylineno; // 确保 $$ 非空后设置行号
+        if ($$) $$->line_no = yyget_lineno(scanner); // 确保 $$ 非空后设置行号
     }
     ;
 
@@ -450,10 +467,7 @@ UnaryExp : PrimaryExp {
 		// 没有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string($1.id), $1.lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
+		ast_node * name_node = ast_node::New($1.id, $1.lineno);
 
 		// 实参列表
 		ast_node * paramListNode = nullptr;
@@ -466,10 +480,7 @@ UnaryExp : PrimaryExp {
 		// 含有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string($1.id), $1.lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
+		ast_node * name_node = ast_node::New($1.id, $1.lineno);
 
 		// 实参列表
 		ast_node * paramListNode = $3;
@@ -519,16 +530,15 @@ LVal : T_ID {
 
 		// 创建变量名终结符节点
 		$$ = ast_node::New($1);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
 	}
 	;
 
 %%
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    (void) root;
+
+    printf("Line %d: %s\n", yyget_lineno(scanner), msg);
 }
@@ -55,7 +55,7 @@
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -72,23 +72,14 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
-// bison生成的头文件
-//#include "BisonParser.h"
-
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
 #include "AttrType.h"
-// LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
-
 
-#line 92 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 83 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -187,6 +178,16 @@ typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
+/* Unqualified %code blocks.  */
+#line 25 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+
+// 词法分析头文件
+#include "FlexLexer.h"
+
+// LR分析失败时所调用函数的原型声明
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg);
+
+#line 191 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
 
 #ifdef short
 # undef short
@@ -570,13 +571,13 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   113,   113,   121,   127,   132,   139,   162,   168,   179,
-     184,   193,   197,   208,   214,   233,   256,   262,   274,   284,
-     291,   292,   293,   294,   295,   296,   299,   306,   311,   317,
-     325,   331,   342,   347,   351,   355,   358,   362,   365,   369,
-     372,   376,   377,   381,   384,   388,   389,   390,   391,   399,
-     402,   405,   408,   414,   417,   422,   425,   428,   435,   441,
-     445,   449,   465,   484,   488,   494,   506,   510,   517
+       0,   133,   133,   141,   147,   152,   159,   181,   187,   198,
+     203,   212,   216,   227,   233,   252,   275,   280,   291,   301,
+     308,   309,   310,   311,   312,   313,   316,   323,   328,   334,
+     342,   348,   359,   364,   368,   372,   375,   379,   382,   386,
+     389,   393,   394,   398,   401,   405,   406,   407,   408,   416,
+     419,   422,   425,   431,   434,   439,   442,   445,   452,   458,
+     462,   466,   479,   495,   499,   505,   517,   521,   528
 };
 #endif
 
@@ -781,7 +782,7 @@ enum { YYENOMEM = -2 };
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (scanner, root, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
@@ -814,7 +815,7 @@ do {                                                                      \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Kind, Value); \
+                  Kind, Value, scanner, root); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -826,10 +827,12 @@ do {                                                                      \
 
 static void
 yy_symbol_value_print (FILE *yyo,
-                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   FILE *yyoutput = yyo;
   YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (root);
   if (!yyvaluep)
     return;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
@@ -844,12 +847,12 @@ yy_symbol_value_print (FILE *yyo,
 
 static void
 yy_symbol_print (FILE *yyo,
-                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   YYFPRINTF (yyo, "%s %s (",
              yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, root);
   YYFPRINTF (yyo, ")");
 }
 
@@ -883,7 +886,7 @@ do {                                                            \
 
 static void
 yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
-                 int yyrule)
+                 int yyrule, yyscan_t scanner, ast_node ** root)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -896,7 +899,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
                        YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
-                       &yyvsp[(yyi + 1) - (yynrhs)]);
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, root);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -904,7 +907,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, root); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
@@ -945,9 +948,11 @@ int yydebug;
 
 static void
 yydestruct (const char *yymsg,
-            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (root);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
@@ -958,13 +963,6 @@ yydestruct (const char *yymsg,
 }
 
 
-/* Lookahead token kind.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -974,8 +972,21 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (yyscan_t scanner, ast_node ** root)
 {
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
     yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
     int yyerrstatus = 0;
@@ -1128,7 +1139,7 @@ yybackup:
   if (yychar == YYEMPTY)
     {
       YYDPRINTF ((stderr, "Reading a token\n"));
-      yychar = yylex ();
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
@@ -1216,50 +1227,50 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* CompileUnit: FuncDef  */
-#line 113 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 133 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       {
 
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, (yyvsp[0].node));
 
-		// 设置到全局变量中
-		ast_root = (yyval.node);
+		// 通过语法分析上下文返回根节点
+		*root = (yyval.node);
 	}
-#line 1229 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1240 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 3: /* CompileUnit: VarDecl  */
-#line 121 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 141 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
 
 		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, (yyvsp[0].node));
-		ast_root = (yyval.node);
+		*root = (yyval.node);
 	}
-#line 1240 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1251 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 4: /* CompileUnit: CompileUnit FuncDef  */
-#line 127 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 147 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 
 		// 把函数定义的节点作为编译单元的孩子
 		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1250 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1261 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 5: /* CompileUnit: CompileUnit VarDecl  */
-#line 132 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 152 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 		// 把变量定义的节点作为编译单元的孩子
 		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1259 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1270 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 6: /* FuncDef: BasicType T_ID T_L_PAREN T_R_PAREN Block  */
-#line 139 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 159 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                     {
 
 		// 函数返回类型
@@ -1275,81 +1286,80 @@ yyreduce:
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
 		(yyval.node) = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
-#line 1282 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1292 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 7: /* Block: T_L_BRACE T_R_BRACE  */
-#line 162 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 181 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                             {
 		// 语句块没有语句
 
 		// 为了方便创建一个空的Block节点
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK);
 	}
-#line 1293 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1303 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 8: /* Block: T_L_BRACE BlockItemList T_R_BRACE  */
-#line 168 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 187 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                             {
 		// 语句块含有语句
 
 		// BlockItemList归约时内部创建Block节点，并把语句加入，这里不创建Block节点
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1304 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1314 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 9: /* BlockItemList: BlockItem  */
-#line 179 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 198 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                           {
 		// 第一个左侧的孩子节点归约成Block节点，后续语句可持续作为孩子追加到Block节点中
 		// 创建一个AST_OP_BLOCK类型的中间节点，孩子为Statement($1)
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK, (yyvsp[0].node));
 	}
-#line 1314 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1324 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 10: /* BlockItemList: BlockItemList BlockItem  */
-#line 184 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 203 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                   {
 		// 把BlockItem归约的节点加入到BlockItemList的节点中
 		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1323 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1333 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 11: /* BlockItem: Statement  */
-#line 193 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 212 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                        {
 		// 语句节点传递给归约后的节点上，综合属性
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1332 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1342 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 12: /* BlockItem: VarDecl  */
-#line 197 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 216 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
 		// 变量声明节点传递给归约后的节点上，综合属性
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1341 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1351 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 13: /* VarDecl: VarDeclExpr T_SEMICOLON  */
-#line 208 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 227 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                   {
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1349 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1359 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 14: /* VarDeclExpr: BasicType VarDef  */
-#line 214 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 233 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
         // ... 动作代码，为单个 BasicType VarDef 创建声明节点 ...
         // 例如，创建一个 AST_OP_VAR_DECL 节点，然后包装在一个临时的 AST_OP_DECL_STMT 中
@@ -1369,11 +1379,11 @@ yyreduce:
         // 对于第一个 VarDef，我们创建一个只包含一个 VAR_DECL 的 DECL_STMT。
         (yyval.node) = create_var_decl_stmt_node(single_var_decl_node);
     }
-#line 1373 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1383 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 15: /* VarDeclExpr: VarDeclExpr T_COMMA VarDef  */
-#line 233 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 252 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                  { // <--- 这里之前可能是 VarDefList，应为 VarDef
         // $1 是前一个 VarDeclExpr (它是一个 AST_OP_DECL_STMT 节点)
         // $3 是新的 VarDef 节点
@@ -1381,7 +1391,7 @@ yyreduce:
         // 需要从 $1 (AST_OP_DECL_STMT) 中获取类型信息
         // 假设 $1 的第一个子节点 (AST_OP_VAR_DECL) 的第一个子节点是类型节点
         if (!(yyvsp[-2].node) || (yyvsp[-2].node)->sons.empty() || !(yyvsp[-2].node)->sons[0] || (yyvsp[-2].node)->sons[0]->sons.empty() || !(yyvsp[-2].node)->sons[0]->sons[0]->type) {
-            yyerror("Internal error: Cannot extract type from previous VarDeclExpr");
+            yyerror(scanner, root, "Internal error: Cannot extract type from previous VarDeclExpr");
             YYABORT;
         }
         ast_node * type_node_for_new_var = ast_node::New((yyvsp[-2].node)->sons[0]->sons[0]->type);
@@ -1393,365 +1403,360 @@ yyreduce:
         // 将新的 single_var_decl_node 添加到 $1 (AST_OP_DECL_STMT) 的子节点列表中
         (yyval.node) = (yyvsp[-2].node)->insert_son_node(new_single_var_decl_node);
     }
-#line 1397 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1407 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 16: /* VarDef: T_ID  */
-#line 256 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 275 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
 		// 变量ID，无初始化
         // 使用现有的 ast_node::New(var_id_attr) 创建叶子节点
-		(yyval.node) = ast_node::New((yyvsp[0].var_id)); 
-		free((yyvsp[0].var_id).id);
+		(yyval.node) = ast_node::New((yyvsp[0].var_id));
 	}
-#line 1408 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1417 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 17: /* VarDef: T_ID T_ASSIGN Expr  */
-#line 262 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 280 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                              { // 变量ID，带初始化
         // $1 是 T_ID (var_id_attr)
         // $3 是 Expr (ast_node*)
         ast_node* id_node = ast_node::New((yyvsp[-2].var_id)); // 创建代表变量名的叶子节点
-        free((yyvsp[-2].var_id).id); // 释放词法分析器分配的id字符串
 
         // 创建一个 AST_OP_INIT 节点，其子节点是 id_node 和 $3 (初始化表达式)
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_INIT, id_node, (yyvsp[0].node), nullptr);
 	}
-#line 1422 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1430 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 18: /* BasicType: T_INT  */
-#line 274 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 291 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                  {
 		(yyval.type) = (yyvsp[0].type);
 	}
-#line 1430 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1438 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 19: /* Statement: T_RETURN Expr T_SEMICOLON  */
-#line 284 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 301 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                       {
         // 假设 create_unary_op_node(op, child)
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_RETURN, (yyvsp[-1].node));
     }
-#line 1439 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1447 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 20: /* Statement: Block  */
-#line 291 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 308 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
             { (yyval.node) = (yyvsp[0].node); }
-#line 1445 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1453 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 21: /* Statement: IfStmt  */
-#line 292 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 309 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.node) = (yyvsp[0].node); }
-#line 1451 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1459 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 22: /* Statement: WhileStmt  */
-#line 293 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 310 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.node) = (yyvsp[0].node); }
-#line 1457 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1465 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 23: /* Statement: BreakStmt  */
-#line 294 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 311 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.node) = (yyvsp[0].node); }
-#line 1463 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1471 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 24: /* Statement: ContinueStmt  */
-#line 295 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 312 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                    { (yyval.node) = (yyvsp[0].node); }
-#line 1469 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1477 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 25: /* Statement: Expr T_SEMICOLON  */
-#line 296 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 313 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                        {          // 表达式语句 (可能包含赋值表达式)
         (yyval.node) = (yyvsp[-1].node);
     }
-#line 1477 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1485 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 26: /* Statement: T_SEMICOLON  */
-#line 299 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 316 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {               // 空语句
         // 用一个特殊的节点表示空语句，或者直接返回 nullptr
         // $$ = create_simple_stmt_node(ast_operator_type::AST_OP_EMPTY_STMT, yylineno);
         (yyval.node) = nullptr; // 在 BlockItemList 中处理 nullptr
     }
-#line 1487 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1495 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 27: /* IfStmt: T_IF T_L_PAREN Expr T_R_PAREN Statement  */
-#line 306 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 323 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                               {
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_IF, (yyvsp[-2].node), (yyvsp[0].node), nullptr);
         // 手动设置行号，如果 create_contain_node 不会自动从第一个有效子节点获取的话
         if ((yyval.node) && (yyvsp[-2].node)) (yyval.node)->line_no = (yyvsp[-2].node)->line_no; // 以条件表达式的行号为准
     }
-#line 1497 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1505 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 28: /* IfStmt: T_IF T_L_PAREN Expr T_R_PAREN Statement T_ELSE Statement  */
-#line 311 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 328 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                                {
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_IF, (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
         if ((yyval.node) && (yyvsp[-4].node)) (yyval.node)->line_no = (yyvsp[-4].node)->line_no; // 以条件表达式的行号为准
     }
-#line 1506 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1514 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 29: /* WhileStmt: T_WHILE T_L_PAREN Expr T_R_PAREN Statement  */
-#line 317 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 334 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                        {
         // 假设 create_while_stmt_node(cond_expr, body_stmt)
         // $$ = create_while_stmt_node($3, $5);
         // 使用通用创建函数
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_WHILE, (yyvsp[-2].node), (yyvsp[0].node)); // $3是条件, $5是循环体
     }
-#line 1517 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1525 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 30: /* BreakStmt: T_BREAK T_SEMICOLON  */
-#line 325 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 342 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                 {
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_BREAK);
-        if ((yyval.node)) (yyval.node)->line_no = yylineno; // 确保 $$ 非空后设置行号
+        if ((yyval.node)) (yyval.node)->line_no = yyget_lineno(scanner); // 确保 $$ 非空后设置行号
     }
-#line 1526 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1534 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 31: /* ContinueStmt: T_CONTINUE T_SEMICOLON  */
-#line 331 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 348 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                       {
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_CONTINUE);
-        if ((yyval.node)) (yyval.node)->line_no = yylineno; // 确保 $$ 非空后设置行号
+        if ((yyval.node)) (yyval.node)->line_no = yyget_lineno(scanner); // 确保 $$ 非空后设置行号
     }
-#line 1535 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1543 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 32: /* Expr: AssignExpr  */
-#line 342 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 359 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                      { (yyval.node) = (yyvsp[0].node); }
-#line 1541 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1549 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 33: /* AssignExpr: LVal T_ASSIGN AssignExpr  */
-#line 347 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 364 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                       { // 右结合: a = b = c  解析为 a = (b = c)
                // 假设 create_binary_op_node(op, left, right)
                (yyval.node) = create_contain_node(ast_operator_type::AST_OP_ASSIGN, (yyvsp[-2].node), (yyvsp[0].node));
            }
-#line 1550 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1558 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 34: /* AssignExpr: LOrExp  */
-#line 351 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 368 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                     { (yyval.node) = (yyvsp[0].node); }
-#line 1556 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1564 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 35: /* LOrExp: LOrExp T_LOR LAndExp  */
-#line 355 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 372 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                {
             (yyval.node) = create_contain_node(ast_operator_type::AST_OP_LOR, (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1564 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1572 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 36: /* LOrExp: LAndExp  */
-#line 358 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 375 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   { (yyval.node) = (yyvsp[0].node); }
-#line 1570 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1578 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 37: /* LAndExp: LAndExp T_LAND EqExp  */
-#line 362 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 379 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                { // 注意这里下一级是 EqExp (相等表达式)
             (yyval.node) = create_contain_node(ast_operator_type::AST_OP_LAND, (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1578 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1586 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 38: /* LAndExp: EqExp  */
-#line 365 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 382 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.node) = (yyvsp[0].node); }
-#line 1584 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1592 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 39: /* EqExp: EqExp EqOp RelExp  */
-#line 369 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 386 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                             { // 注意这里下一级是 RelExp (关系表达式)
             (yyval.node) = create_contain_node((ast_operator_type)(yyvsp[-1].op_class), (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1592 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1600 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 40: /* EqExp: RelExp  */
-#line 372 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 389 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                  { (yyval.node) = (yyvsp[0].node); }
-#line 1598 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1606 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 41: /* EqOp: T_EQ  */
-#line 376 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 393 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_EQ; }
-#line 1604 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1612 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 42: /* EqOp: T_NE  */
-#line 377 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 394 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_NE; }
-#line 1610 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1618 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 43: /* RelExp: RelExp RelOp AddExp  */
-#line 381 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 398 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               { // 注意这里下一级是 AddExp (加法表达式)
             (yyval.node) = create_contain_node((ast_operator_type)(yyvsp[-1].op_class), (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1618 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1626 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 44: /* RelExp: AddExp  */
-#line 384 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 401 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                  { (yyval.node) = (yyvsp[0].node); }
-#line 1624 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1632 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 45: /* RelOp: T_LT  */
-#line 388 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 405 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_LT; }
-#line 1630 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1638 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 46: /* RelOp: T_LE  */
-#line 389 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 406 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_LE; }
-#line 1636 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1644 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 47: /* RelOp: T_GT  */
-#line 390 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 407 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_GT; }
-#line 1642 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1650 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 48: /* RelOp: T_GE  */
-#line 391 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 408 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 { (yyval.op_class) = (int)ast_operator_type::AST_OP_GE; }
-#line 1648 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1656 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 49: /* AddExp: AddExp AddOp MulExp  */
-#line 399 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 416 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               { // <--- 修改为左递归
             (yyval.node) = create_contain_node((ast_operator_type)(yyvsp[-1].op_class), (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1656 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1664 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 50: /* AddExp: MulExp  */
-#line 402 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 419 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                  { (yyval.node) = (yyvsp[0].node); }
-#line 1662 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1670 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 51: /* MulExp: MulExp MulOp UnaryExp  */
-#line 405 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 422 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                 { // <--- 修改为左递归
             (yyval.node) = create_contain_node((ast_operator_type)(yyvsp[-1].op_class), (yyvsp[-2].node), (yyvsp[0].node));
         }
-#line 1670 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1678 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 52: /* MulExp: UnaryExp  */
-#line 408 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 425 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                    { (yyval.node) = (yyvsp[0].node); }
-#line 1676 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1684 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 53: /* AddOp: T_ADD  */
-#line 414 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 431 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
              {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_ADD;
 	}
-#line 1684 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1692 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 54: /* AddOp: T_SUB  */
-#line 417 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 434 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_SUB;
 	}
-#line 1692 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1700 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 55: /* MulOp: T_MUL  */
-#line 422 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 439 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
             (yyval.op_class) = (int)ast_operator_type::AST_OP_MUL;
         }
-#line 1700 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1708 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 56: /* MulOp: T_DIV  */
-#line 425 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 442 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
             (yyval.op_class) = (int)ast_operator_type::AST_OP_DIV;
         }
-#line 1708 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1716 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 57: /* MulOp: T_MOD  */
-#line 428 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 445 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
             (yyval.op_class) = (int)ast_operator_type::AST_OP_MOD;
         }
-#line 1716 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1724 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 58: /* UnaryExp: PrimaryExp  */
-#line 435 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 452 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       {
 		// 基本表达式
 
 		// 传递到归约后的UnaryExp上
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1727 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1735 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 59: /* UnaryExp: T_SUB UnaryExp  */
-#line 441 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 458 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                            { 
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_NEG, (yyvsp[0].node));
 	}
-#line 1735 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1743 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 60: /* UnaryExp: T_LNOT UnaryExp  */
-#line 445 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 462 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       { // 逻辑非! 优先级由 %right T_LNOT 控制
         (yyval.node) = create_contain_node(ast_operator_type::AST_OP_LNOT, (yyvsp[0].node));
     }
-#line 1743 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1751 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 61: /* UnaryExp: T_ID T_L_PAREN T_R_PAREN  */
-#line 449 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 466 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                    {
 		// 没有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string((yyvsp[-2].var_id).id), (yyvsp[-2].var_id).lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[-2].var_id).id);
+		ast_node * name_node = ast_node::New((yyvsp[-2].var_id).id, (yyvsp[-2].var_id).lineno);
 
 		// 实参列表
 		ast_node * paramListNode = nullptr;
@@ -1760,19 +1765,16 @@ yyreduce:
 		(yyval.node) = create_func_call(name_node, paramListNode);
 
 	}
-#line 1764 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1769 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 62: /* UnaryExp: T_ID T_L_PAREN RealParamList T_R_PAREN  */
-#line 465 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 479 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                  {
 		// 含有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string((yyvsp[-3].var_id).id), (yyvsp[-3].var_id).lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[-3].var_id).id);
+		ast_node * name_node = ast_node::New((yyvsp[-3].var_id).id, (yyvsp[-3].var_id).lineno);
 
 		// 实参列表
 		ast_node * paramListNode = (yyvsp[-1].node);
@@ -1780,74 +1782,71 @@ yyreduce:
 		// 创建函数调用节点，其孩子为被调用函数名和实参，实参不为空
 		(yyval.node) = create_func_call(name_node, paramListNode);
 	}
-#line 1784 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1786 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 63: /* PrimaryExp: T_L_PAREN Expr T_R_PAREN  */
-#line 484 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 495 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                        {
 		// 带有括号的表达式
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1793 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1795 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 64: /* PrimaryExp: T_DIGIT  */
-#line 488 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 499 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
         	// 无符号整型字面量
 
 		// 创建一个无符号整型的终结符节点
 		(yyval.node) = ast_node::New((yyvsp[0].integer_num));
 	}
-#line 1804 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1806 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 65: /* PrimaryExp: LVal  */
-#line 494 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 505 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		// 具有左值的表达式
 
 		// 直接传递到归约后的非终结符号PrimaryExp
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1815 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1817 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 66: /* RealParamList: Expr  */
-#line 506 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 517 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                      {
 		// 创建实参列表节点，并把当前的Expr节点加入
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS, (yyvsp[0].node));
 	}
-#line 1824 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1826 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 67: /* RealParamList: RealParamList T_COMMA Expr  */
-#line 510 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 521 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                      {
 		// 左递归增加实参表达式
 		(yyval.node) = (yyvsp[-2].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1833 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1835 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 68: /* LVal: T_ID  */
-#line 517 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 528 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
             {
 		// 变量名终结符
 
 		// 创建变量名终结符节点
 		(yyval.node) = ast_node::New((yyvsp[0].var_id));
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[0].var_id).id);
 	}
-#line 1847 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1846 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
 
-#line 1851 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1850 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
 
       default: break;
     }
@@ -1894,7 +1893,7 @@ yyerrlab:
   if (!yyerrstatus)
     {
       ++yynerrs;
-      yyerror (YY_("syntax error"));
+      yyerror (scanner, root, YY_("syntax error"));
     }
 
   if (yyerrstatus == 3)
@@ -1911,7 +1910,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner, root);
           yychar = YYEMPTY;
         }
     }
@@ -1967,7 +1966,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, root);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2005,7 +2004,7 @@ yyabortlab:
 | yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
 `-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, root, YY_("memory exhausted"));
   yyresult = 2;
   goto yyreturnlab;
 
@@ -2020,7 +2019,7 @@ yyreturnlab:
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner, root);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2029,7 +2028,7 @@ yyreturnlab:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, root);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -2040,11 +2039,13 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 528 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 536 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
 
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    (void) root;
+
+    printf("Line %d: %s\n", yyget_lineno(scanner), msg);
 }
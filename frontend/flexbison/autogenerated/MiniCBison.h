@@ -44,6 +44,18 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 14 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+
+class ast_node;
+
+// 可重入扫描器的状态句柄，与flex生成的定义保持一致
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+#line 59 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.h"
 
 /* Token kinds.  */
 #ifndef YYTOKENTYPE
@@ -94,7 +106,7 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 23 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 43 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/MiniC.y"
 
     class ast_node * node;
 
@@ -104,7 +116,7 @@ union YYSTYPE
     struct type_attr type;
     int op_class;
 
-#line 108 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.h"
+#line 120 "/home/code/LAB1/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -113,10 +125,9 @@ typedef union YYSTYPE YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
 
-int yyparse (void);
+int yyparse (yyscan_t scanner, ast_node ** root);
 
 
 #endif /* !YY_YY_HOME_CODE_LAB1_EXP04_MINIC_EXPR_FRONTEND_FLEXBISON_AUTOGENERATED_MINICBISON_H_INCLUDED  */
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentExecutor.cpp
 /// @brief 递归下降分析执行器类的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,38 +11,66 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>源文件整体映射到内存后再分析
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>支持按全局声明与函数定义切分后多线程分析
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>AST创建在执行器的上下文中
 /// </table>
 ///
+#include <cstdio>
+#include <vector>
+
+#include "MappedFile.h"
 #include "RecursiveDescentExecutor.h"
 #include "RecursiveDescentFlex.h"
+#include "RecursiveDescentParallel.h"
 #include "RecursiveDescentParser.h"
 
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool RecursiveDescentExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    rd_filein = fopen(filename.c_str(), "r");
-    if (rd_filein == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
-        return false;
-    }
+    // AST节点都创建在执行器的上下文中，与运行所在的线程无关
+    ASTContextScope astScope(*astContext);
 
-    // 如果要查看LALR的移进与归约过程，请设置yydebug为1
-    // yydebug = 1;
+    MappedFile source;
+    std::vector<char> streamBuffer;
+    const char * buf;
+    size_t size;
 
-    // 词法、语法分析生成抽象语法树AST
-    astRoot = rd_parse();
-    if (!astRoot) {
+    if (source.open(filename, RD_SCAN_PADDING)) {
+
+        // 普通文件直接映射到内存
+        buf = source.data();
+        size = source.size();
+    } else {
 
-        // 关闭文件
-        fclose(rd_filein);
+        // 管道等不能映射的输入，整体读入内存
+        FILE * fp = fopen(filename.c_str(), "r");
+        if (fp == nullptr) {
+            printf("Can't open file %s\n", filename.c_str());
+            return false;
+        }
 
-        return false;
+        char chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+            streamBuffer.insert(streamBuffer.end(), chunk, chunk + n);
+        }
+
+        fclose(fp);
+
+        // 尾部追加扫描器要求的0字节
+        size = streamBuffer.size();
+        streamBuffer.resize(size + RD_SCAN_PADDING, '\0');
+        buf = streamBuffer.data();
     }
 
-    // 关闭文件
-    fclose(rd_filein);
+    // 词法、语法分析生成抽象语法树AST
+    if (jobs == 1) {
+        astRoot = rd_parse(buf, size);
+    } else {
+        astRoot = rd_parse_parallel(buf, size, jobs);
+    }
 
-    return true;
-}
\ No newline at end of file
+    return astRoot != nullptr;
+}
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentExecutor.h
 /// @brief 递归下降分析执行器类的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>支持按全局声明与函数定义切分后多线程分析
 /// </table>
 ///
 #include "FrontEndExecutor.h"
@@ -20,7 +21,8 @@ class RecursiveDescentExecutor : public FrontEndExecutor {
 public:
     /// @brief 构造函数
     /// @param filename 输入的源文件
-    RecursiveDescentExecutor(std::string filename) : FrontEndExecutor(filename)
+    /// @param _jobs 分析的线程数，1表示顺序分析，0表示按CPU核数
+    RecursiveDescentExecutor(std::string filename, unsigned _jobs = 1) : FrontEndExecutor(filename), jobs(_jobs)
     {}
 
     /// @brief 析构函数
@@ -30,4 +32,8 @@ public:
     /// @brief 前端词法与语法解析生成AST
     /// @return true: 成功 false：错误
     bool run() override;
+
+protected:
+    /// @brief 分析的线程数，多于1个时按全局声明与函数定义切分源文件后并行分析
+    unsigned jobs;
 };
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentFlex.cpp
 /// @brief 词法分析的手动实现源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.6
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,248 +12,481 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>改为基于内存缓冲区的表驱动扫描，输出记号数组
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>支持指定起始行号，以便扫描源文件的片段
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>支持关系、相等与逻辑运算符
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>片段末尾不再读取片段之外的字符识别注释，修正-j下任务边界后紧跟注释时的死循环
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>错误信息写入调用者的缓冲区，不再直接打印
 /// </table>
 ///
 #include <cctype>
 #include <cstdio>
 #include <cstring>
-#include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
-#include "Common.h"
 
-/// @brief 词法分析的行号信息
-int64_t rd_line_no = 1;
+/// @brief 字符类别，扫描时根据首字符的类别决定识别哪一类记号
+enum RDCharClass : uint8_t {
+    CC_OTHER, // 非法字符
+    CC_SPACE, // 空白符号
+    CC_DIGIT, // 数字
+    CC_IDENT, // 字母或下划线
+    CC_PUNCT, // 运算符或分隔符
+};
+
+///
+/// @brief 字符分类表，按字符编码直接索引
+///
+struct RDCharTable {
+    /// @brief 字符类别
+    uint8_t cls[256];
+
+    /// @brief 单字符运算符或分隔符对应的记号类别
+    int8_t punct[256];
+
+    /// @brief 双字符运算符的第二个字符，0表示没有以该字符开头的双字符运算符
+    char second[256];
+
+    /// @brief 双字符运算符对应的记号类别
+    int8_t pair[256];
+
+    RDCharTable()
+    {
+        memset(cls, CC_OTHER, sizeof(cls));
+        memset(punct, T_ERR, sizeof(punct));
+        memset(second, 0, sizeof(second));
+        memset(pair, T_ERR, sizeof(pair));
+
+        cls[(uint8_t) ' '] = cls[(uint8_t) '\t'] = cls[(uint8_t) '\r'] = cls[(uint8_t) '\n'] = CC_SPACE;
+
+        for (int c = '0'; c <= '9'; c++) {
+            cls[c] = CC_DIGIT;
+        }
+
+        for (int c = 'a'; c <= 'z'; c++) {
+            cls[c] = CC_IDENT;
+            cls[c - 'a' + 'A'] = CC_IDENT;
+        }
+        cls[(uint8_t) '_'] = CC_IDENT;
+
+        setPunct('(', T_L_PAREN);
+        setPunct(')', T_R_PAREN);
+        setPunct('{', T_L_BRACE);
+        setPunct('}', T_R_BRACE);
+        setPunct(';', T_SEMICOLON);
+        setPunct(',', T_COMMA);
+        setPunct('=', T_ASSIGN);
+        setPunct('+', T_ADD);
+        setPunct('-', T_SUB);
+        setPunct('*', T_MUL);
+        setPunct('/', T_DIV);
+        setPunct('%', T_MOD);
+        setPunct('<', T_LT);
+        setPunct('>', T_GT);
+        setPunct('!', T_LNOT);
+
+        // &与|单独出现时是非法字符
+        setPunct('&', T_ERR);
+        setPunct('|', T_ERR);
 
-/// @brief 词法分析的token对应的字符识别
-std::string tokenValue;
+        setPair('<', '=', T_LE);
+        setPair('>', '=', T_GE);
+        setPair('=', '=', T_EQ);
+        setPair('!', '=', T_NE);
+        setPair('&', '&', T_LAND);
+        setPair('|', '|', T_LOR);
+    }
+
+    void setPunct(char c, RDTokenType kind)
+    {
+        cls[(uint8_t) c] = CC_PUNCT;
+        punct[(uint8_t) c] = (int8_t) kind;
+    }
+
+    void setPair(char c, char c2, RDTokenType kind)
+    {
+        second[(uint8_t) c] = c2;
+        pair[(uint8_t) c] = (int8_t) kind;
+    }
+};
 
-/// @brief 输入源文件指针
-FILE * rd_filein;
+/// @brief 字符分类表
+static const RDCharTable charTable;
 
 /// @brief 关键字与Token类别的数据结构
 struct KeywordToken {
-    std::string name;
+    const char * name;
+    uint32_t length;
     enum RDTokenType type;
 };
 
-/// @brief  关键字与Token对应表
-static KeywordToken allKeywords[] = {
-    {"int", RDTokenType::T_INT},
-    {"return", RDTokenType::T_RETURN},
+///
+/// @brief 关键字的完美散列表，下标由keywordHash计算，空位的length为0
+///
+static const KeywordToken keywordTable[8] = {
+    {"int", 3, T_INT},
+    {"break", 5, T_BREAK},
+    {"while", 5, T_WHILE},
+    {"else", 4, T_ELSE},
+    {"return", 6, T_RETURN},
+    {"continue", 8, T_CONTINUE},
+    {"", 0, T_ID},
+    {"if", 2, T_IF},
 };
 
+///
+/// @brief 关键字的完美散列函数，对MiniC的所有关键字无冲突
+/// @param id 标识符首地址
+/// @param len 标识符长度
+/// @return uint32_t 散列表下标
+///
+static inline uint32_t keywordHash(const char * id, uint32_t len)
+{
+    return (len * 5 + (uint8_t) id[0] + ((uint32_t) (uint8_t) id[len - 1] << 1)) & 7;
+}
+
 /// @brief 在标识符中检查是否时关键字，若是关键字则返回对应关键字的Token，否则返回T_ID
-/// @param id 标识符
+/// @param id 标识符首地址
+/// @param len 标识符长度
 /// @return Token
-static RDTokenType getKeywordToken(std::string id)
+static RDTokenType getKeywordToken(const char * id, uint32_t len)
+{
+    const KeywordToken & keyword = keywordTable[keywordHash(id, len)];
+
+    if (keyword.length == len && memcmp(keyword.name, id, len) == 0) {
+        return keyword.type;
+    }
+
+    // 如果不是关键字，说明是标识符
+    return T_ID;
+}
+
+///
+/// @brief 跳过空白符号，并统计跳过的换行数
+/// @param p 当前位置
+/// @param end 源文件结束位置
+/// @param line 行号
+/// @return const char* 第一个非空白符号的位置
+///
+static const char * skipSpaces(const char * p, const char * end, uint32_t & line)
 {
-    //如果在allkeywords中找到，则说明为关键字
-    for (auto & keyword: allKeywords) {
-        if (keyword.name == id) {
-            return keyword.type;
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    // 一次检查16个字符，源文件后的填充字节为0，不是空白符号，因此不会越过end
+    while (p < end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+        __m128i isLf = _mm_cmpeq_epi8(chunk, lf);
+        __m128i isSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), isLf));
+
+        uint32_t spaceMask = (uint32_t) _mm_movemask_epi8(isSpace);
+        uint32_t lfMask = (uint32_t) _mm_movemask_epi8(isLf);
+
+        if (spaceMask == 0xFFFF) {
+            line += __builtin_popcount(lfMask);
+            p += 16;
+            continue;
         }
+
+        uint32_t n = __builtin_ctz(~spaceMask);
+        line += __builtin_popcount(lfMask & ((1u << n) - 1));
+        p += n;
+        break;
+    }
+#else
+    while (p < end && charTable.cls[(uint8_t) *p] == CC_SPACE) {
+        if (*p == '\n') {
+            line++;
+        }
+        p++;
     }
-    // 如果不再allkeywords中，说明是标识符
-    return RDTokenType::T_ID;
+#endif
+
+    return p;
 }
 
-/// @brief 词法文法，获取下一个Token
-/// @return  Token，值保存在rd_lval中
-int rd_flex()
+///
+/// @brief 跳过单行注释，停在行尾的换行符上
+/// @param p 注释内容的开始位置
+/// @param end 源文件结束位置
+/// @return const char* 换行符的位置或end
+///
+static const char * skipLineComment(const char * p, const char * end)
 {
-    int c;              // 扫描的字符
-    int tokenKind = -1; // Token的值
-
-    // 忽略空白符号，主要有空格，TAB键和换行符
-    while ((c = fgetc(rd_filein)) == ' ' || c == '\t' || c == '\n' || c == '\r') {
-
-        // 支持Linux/Windows/Mac系统的行号分析
-        // Windows：\r\n
-        // Mac: \n
-        // Unix(Linux): \r
-        if (c == '\r') {
-            c = fgetc(rd_filein);
-            rd_line_no++;
-            if (c != '\n') {
-                // 不是\n，则回退
-                ungetc(c, rd_filein);
-            }
-        } else if (c == '\n') {
-            rd_line_no++;
+#ifdef __SSE2__
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while (p < end) {
+        uint32_t lfMask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) p), lf));
+        if (lfMask) {
+            p += __builtin_ctz(lfMask);
+            return p < end ? p : end;
         }
+        p += 16;
     }
-	// 注释处理
-	if (c == '/') {
-    int next = fgetc(rd_filein);
-    if (next == '/') {
-        // 单行注释
-        while ((c = fgetc(rd_filein)) != '\n' && c != EOF);
-        rd_line_no++;
-        return rd_flex();  // 递归调用继续扫描下一个有效token
-    } else if (next == '*') {
-        // 多行注释
-        int prev = 0;
-        while ((c = fgetc(rd_filein)) != EOF) {
-            if (c == '\n') rd_line_no++;
-            if (prev == '*' && c == '/') break;
-            prev = c;
+
+    return end;
+#else
+    while (p < end && *p != '\n') {
+        p++;
+    }
+
+    return p;
+#endif
+}
+
+///
+/// @brief 跳过多行注释，并统计跳过的换行数
+/// @param p 注释内容的开始位置
+/// @param end 源文件结束位置
+/// @param line 行号
+/// @return const char* 注释结束符之后的位置，注释未结束时为end
+///
+static const char * skipBlockComment(const char * p, const char * end, uint32_t & line)
+{
+#ifdef __SSE2__
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while (p < end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+        uint32_t starMask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, star));
+        uint32_t lfMask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, lf));
+
+        if (starMask == 0) {
+            line += __builtin_popcount(lfMask);
+            p += 16;
+            continue;
+        }
+
+        // 定位到*，检查其后是否是/
+        uint32_t n = __builtin_ctz(starMask);
+        line += __builtin_popcount(lfMask & ((1u << n) - 1));
+        p += n;
+
+        // 源文件的片段之后是下一个片段的内容，不能越过end匹配
+        if (p + 1 >= end) {
+            break;
+        }
+
+        if (p[1] == '/') {
+            return p + 2;
+        }
+
+        p++;
+    }
+#else
+    while (p + 1 < end) {
+        if (p[0] == '*' && p[1] == '/') {
+            return p + 2;
+        }
+
+        if (*p == '\n') {
+            line++;
+        }
+        p++;
+    }
+#endif
+
+    return end;
+}
+
+///
+/// @brief 跳过空白符号与注释
+/// @param p 当前位置
+/// @param end 源文件结束位置
+/// @param line 行号
+/// @return const char* 下一个记号的开始位置
+///
+static const char * skipBlanks(const char * p, const char * end, uint32_t & line)
+{
+    for (;;) {
+        p = skipSpaces(p, end, line);
+
+        // 源文件的片段在end之后不是0，而是下一个片段的内容，不能再按注释识别
+        if ((p + 1 >= end) || (p[0] != '/')) {
+            return p;
+        }
+
+        if (p[1] == '/') {
+            // 单行注释，换行符留给skipSpaces统计行号
+            p = skipLineComment(p + 2, end);
+        } else if (p[1] == '*') {
+            // 多行注释
+            p = skipBlockComment(p + 2, end, line);
+        } else {
+            // 除号
+            return p;
+        }
+    }
+}
+
+///
+/// @brief 识别整数字面量，十六进制为0[xX][0-9a-fA-F]+，八进制为0[0-7]+，十进制为[1-9][0-9]*或0
+/// @param p 首字符位置
+/// @return const char* 字面量之后的位置
+///
+static const char * scanNumber(const char * p)
+{
+    if (p[0] == '0') {
+        if ((p[1] == 'x' || p[1] == 'X') && isxdigit((uint8_t) p[2])) {
+            p += 2;
+            while (isxdigit((uint8_t) *p)) {
+                p++;
+            }
+        } else {
+            p++;
+            while (*p >= '0' && *p <= '7') {
+                p++;
+            }
         }
-        return rd_flex();
     } else {
-        // 除号
-        ungetc(next, rd_filein);
+        while (charTable.cls[(uint8_t) *p] == CC_DIGIT) {
+            p++;
+        }
     }
+
+    return p;
 }
-    // 文件结束符
-    if (c == EOF) {
-        // 返回文件结束符
-        return RDTokenType::T_EOF;
+
+///
+/// @brief 记录非法字符的词法错误
+/// @param diagnostics 错误信息
+/// @param line 行号
+/// @param c 非法字符
+///
+static void invalidChar(std::string & diagnostics, uint32_t line, char c)
+{
+    char msg[64];
+
+    snprintf(msg, sizeof(msg), "Line(%u): Invalid char %c\n", line, c);
+
+    diagnostics += msg;
+}
+
+///
+/// @brief 识别词法，把整个缓冲区一次性扫描成记号数组，数组以T_EOF结尾
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节，
+/// 或者buf[size - 1]是分隔符且其后至少还有RD_SCAN_PADDING个字节可读（源文件的片段）
+/// @param size 源文件的字节数
+/// @param tokens 输出的记号数组
+/// @param diagnostics 追加词法错误信息，每条一行，由调用者决定何时输出
+/// @param firstLine 缓冲区第一行的行号
+/// @return int 词法错误的个数
+///
+int rd_scan(const char * buf,
+            size_t size,
+            std::vector<RDToken> & tokens,
+            std::string & diagnostics,
+            uint32_t firstLine)
+{
+    const char * p = buf;
+    const char * end = buf + size;
+    uint32_t line = firstLine;
+    int errors = 0;
+
+    tokens.clear();
+
+    // 按平均每4个字符一个记号预留空间，避免频繁扩容
+    tokens.reserve(size / 4 + 1);
+
+    for (;;) {
+
+        // 忽略空白符号与注释
+        p = skipBlanks(p, end, line);
+        if (p >= end) {
+            break;
+        }
+
+        const char * start = p;
+        int32_t kind;
+
+        switch (charTable.cls[(uint8_t) *p]) {
+            case CC_DIGIT:
+                // 整数字面量，值在语法分析用到时再计算
+                p = scanNumber(p);
+                kind = T_DIGIT;
+                break;
+
+            case CC_IDENT:
+                // 标识符，包含关键字/保留字或自定义标识符，最长匹配
+                do {
+                    p++;
+                } while (charTable.cls[(uint8_t) *p] == CC_IDENT || charTable.cls[(uint8_t) *p] == CC_DIGIT);
+
+                kind = getKeywordToken(start, (uint32_t) (p - start));
+                break;
+
+            case CC_PUNCT:
+                kind = charTable.punct[(uint8_t) *p];
+                p++;
+
+                // 双字符运算符，最长匹配，源文件后的填充字节为0，不会越界
+                if (charTable.second[(uint8_t) *start] != 0 && *p == charTable.second[(uint8_t) *start]) {
+                    kind = charTable.pair[(uint8_t) *start];
+                    p++;
+                }
+
+                if (kind == T_ERR) {
+                    invalidChar(diagnostics, line, *start);
+                    errors++;
+                }
+                break;
+
+            default:
+                invalidChar(diagnostics, line, *p);
+                kind = T_ERR;
+                p++;
+                errors++;
+                break;
+        }
+
+        tokens.push_back({kind, (uint32_t) (start - buf), (uint32_t) (p - start), line});
     }
 
-    // TODO 请自行实现删除源文件中的注释，含单行注释和多行注释等
-
-    // 处理数字
-    // 处理数字
-	if (isdigit(c)) {
-    	rd_lval.integer_num.lineno = rd_line_no;
-
-		if (c == '0') {
-			c = fgetc(rd_filein);
-			if (c == 'x' || c == 'X') {
-				// 十六进制
-				int val = 0;
-				while (isxdigit(c = fgetc(rd_filein))) {
-					val = val * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
-				}
-				rd_lval.integer_num.val = val;
-				tokenValue = "0x" + tokenValue;
-				ungetc(c, rd_filein);
-			} else if (isdigit(c)) {
-				// 八进制
-				int val = 0;
-				do {
-					val = val * 8 + (c - '0');
-					c = fgetc(rd_filein);
-				} while (c >= '0' && c <= '7');
-				rd_lval.integer_num.val = val;
-				tokenValue = "0" + tokenValue;
-				ungetc(c, rd_filein);
-			} else {
-				// just zero
-				rd_lval.integer_num.val = 0;
-				tokenValue = "0";
-				ungetc(c, rd_filein);
-			}
-			} else {
-				// 十进制
-				rd_lval.integer_num.val = c - '0';
-				while (isdigit(c = fgetc(rd_filein))) {
-					rd_lval.integer_num.val = rd_lval.integer_num.val * 10 + c - '0';
-				}
-				tokenValue = std::to_string(rd_lval.integer_num.val);
-				ungetc(c, rd_filein);
-			}
-
-    tokenKind = RDTokenType::T_DIGIT;
-    } else if (c == '(') {
-        // 识别字符(
-        tokenKind = RDTokenType::T_L_PAREN;
-        // 存储字符(
-        tokenValue = "(";
-    } else if (c == ')') {
-        // 识别字符)
-        tokenKind = RDTokenType::T_R_PAREN;
-        // 存储字符)
-        tokenValue = ")";
-    } else if (c == '{') {
-        // 识别字符{
-        tokenKind = RDTokenType::T_L_BRACE;
-        // 存储字符{
-        tokenValue = "{";
-    } else if (c == '}') {
-        // 识别字符}
-        tokenKind = RDTokenType::T_R_BRACE;
-        // 存储字符}
-        tokenValue = "}";
-    } else if (c == ';') {
-        // 识别字符;
-        tokenKind = RDTokenType::T_SEMICOLON;
-        // 存储字符;
-        tokenValue = ";";
-    } else if (c == '+') {
-        // 识别字符+
-        tokenKind = RDTokenType::T_ADD;
-		// 存储字符+
-        tokenValue = "+";
-    } else if (c == '-') {
-        // 识别字符-
-        tokenKind = RDTokenType::T_SUB;
-		// 存储字符-
-        tokenValue = "-";
-    } else if (c == '/') {
-        // 识别字符/
-        tokenKind = RDTokenType::T_DIV;
-        // 存储字符/
-        tokenValue = "/";
-    } else if (c == '*') {
-        // 识别字符*
-        tokenKind = RDTokenType::T_MUL;
-		// 存储字符*
-		tokenValue = "*";
-	} else if (c == '%') {
-		// 识别字符%
-		tokenKind = RDTokenType::T_MOD;
-		// 存储字符%
-        tokenValue = "%";
-    } else if (c == '=') {
-        // 识别字符=
-        tokenKind = RDTokenType::T_ASSIGN;
-    }  else if (c == ',') {
-        // 识别字符;
-        tokenKind = RDTokenType::T_COMMA;
-		// 存储字符,
-        tokenValue = ",";
-    } else if (isLetterUnderLine(c)) {
-        // 识别标识符，包含关键字/保留字或自定义标识符
-
-        // 最长匹配标识符
-        std::string name;
-
-        do {
-            // 记录字符
-            name.push_back(c);
-            c = fgetc(rd_filein);
-        } while (isLetterDigitalUnderLine(c));
-
-        // 存储标识符
-        tokenValue = name;
-
-        // 多读的字符恢复，下次可继续读到该字符
-        ungetc(c, rd_filein);
-
-        // 检查是否是关键字，若是则返回对应的Token，否则返回T_ID
-        tokenKind = getKeywordToken(name);
-        if (tokenKind == RDTokenType::T_ID) {
-            // 自定义标识符
-
-            // 设置ID的值
-            rd_lval.var_id.id = strdup(name.c_str());
-
-            // 设置行号
-            rd_lval.var_id.lineno = rd_line_no;
-        } else if (tokenKind == RDTokenType::T_INT) {
-            // int关键字
-
-            // 设置类型与行号
-            rd_lval.type.type = BasicType::TYPE_INT;
-            rd_lval.type.lineno = rd_line_no;
+    // 文件结束符
+    tokens.push_back({T_EOF, (uint32_t) size, 0, line});
+
+    return errors;
+}
+
+///
+/// @brief 获取整数字面量记号的值，支持十进制、八进制与十六进制
+/// @param buf 源缓冲区
+/// @param token T_DIGIT记号
+/// @return uint32_t 整数值
+///
+uint32_t rd_digit_value(const char * buf, const RDToken & token)
+{
+    const char * p = buf + token.offset;
+    const char * end = p + token.length;
+    uint32_t val = 0;
+
+    if (token.length > 2 && (p[1] == 'x' || p[1] == 'X')) {
+        // 十六进制
+        for (p += 2; p < end; p++) {
+            val = val * 16 + (uint32_t) (isdigit((uint8_t) *p) ? *p - '0' : (tolower((uint8_t) *p) - 'a' + 10));
+        }
+    } else if (token.length > 1 && p[0] == '0') {
+        // 八进制
+        for (p++; p < end; p++) {
+            val = val * 8 + (uint32_t) (*p - '0');
         }
     } else {
-        printf("Line(%lld): Invalid char %s\n", (long long) rd_line_no, tokenValue.c_str());
-        tokenKind = RDTokenType::T_ERR;
+        // 十进制
+        for (; p < end; p++) {
+            val = val * 10 + (uint32_t) (*p - '0');
+        }
     }
 
-    // Token的类别
-    return tokenKind;
+    return val;
 }
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentFlex.h
 /// @brief 词法分析的头文件，不借助工具实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.4
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,17 +11,51 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>改为基于内存缓冲区的表驱动扫描，输出记号数组
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>支持指定起始行号，以便扫描源文件的片段
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>错误信息写入调用者的缓冲区，不再直接打印
 /// </table>
 ///
 #pragma once
 
-#include <stdio.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
-// 行号信息
-extern int rd_line_no;
+/// @brief 源缓冲区尾部要求的0字节个数，SSE2每次读取16字节，保证不越界
+#define RD_SCAN_PADDING 16
 
-// 输入文件指针
-extern FILE * rd_filein;
+///
+/// @brief 紧凑的记号，记号文本不复制，通过偏移与长度引用源缓冲区
+///
+struct RDToken {
+    int32_t kind;    // 记号类别，取值为RDTokenType
+    uint32_t offset; // 在源缓冲区中的偏移
+    uint32_t length; // 文本的字符个数
+    uint32_t line;   // 所在行号
+};
 
-/// 识别词法
-int rd_flex();
+///
+/// @brief 识别词法，把整个缓冲区一次性扫描成记号数组，数组以T_EOF结尾
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节，
+/// 或者buf[size - 1]是分隔符且其后至少还有RD_SCAN_PADDING个字节可读（源文件的片段）
+/// @param size 源文件的字节数
+/// @param tokens 输出的记号数组
+/// @param diagnostics 追加词法错误信息，每条一行，由调用者决定何时输出
+/// @param firstLine 缓冲区第一行的行号
+/// @return int 词法错误的个数
+///
+int rd_scan(const char * buf,
+            size_t size,
+            std::vector<RDToken> & tokens,
+            std::string & diagnostics,
+            uint32_t firstLine = 1);
+
+///
+/// @brief 获取整数字面量记号的值，支持十进制、八进制与十六进制
+/// @param buf 源缓冲区
+/// @param token T_DIGIT记号
+/// @return uint32_t 整数值
+///
+uint32_t rd_digit_value(const char * buf, const RDToken & token);
@@ -0,0 +1,244 @@
+///
+/// @file RecursiveDescentParallel.cpp
+/// @brief 按全局声明与函数定义切分源文件，多线程递归下降分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>各线程使用自己的AST上下文，由调用者的上下文接管
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>各片段的错误信息由主线程按源文件的次序输出，丢弃的片段不输出也不计数
+/// </table>
+///
+/// 全局变量声明与函数定义之间没有语法上的依赖，花括号配对后可以独立分析。
+/// 各线程的AST节点创建在线程自己的上下文中，结束后由调用者的上下文接管，
+/// 子树按源文件中的次序并入编译单元后重新编号，全局变量仍在使用它的函数之前。
+///
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "RecursiveDescentParallel.h"
+#include "RecursiveDescentParser.h"
+
+///
+/// @brief 一个分析任务的结果
+///
+struct RDPieceResult {
+    ast_node * root = nullptr; // 片段的编译单元节点
+    int errors = 0;            // 词法与语法错误的个数
+    bool complete = true;      // 是否分析到了片段的结尾
+    std::string diagnostics;   // 词法与语法错误信息，由主线程按源文件的次序输出
+};
+
+///
+/// @brief 扫描花括号的嵌套，在最外层的分号或右花括号之后切分源文件，跳过注释
+/// @param buf 源缓冲区
+/// @param size 源文件的字节数
+/// @param pieces 输出的片段，每个片段是一个全局声明或函数定义，最后一个片段包含到文件结尾的内容
+/// @return true 成功 false 花括号不配对，不能切分
+///
+bool rd_split_toplevel(const char * buf, size_t size, std::vector<RDPiece> & pieces)
+{
+    const char * p = buf;
+    const char * end = buf + size;
+    const char * start = buf;
+    uint32_t line = 1;
+    uint32_t startLine = 1;
+    int depth = 0;
+
+    pieces.clear();
+
+    while (p < end) {
+
+        char c = *p++;
+
+        switch (c) {
+            case '\n':
+                line++;
+                break;
+
+            case '/':
+                if (p < end && *p == '/') {
+                    // 行注释，换行符留给下一轮计数
+                    while (p < end && *p != '\n') {
+                        p++;
+                    }
+                } else if (p < end && *p == '*') {
+                    // 块注释
+                    for (p++; p < end && !(p[0] == '*' && p + 1 < end && p[1] == '/'); p++) {
+                        if (*p == '\n') {
+                            line++;
+                        }
+                    }
+                    p = std::min(p + 2, end);
+                }
+                break;
+
+            case '{':
+                depth++;
+                break;
+
+            case '}':
+                if (--depth < 0) {
+                    return false;
+                }
+
+                if (depth == 0) {
+                    // 函数定义结束
+                    pieces.push_back({(size_t) (start - buf), (size_t) (p - start), startLine});
+                    start = p;
+                    startLine = line;
+                }
+                break;
+
+            case ';':
+                if (depth == 0) {
+                    // 全局变量声明结束
+                    pieces.push_back({(size_t) (start - buf), (size_t) (p - start), startLine});
+                    start = p;
+                    startLine = line;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (depth != 0) {
+        return false;
+    }
+
+    // 最后的片段一直到文件结尾，只有空白和注释时也保留，由扫描器后面的0字节结束
+    pieces.push_back({(size_t) (start - buf), (size_t) (end - start), startLine});
+
+    return true;
+}
+
+///
+/// @brief 把相邻的小片段合并成分析任务，减少任务调度与子树合并的开销
+/// @param pieces 切分的片段
+/// @param size 源文件的字节数
+/// @param jobs 线程数
+/// @return std::vector<RDPiece> 分析任务，最后一个任务包含到文件结尾的内容
+///
+static std::vector<RDPiece> groupPieces(const std::vector<RDPiece> & pieces, size_t size, unsigned jobs)
+{
+    // 每个线程大约8个任务，以便负载均衡
+    size_t target = std::max<size_t>(size / (jobs * 8), 4096);
+
+    std::vector<RDPiece> tasks;
+
+    for (const RDPiece & piece: pieces) {
+        if (tasks.empty() || tasks.back().size >= target) {
+            tasks.push_back(piece);
+        } else {
+            tasks.back().size += piece.size;
+        }
+    }
+
+    return tasks;
+}
+
+///
+/// @brief 源文件切分后由多个线程分别递归下降分析，子树按源文件中的次序并入一个编译单元
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节
+/// @param size 源文件的字节数
+/// @param jobs 线程数，0表示按CPU核数
+/// @return ast_node* 空指针失败，否则成功
+///
+ast_node * rd_parse_parallel(const char * buf, size_t size, unsigned jobs)
+{
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 花括号不配对的源文件有语法错误，按顺序分析以便报告错误
+    std::vector<RDPiece> pieces;
+    if (jobs < 2 || !rd_split_toplevel(buf, size, pieces)) {
+        return rd_parse(buf, size);
+    }
+
+    std::vector<RDPiece> tasks = groupPieces(pieces, size, jobs);
+    if (tasks.size() < 2) {
+        return rd_parse(buf, size);
+    }
+
+    jobs = (unsigned) std::min<size_t>(jobs, tasks.size());
+
+    std::vector<RDPieceResult> results(tasks.size());
+    std::unique_ptr<ASTContext[]> contexts(new ASTContext[jobs]);
+    std::atomic<size_t> nextTask{0};
+
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+
+    for (unsigned w = 0; w < jobs; ++w) {
+        workers.emplace_back([&, w]() {
+            ASTContextScope astScope(contexts[w]);
+
+            for (;;) {
+                size_t k = nextTask.fetch_add(1, std::memory_order_relaxed);
+                if (k >= tasks.size()) {
+                    break;
+                }
+
+                const RDPiece & task = tasks[k];
+                RDPieceResult & result = results[k];
+                result.root = rd_parse_piece(buf + task.offset,
+                                             task.size,
+                                             task.line,
+                                             result.errors,
+                                             result.complete,
+                                             result.diagnostics);
+            }
+        });
+    }
+
+    for (auto & worker: workers) {
+        worker.join();
+    }
+
+    // 各线程的节点由调用者的上下文接管，与编译单元一起释放
+    for (unsigned w = 0; w < jobs; ++w) {
+        ast_context().adopt(contexts[w]);
+    }
+
+    // 按源文件的次序并入，全局变量仍在使用它的函数之前；
+    // 顺序分析遇到不能识别的记号时会停止，这里同样丢弃其后的片段，
+    // 错误信息也只输出并统计保留的片段的
+    ast_node * cu_node = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
+    int errors = 0;
+
+    for (const RDPieceResult & result: results) {
+
+        fputs(result.diagnostics.c_str(), stdout);
+        errors += result.errors;
+
+        for (ast_node * son: result.root->sons) {
+
+            // 各线程的节点编号相互重叠，按调用者上下文的计数重新编号
+            renumber_ast(son);
+            (void) cu_node->insert_son_node(son);
+        }
+
+        if (!result.complete) {
+            break;
+        }
+    }
+
+    if (errors != 0) {
+        return nullptr;
+    }
+
+    return cu_node;
+}
@@ -0,0 +1,49 @@
+///
+/// @file RecursiveDescentParallel.h
+/// @brief 按全局声明与函数定义切分源文件，多线程递归下降分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AST.h"
+
+///
+/// @brief 源文件的片段，由若干个完整的全局变量声明或函数定义组成
+///
+struct RDPiece {
+    size_t offset; // 在源缓冲区中的偏移
+    size_t size;   // 字节数
+    uint32_t line; // 第一行的行号
+};
+
+///
+/// @brief 扫描花括号的嵌套，在最外层的分号或右花括号之后切分源文件，跳过注释
+/// @param buf 源缓冲区
+/// @param size 源文件的字节数
+/// @param pieces 输出的片段，每个片段是一个全局声明或函数定义，最后一个片段包含到文件结尾的内容
+/// @return true 成功 false 花括号不配对，不能切分
+///
+bool rd_split_toplevel(const char * buf, size_t size, std::vector<RDPiece> & pieces);
+
+///
+/// @brief 源文件切分后由多个线程分别递归下降分析，子树按源文件中的次序并入一个编译单元
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节
+/// @param size 源文件的字节数
+/// @param jobs 线程数，0表示按CPU核数
+/// @return ast_node* 空指针失败，否则成功
+///
+ast_node * rd_parse_parallel(const char * buf, size_t size, unsigned jobs);
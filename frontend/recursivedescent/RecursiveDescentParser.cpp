@@ -2,8 +2,8 @@
 /// @file RecursiveDescentParser.cpp
 /// @brief 递归下降分析法实现的语法分析后产生抽象语法树的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.6
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,26 +12,41 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>基于记号数组进行分析，LookAhead按下标获取
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>标识符改为驻留编号
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>分析状态改为线程局部，支持分析源文件的片段
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>表达式改为按绑定强度表的算符优先分析，支持关系与逻辑运算
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>错误信息写入调用者的缓冲区，不再直接打印
 /// </table>
 ///
 #include <stdarg.h>
+#include <string>
+#include <vector>
 
 #include "AST.h"
 #include "AttrType.h"
 #include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
 
-// 定义全局变量给词法分析使用，用于填充值
-RDSType rd_lval;
+// 分析状态都是线程局部的，多个线程可同时分析源文件的不同片段
 
-// 词法识别的记号值，原始文本字符串
-extern std::string tokenValue;
+// 源缓冲区，记号的文本通过偏移与长度引用其中的内容
+static thread_local const char * rd_source = nullptr;
+
+// 词法分析产生的记号数组，以T_EOF结尾
+static thread_local std::vector<RDToken> rd_tokens;
+
+// LookAhead在记号数组中的下标
+static thread_local size_t rd_pos = 0;
 
 // 语法分析过程中的错误数目
-static int errno_num = 0;
+static thread_local int errno_num = 0;
+
+// 错误信息追加到这里，由调用者输出
+static thread_local std::string * rd_diagnostics = nullptr;
 
 // 语法分析过程中的LookAhead，指向下一个Token
-static RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
+static thread_local RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
 
 static ast_node * Block();
 static ast_node * expr();
@@ -48,11 +63,51 @@ static ast_node * expr();
 #define F(C) (lookaheadTag == C)
 
 ///
-/// @brief lookahead指向下一个Token
+/// @brief lookahead指向下一个Token，到达T_EOF后不再前移
 ///
 static void advance()
 {
-    lookaheadTag = (RDTokenType) rd_flex();
+    if (lookaheadTag != T_EOF) {
+        rd_pos++;
+    }
+
+    lookaheadTag = (RDTokenType) rd_tokens[rd_pos].kind;
+}
+
+///
+/// @brief 获取LookAhead指向的记号
+/// @return const RDToken& 记号
+///
+static inline const RDToken & current()
+{
+    return rd_tokens[rd_pos];
+}
+
+///
+/// @brief 获取当前整数字面量记号的属性
+/// @return digit_int_attr 整数值与行号
+///
+static digit_int_attr currentDigit()
+{
+    return digit_int_attr{rd_digit_value(rd_source, current()), current().line};
+}
+
+///
+/// @brief 获取当前标识符记号的属性，标识符直接从源缓冲区驻留，不产生中间字符串
+/// @return var_id_attr 标识符与行号
+///
+static var_id_attr currentId()
+{
+    return var_id_attr{intern_symbol(rd_source + current().offset, current().length), current().line};
+}
+
+///
+/// @brief 获取当前类型记号的属性，目前只有int
+/// @return type_attr 类型与行号
+///
+static type_attr currentType()
+{
+    return type_attr{BasicType::TYPE_INT, current().line};
 }
 
 ///
@@ -91,7 +146,7 @@ static void semerror(const char * format, ...)
 
     va_end(ap);
 
-    printf("Line(%d): %s\n", rd_line_no, logStr);
+    *rd_diagnostics += "Line(" + std::to_string(current().line) + "): " + logStr + "\n";
 
     errno_num++;
 }
@@ -142,27 +197,21 @@ static ast_node * idTail(var_id_attr & id)
     // 标识符节点
     ast_node * node = ast_node::New(id);
 
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串空间的分配
-    free(id.id);
-    id.id = nullptr;
-
     if (match(T_L_PAREN)) {
 
         // 函数调用，idTail: T_L_PAREN realParamList? T_R_PAREN
 
         ast_node * realParamsNode = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
 
-        if (match(T_R_PAREN)) {
-
-            // 被调用函数没有实参，返回一个空的实参清单节点
-            return realParamsNode;
-        }
+        // 被调用函数没有实参时实参清单节点为空
+        if (!match(T_R_PAREN)) {
 
-        // 识别实参列表
-        realParamList(realParamsNode);
+            // 识别实参列表
+            realParamList(realParamsNode);
 
-        if (!match(T_R_PAREN)) {
-            semerror("函数调用缺少右括号");
+            if (!match(T_R_PAREN)) {
+                semerror("函数调用缺少右括号");
+            }
         }
 
         // 创建函数调用节点
@@ -198,7 +247,7 @@ static ast_node * unaryExp()
 
         // 无符号整数，primaryExp: T_DIGIT
 
-        node = ast_node::New(rd_lval.integer_num);
+        node = ast_node::New(currentDigit());
 
         // 跳过当前记号，指向下一个记号
         advance();
@@ -217,92 +266,114 @@ static ast_node * unaryExp()
 
         // ID开头的表达式，可以是函数调用，也可以是数组(目前不支持)，或者简单变量，primaryExp: T_ID idTail
 
-        var_id_attr & id = rd_lval.var_id;
+        var_id_attr id = currentId();
 
         // 跳过当前记号，指向下一个记号
         advance();
 
         // 识别ID尾部符号
         node = idTail(id);
-    }else if (F(T_SUB)) {
-		// 取负运算：unaryExp -> T_SUB unaryExp
-		advance();  // 跳过 '-'
-		ast_node * operand = unaryExp();  // 递归调用获取负号后的表达式
-		node = ast_node::New(ast_operator_type::AST_OP_NEG, operand, nullptr, nullptr);
-	}
+    } else if (F(T_SUB) _(T_LNOT)) {
 
-    return node;
-}
-/// @brief 乘除运算符, 其文法为mulOp : T_MUL | T_DIV | T_MOD;
-/// @return ast_operator_type AST中节点的运算符
-/// @note 该函数的返回值是AST中节点的运算符
-static ast_operator_type mulOp() {
-    if (match(T_MUL)) return ast_operator_type::AST_OP_MUL;
-    if (match(T_DIV)) return ast_operator_type::AST_OP_DIV;
-    if (match(T_MOD)) return ast_operator_type::AST_OP_MOD;
-    return ast_operator_type::AST_OP_MAX;
-}
-/// @brief 乘除表达式，文法 mulExp : unaryExp (mulOp unaryExp)*
-/// 其中的*表示闭包，闭包的就是循环
-/// @return ast_node*
-static ast_node * mulExp() {
-    ast_node * left_node = unaryExp();
-    if (!left_node) return nullptr;
+        // 前缀运算符，unaryExp: T_SUB unaryExp | T_LNOT unaryExp
+        // 前缀运算符比所有的二元运算符结合得紧，操作数只能是一元表达式
+        ast_operator_type op = F(T_SUB) ? ast_operator_type::AST_OP_NEG : ast_operator_type::AST_OP_LNOT;
 
-    for (;;) {
-        ast_operator_type op = mulOp();
-        if (op == ast_operator_type::AST_OP_MAX) break;
+        // 跳过运算符
+        advance();
 
-        ast_node * right_node = unaryExp();
-        if (!right_node) break;
+        ast_node * operand = unaryExp();
 
-        left_node = create_contain_node(op, left_node, right_node);
+        node = ast_node::New(op, operand, nullptr, nullptr);
     }
 
-    return left_node;
+    return node;
 }
 ///
-/// @brief 加减运算符, 其文法为addOp : T_ADD | T_SUB;
-/// @return ast_operator_type AST中节点的运算符
+/// @brief 二元运算符的绑定强度表，按记号类别直接索引
 ///
-ast_operator_type addOp()
-{
-    ast_operator_type type = ast_operator_type::AST_OP_MAX;
-
-    if (F(T_ADD)) {
+/// 强度越大优先级越高，0表示不是二元运算符。强度与bison文法中的优先级声明一致，
+/// 从低到高依次为：|| && ==/!= 关系运算 +/- */%，都是左结合。
+///
+struct RDBinaryOpTable {
+    /// @brief 左绑定强度
+    uint8_t power[T_KIND_COUNT];
 
-        type = ast_operator_type::AST_OP_ADD;
+    /// @brief AST中节点的运算符
+    ast_operator_type op[T_KIND_COUNT];
 
-        // 跳过当前的记号，指向下一个记号
-        advance();
-    } else if (F(T_SUB)) {
+    RDBinaryOpTable()
+    {
+        for (int k = 0; k < T_KIND_COUNT; k++) {
+            power[k] = 0;
+            op[k] = ast_operator_type::AST_OP_MAX;
+        }
 
-        type = ast_operator_type::AST_OP_SUB;
+        set(T_LOR, 1, ast_operator_type::AST_OP_LOR);
+        set(T_LAND, 2, ast_operator_type::AST_OP_LAND);
+        set(T_EQ, 3, ast_operator_type::AST_OP_EQ);
+        set(T_NE, 3, ast_operator_type::AST_OP_NE);
+        set(T_LT, 4, ast_operator_type::AST_OP_LT);
+        set(T_LE, 4, ast_operator_type::AST_OP_LE);
+        set(T_GT, 4, ast_operator_type::AST_OP_GT);
+        set(T_GE, 4, ast_operator_type::AST_OP_GE);
+        set(T_ADD, 5, ast_operator_type::AST_OP_ADD);
+        set(T_SUB, 5, ast_operator_type::AST_OP_SUB);
+        set(T_MUL, 6, ast_operator_type::AST_OP_MUL);
+        set(T_DIV, 6, ast_operator_type::AST_OP_DIV);
+        set(T_MOD, 6, ast_operator_type::AST_OP_MOD);
+    }
 
-        // 跳过当前的记号，指向下一个记号
-        advance();
+    void set(RDTokenType kind, uint8_t _power, ast_operator_type _op)
+    {
+        power[kind] = _power;
+        op[kind] = _op;
     }
+};
 
-    return type;
-}
+/// @brief 二元运算符的绑定强度表
+static const RDBinaryOpTable binaryOps;
 
 ///
-/// @brief 加减表达式，文法 addExp : unaryExp (addOp unaryExp)*
-/// 其中的*表示闭包，闭包的就是循环
+/// @brief 获取LookAhead指向的记号作为二元运算符的绑定强度
+/// @return uint8_t 绑定强度，0表示不是二元运算符
 ///
+static inline uint8_t binaryPower()
+{
+    // T_ERR等负数的记号类别转为无符号数后超出范围
+    return (unsigned) lookaheadTag < (unsigned) T_KIND_COUNT ? binaryOps.power[lookaheadTag] : 0;
+}
+
+///
+/// @brief 二元表达式，按绑定强度的算符优先分析（Pratt分析），代替每个优先级一个函数的文法
+/// binaryExp(p) : unaryExp (op binaryExp(power(op) + 1))*，其中op的绑定强度不小于p
+/// 每个操作数只需一次unaryExp调用，运算符通过查表识别
+/// @param minPower 可以结合的运算符的最小绑定强度
 /// @return ast_node*
 ///
-static ast_node * addExp()
+static ast_node * binaryExp(uint8_t minPower)
 {
-    ast_node * left_node = mulExp();  // 原来是 unaryExp()
-    if (!left_node) return nullptr;
+    ast_node * left_node = unaryExp();
+    if (!left_node) {
+        return nullptr;
+    }
 
     for (;;) {
-        ast_operator_type op = addOp();
-        if (op == ast_operator_type::AST_OP_MAX) break;
 
-        ast_node * right_node = mulExp();  // 原来是 unaryExp()
-        if (!right_node) break;
+        uint8_t power = binaryPower();
+        if (power == 0 || power < minPower) {
+            break;
+        }
+
+        ast_operator_type op = binaryOps.op[lookaheadTag];
+
+        // 跳过运算符，右侧只结合绑定强度更大的运算符，因此是左结合
+        advance();
+
+        ast_node * right_node = binaryExp(power + 1);
+        if (!right_node) {
+            break;
+        }
 
         left_node = create_contain_node(op, left_node, right_node);
     }
@@ -310,13 +381,11 @@ static ast_node * addExp()
     return left_node;
 }
 
-
-
-/// @brief 表达式文法 expr : addExp, 表达式目前只支持加法与减法运算
+/// @brief 表达式文法 expr : binaryExp(1)，含算术、关系与逻辑运算
 /// @return AST的节点
 static ast_node * expr()
 {
-    return addExp();
+    return binaryExp(1);
 }
 
 /// @brief returnStatement -> T_RETURN expr T_SEMICOLON
@@ -414,15 +483,15 @@ static ast_node * statement()
 
         // 空语句，识别产生式statement: T_SEMICOLON
         advance();
-    } else if (F(T_ID) _(T_L_PAREN) _(T_DIGIT)) {
+    } else if (F(T_ID) _(T_L_PAREN) _(T_DIGIT) _(T_SUB) _(T_LNOT)) {
 
         // 赋值语句，statement -> assignExprStmt T_SEMICOLON
 
-        // assignExprStmt的FIRST集合为{T_ID, T_L_PAREN, T_DIGIT}
+        // assignExprStmt的FIRST集合为{T_ID, T_L_PAREN, T_DIGIT, T_SUB, T_LNOT}
 
         // 赋值语句以T_ID开头，并且左值要具有左值属性
         // 表达式语句可以以T_ID开头，也可以左小括号T_L_PAREN，甚至一元运算符等开头
-        // 目前文法下表达式语句在不支持一元运算符的情况下只能以T_ID或T_L_PAREN开头
+        // 表达式语句还可以取负或逻辑非等前缀运算符开头
         node = assignExprStmt();
 
         if (!match(T_SEMICOLON)) {
@@ -449,7 +518,8 @@ static void varDeclList(ast_node * vardeclstmt_node)
             // 定义列表中定义的变量
 
             // 新建变量声明节点并加入变量声明语句中
-            (void) add_var_decl_node(vardeclstmt_node, rd_lval.var_id);
+            var_id_attr id = currentId();
+            (void) add_var_decl_node(vardeclstmt_node, id);
 
             // 填过当前的Token，指向下一个Token
             advance();
@@ -482,8 +552,7 @@ static ast_node * varDecl()
 {
     if (F(T_INT)) {
 
-        // 这里必须复制，而不能引用，因为rd_lval为全局，下一个记号识别后要被覆盖
-        type_attr type = rd_lval.type;
+        type_attr type = currentType();
 
         // 跳过int类型的记号，指向下一个Token
         advance();
@@ -492,7 +561,8 @@ static ast_node * varDecl()
         if (F(T_ID)) {
 
             // 创建变量声明语句，并加入第一个变量
-            ast_node * stmt_node = create_var_decl_stmt_node(type, rd_lval.var_id);
+            var_id_attr id = currentId();
+            ast_node * stmt_node = create_var_decl_stmt_node(type, id);
 
             // 跳过标识符记号，指向下一个Token
             advance();
@@ -610,7 +680,6 @@ static ast_node * idtail(type_attr & type, var_id_attr & id)
             ast_node * formalParamsNode = nullptr;
 
             // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-            // create_func_def函数内会释放id中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
             return create_func_def(type, id, blockNode, formalParamsNode);
         } else {
             semerror("函数定义缺少右小括号");
@@ -657,7 +726,7 @@ static ast_node * compileUnit()
         // match匹配并LookAhead往前挪动
         if (F(T_INT)) {
 
-            type_attr type = rd_lval.type;
+            type_attr type = currentType();
 
             // 跳过当前的记号，指向下一个记号
             advance();
@@ -666,7 +735,7 @@ static ast_node * compileUnit()
             if (F(T_ID)) {
 
                 // 获取标识符的值和定位信息
-                var_id_attr id = rd_lval.var_id;
+                var_id_attr id = currentId();
 
                 // 跳过当前的记号，指向下一个记号
                 advance();
@@ -694,22 +763,59 @@ static ast_node * compileUnit()
     return cu_node;
 }
 
+///
+/// @brief 分析源文件的一个片段，片段由若干个完整的全局变量声明或函数定义组成
+/// @param buf 片段的首地址，要求同rd_scan
+/// @param size 片段的字节数
+/// @param firstLine 片段第一行的行号
+/// @param errors 输出词法与语法错误的个数
+/// @param complete 输出是否分析到了片段的结尾，遇到不能识别的记号时提前结束
+/// @param diagnostics 输出词法与语法错误信息，每条一行，不直接打印，由调用者按源文件的次序输出
+/// @return ast_node* 编译单元节点，孩子为片段中的声明与定义，有错误时也返回
+///
+ast_node * rd_parse_piece(const char * buf,
+                          size_t size,
+                          uint32_t firstLine,
+                          int & errors,
+                          bool & complete,
+                          std::string & diagnostics)
+{
+    // 整个片段一次性识别成记号数组，词法错误也计入错误数目
+    rd_source = buf;
+    rd_diagnostics = &diagnostics;
+    errno_num = rd_scan(buf, size, rd_tokens, diagnostics, firstLine);
+
+    // lookahead指向第一个Token
+    rd_pos = 0;
+    lookaheadTag = (RDTokenType) rd_tokens[rd_pos].kind;
+
+    ast_node * astRoot = compileUnit();
+
+    errors = errno_num;
+    complete = F(T_EOF);
+    rd_diagnostics = nullptr;
+
+    return astRoot;
+}
+
 ///
 /// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节
+/// @param size 源文件的字节数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse()
+ast_node * rd_parse(const char * buf, size_t size)
 {
-    // 没有错误信息
-    errno_num = 0;
+    int errors;
+    bool complete;
+    std::string diagnostics;
 
-    // lookahead指向第一个Token
-    advance();
+    ast_node * astRoot = rd_parse_piece(buf, size, 1, errors, complete, diagnostics);
 
-    ast_node * astRoot = compileUnit();
+    fputs(diagnostics.c_str(), stdout);
 
-    // 如果有错误信息，则返回-1，否则返回0
-    if (errno_num != 0) {
+    // 如果有错误信息，则返回空指针
+    if (errors != 0) {
         return nullptr;
     }
 
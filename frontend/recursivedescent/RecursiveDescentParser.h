@@ -2,8 +2,8 @@
 /// @file RecursiveDescentParser.h
 /// @brief 递归下降分析法实现的语法分析后产生抽象语法树的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,10 +12,18 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>基于记号数组进行分析
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>分析状态改为线程局部，支持分析源文件的片段
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>表达式改为按绑定强度表的算符优先分析，支持关系与逻辑运算
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>错误信息写入调用者的缓冲区，不再直接打印
 /// </table>
 ///
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 #include "AST.h"
 #include "AttrType.h"
 
@@ -39,28 +47,53 @@ enum RDTokenType {
     T_RETURN,
     T_ASSIGN,
 
+    T_IF,       // if关键字
+    T_ELSE,     // else关键字
+    T_WHILE,    // while关键字
+    T_BREAK,    // break关键字
+    T_CONTINUE, // continue关键字
+
     T_ADD,
     T_SUB,
     T_MUL,
     T_DIV,
     T_MOD,
-    T_NEG         // 负号（取负）
-};
+    T_NEG, // 负号（取负）
 
-/// @brief 词法与语法分析数据交互的Token的值类型
-union RDSType {
-    ast_node * node;
-    digit_int_attr integer_num; // 整型字面量
-    digit_real_attr float_num;  // 实数字面量
-    var_id_attr var_id;         // 标识符（变量名）
-    type_attr type;             // 类型
-};
+    T_LT,   // 小于 <
+    T_LE,   // 小于等于 <=
+    T_GT,   // 大于 >
+    T_GE,   // 大于等于 >=
+    T_EQ,   // 等于 ==
+    T_NE,   // 不等于 !=
+    T_LAND, // 逻辑与 &&
+    T_LOR,  // 逻辑或 ||
+    T_LNOT, // 逻辑非 !
 
-/// @brief 词法与语法分析数据交互的Token的值
-extern RDSType rd_lval;
+    T_KIND_COUNT // 记号类别的个数，不是记号
+};
 
 ///
 /// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @param buf 源缓冲区，buf[size]开始至少有RD_SCAN_PADDING个0字节
+/// @param size 源文件的字节数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse();
+ast_node * rd_parse(const char * buf, size_t size);
+
+///
+/// @brief 分析源文件的一个片段，片段由若干个完整的全局变量声明或函数定义组成，可在多个线程中同时调用
+/// @param buf 片段的首地址，要求同rd_scan
+/// @param size 片段的字节数
+/// @param firstLine 片段第一行的行号
+/// @param errors 输出词法与语法错误的个数
+/// @param complete 输出是否分析到了片段的结尾，遇到不能识别的记号时提前结束
+/// @param diagnostics 输出词法与语法错误信息，每条一行，不直接打印，由调用者按源文件的次序输出
+/// @return ast_node* 编译单元节点，孩子为片段中的声明与定义，有错误时也返回
+///
+ast_node * rd_parse_piece(const char * buf,
+                          size_t size,
+                          uint32_t firstLine,
+                          int & errors,
+                          bool & complete,
+                          std::string & diagnostics);
@@ -0,0 +1,82 @@
+///
+/// @file BasicBlock.cpp
+/// @brief 基本块与控制流图
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+
+#include "BasicBlock.h"
+#include "LabelInstruction.h"
+
+/// @brief 构造函数
+/// @param _func 所属函数
+/// @param _index 函数内基本块的编号
+BasicBlock::BasicBlock(Function * _func, int32_t _index) : func(_func), index(_index)
+{}
+
+/// @brief 获取基本块开头的Label指令
+/// @return LabelInstruction* Label指令，不以Label开头的基本块为空
+LabelInstruction * BasicBlock::getLabel() const
+{
+    if (insts.empty()) {
+        return nullptr;
+    }
+
+    return dyn_cast<LabelInstruction>(*insts.begin());
+}
+
+/// @brief 获取基本块末尾的跳转或出口指令
+/// @return Instruction* 跳转或出口指令，顺序执行到下一个基本块时为空
+Instruction * BasicBlock::getTerminator() const
+{
+    Instruction * last = insts.getLastInst();
+    return (last && isTerminator(last)) ? last : nullptr;
+}
+
+/// @brief 增加一条到后继基本块的边，同时登记本基本块为其前驱，重复的边忽略
+/// @param succ 后继基本块
+void BasicBlock::addSuccessor(BasicBlock * succ)
+{
+    // 后继最多两个，线性查找即可
+    if (std::find(succs.begin(), succs.end(), succ) != succs.end()) {
+        return;
+    }
+
+    succs.push_back(succ);
+    succ->preds.push_back(this);
+}
+
+/// @brief 删除被标记的前驱基本块，删除不可达基本块时使用
+/// @param removed 以基本块编号为下标的删除标记
+void BasicBlock::erasePredecessors(const std::vector<bool> & removed)
+{
+    preds.erase(std::remove_if(preds.begin(),
+                               preds.end(),
+                               [&removed](BasicBlock * pred) { return removed[pred->getIndex()]; }),
+                preds.end());
+}
+
+/// @brief 判断指令是否是基本块的结束指令，即跳转或出口指令
+/// @param inst 指令
+/// @return true 是 false 不是
+bool BasicBlock::isTerminator(const Instruction * inst)
+{
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_GOTO:
+        case IRInstOperator::IRINST_OP_BRANCH_COND:
+        case IRInstOperator::IRINST_OP_EXIT:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,122 @@
+///
+/// @file BasicBlock.h
+/// @brief 基本块与控制流图
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 基本块由Function::buildCFG从线性IR按Label指令和跳转、出口指令划分，
+/// 指令从函数的指令序列移入各基本块；Function::flattenCFG按基本块的排列次序
+/// 拼接回线性IR，供现有的后端使用。
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IRCode.h"
+
+class Function;
+class LabelInstruction;
+
+///
+/// @brief 基本块，含有前驱与后继列表
+///
+class BasicBlock {
+
+public:
+    /// @brief 构造函数
+    /// @param _func 所属函数
+    /// @param _index 函数内基本块的编号
+    BasicBlock(Function * _func, int32_t _index);
+
+    BasicBlock(const BasicBlock &) = delete;
+    BasicBlock & operator=(const BasicBlock &) = delete;
+
+    /// @brief 获取所属函数
+    /// @return Function* 函数
+    [[nodiscard]] Function * getParent() const
+    {
+        return func;
+    }
+
+    /// @brief 获取函数内基本块的编号，从0开始连续，可作为分析用向量与位图的下标
+    /// @return int32_t 编号
+    [[nodiscard]] int32_t getIndex() const
+    {
+        return index;
+    }
+
+    /// @brief 设置函数内基本块的编号，删除基本块后重新编号时使用
+    /// @param _index 编号
+    void setIndex(int32_t _index)
+    {
+        index = _index;
+    }
+
+    /// @brief 获取基本块的指令序列
+    /// @return InterCode& 指令序列
+    InterCode & getInterCode()
+    {
+        return insts;
+    }
+
+    /// @brief 获取基本块开头的Label指令
+    /// @return LabelInstruction* Label指令，不以Label开头的基本块为空
+    [[nodiscard]] LabelInstruction * getLabel() const;
+
+    /// @brief 获取基本块末尾的跳转或出口指令
+    /// @return Instruction* 跳转或出口指令，顺序执行到下一个基本块时为空
+    [[nodiscard]] Instruction * getTerminator() const;
+
+    /// @brief 获取前驱基本块
+    /// @return const std::vector<BasicBlock *>& 前驱基本块
+    [[nodiscard]] const std::vector<BasicBlock *> & getPredecessors() const
+    {
+        return preds;
+    }
+
+    /// @brief 获取后继基本块
+    /// @return const std::vector<BasicBlock *>& 后继基本块
+    [[nodiscard]] const std::vector<BasicBlock *> & getSuccessors() const
+    {
+        return succs;
+    }
+
+    /// @brief 增加一条到后继基本块的边，同时登记本基本块为其前驱，重复的边忽略
+    /// @param succ 后继基本块
+    void addSuccessor(BasicBlock * succ);
+
+    /// @brief 删除被标记的前驱基本块，删除不可达基本块时使用
+    /// @param removed 以基本块编号为下标的删除标记
+    void erasePredecessors(const std::vector<bool> & removed);
+
+    /// @brief 判断指令是否是基本块的结束指令，即跳转或出口指令
+    /// @param inst 指令
+    /// @return true 是 false 不是
+    static bool isTerminator(const Instruction * inst);
+
+private:
+    /// @brief 所属函数
+    Function * func;
+
+    /// @brief 函数内基本块的编号
+    int32_t index;
+
+    /// @brief 基本块的指令序列
+    InterCode insts;
+
+    /// @brief 前驱基本块
+    std::vector<BasicBlock *> preds;
+
+    /// @brief 后继基本块
+    std::vector<BasicBlock *> succs;
+};
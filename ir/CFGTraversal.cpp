@@ -0,0 +1,62 @@
+///
+/// @file CFGTraversal.cpp
+/// @brief 控制流图的后序与逆后序遍历
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstddef>
+#include <utility>
+
+#include "BasicBlock.h"
+#include "CFGTraversal.h"
+#include "Function.h"
+
+/// @brief 构造函数，计算函数控制流图的后序
+/// @param func 已建立控制流图的函数
+PostOrderTraversal::PostOrderTraversal(Function * func)
+{
+    BasicBlock * entry = func->getEntryBlock();
+    if (!entry) {
+        return;
+    }
+
+    const std::vector<BasicBlock *> & blocks = func->getBasicBlocks();
+    order.reserve(blocks.size());
+
+    // 以基本块编号为下标的访问标记
+    std::vector<bool> visited(blocks.size(), false);
+
+    // 显式栈代替递归，避免基本块很多时栈溢出。每项记录基本块与下一个要访问的后继的位置
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    stack.reserve(blocks.size());
+
+    visited[entry->getIndex()] = true;
+    stack.emplace_back(entry, 0);
+
+    while (!stack.empty()) {
+
+        auto & [bb, next] = stack.back();
+        const std::vector<BasicBlock *> & succs = bb->getSuccessors();
+
+        if (next < succs.size()) {
+            BasicBlock * succ = succs[next++];
+            if (!visited[succ->getIndex()]) {
+                visited[succ->getIndex()] = true;
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            // 所有后继都已访问，基本块出栈时加入后序
+            order.push_back(bb);
+            stack.pop_back();
+        }
+    }
+}
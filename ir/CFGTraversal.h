@@ -0,0 +1,89 @@
+///
+/// @file CFGTraversal.h
+/// @brief 控制流图的后序与逆后序遍历
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 从入口基本块出发深度优先遍历，只含入口可达的基本块。用法如下：
+///
+///     for (BasicBlock * bb: ReversePostOrderTraversal(func)) { ... }
+///
+/// 前向数据流分析按逆后序迭代，后向数据流分析按后序迭代，收敛所需的轮数最少。
+///
+#pragma once
+
+#include <vector>
+
+class Function;
+class BasicBlock;
+
+///
+/// @brief 后序遍历，构造时计算出次序，之后可多次遍历
+///
+class PostOrderTraversal {
+
+public:
+    using iterator = std::vector<BasicBlock *>::const_iterator;
+
+    /// @brief 构造函数，计算函数控制流图的后序
+    /// @param func 已建立控制流图的函数
+    explicit PostOrderTraversal(Function * func);
+
+    [[nodiscard]] iterator begin() const
+    {
+        return order.begin();
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return order.end();
+    }
+
+    /// @brief 获取后序序列
+    /// @return const std::vector<BasicBlock *>& 后序序列
+    [[nodiscard]] const std::vector<BasicBlock *> & getOrder() const
+    {
+        return order;
+    }
+
+private:
+    /// @brief 后序序列
+    std::vector<BasicBlock *> order;
+};
+
+///
+/// @brief 逆后序遍历，即后序的逆序，除回边外每个基本块都在其前驱之后访问
+///
+class ReversePostOrderTraversal {
+
+public:
+    using iterator = std::vector<BasicBlock *>::const_reverse_iterator;
+
+    /// @brief 构造函数，计算函数控制流图的后序
+    /// @param func 已建立控制流图的函数
+    explicit ReversePostOrderTraversal(Function * func) : postOrder(func)
+    {}
+
+    [[nodiscard]] iterator begin() const
+    {
+        return postOrder.getOrder().rbegin();
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return postOrder.getOrder().rend();
+    }
+
+private:
+    /// @brief 后序遍历
+    PostOrderTraversal postOrder;
+};
@@ -3,8 +3,8 @@
 /// @brief 常量类
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
 /// </table>
 ///
 #pragma once
@@ -38,7 +39,15 @@ protected:
     ///
     /// @brief 构造函数
     /// @param _type  类型
+    /// @param _kind  种类
     ///
-    Constant(Type * _type) : User(_type)
+    Constant(Type * _type, ValueKind _kind) : User(_type, _kind)
     {}
+
+public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是常量
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::ConstInt;
+    }
 };
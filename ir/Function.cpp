@@ -2,8 +2,8 @@
 /// @file Function.cpp
 /// @brief 函数实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,22 +11,30 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>函数内Value的稠密编号，局部变量不再在IR中分配栈空间，addTempVar按编号去重
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>增加基本块与控制流图的建立、拼接回线性IR以及删除不可达基本块
 /// </table>
 ///
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 
 #include "IRConstant.h"
 #include "Function.h"
-#include "PlatformArm32.h"
 #include "Common.h"
+#include "CFGTraversal.h"
+#include "GotoInstruction.h"
+#include "BranchConditionalInstruction.h"
 /// @brief 指定函数名字、函数类型的构造函数
 /// @param _name 函数名称
 /// @param _type 函数类型
 /// @param _builtin 是否是内置函数
 Function::Function(std::string _name, FunctionType * _type, bool _builtin)
-    : GlobalValue(_type, _name), builtIn(_builtin),currentNegativeStackOffsetSize_(0)
+    : GlobalValue(_type, _name, ValueKind::Function), builtIn(_builtin)
 {
     returnType = _type->getReturnType();
 
@@ -71,87 +79,86 @@ bool Function::isBuiltin()
     return builtIn;
 }
 
-/// @brief 函数指令信息输出
-/// @param str 函数指令
-
-// 修改 toString 的定义
-std::string Function::toString() const { // <--- 添加 const，修改返回类型，移除参数
-    std::string func_ir_str; // 用于构建结果
-
+/// @brief 函数指令信息输出，追加到str的尾部
+/// @param str 输出缓冲区，可在多个函数间重复使用
+void Function::toString(std::string & str) const
+{
     if (builtIn) {
-        // 对于内置函数，通常只输出一个声明（如果需要的话），而不是完整的定义
-        // 或者根据你的 IR 规范，可能什么都不输出，或者输出 "declare ..."
-        // 例如: func_ir_str = "declare " + getReturnType()->toString() + " @" + getName() + "(";
-        // (参数列表也需要正确格式化)
-        // func_ir_str += ");\n";
-        return func_ir_str; // 暂时返回空字符串，你需要确定内置函数的正确 IR 表示
+        // 内置函数不输出
+        return;
     }
 
     // 输出函数头 "define <return_type> @<func_name>(<param_list>)"
-    // 确保 getReturnType(), getName(), param->getType(), param->getIRName() 都是 const 方法
-    func_ir_str = "define " + getReturnType()->toString() + " @" + getName() + "(";
+    str += "define ";
+    str += getReturnType()->toString();
+    str += " @";
+    str += getName();
+    str += "(";
 
     bool firstParam = true;
-    for (const auto & param : params) { // 使用 const auto&
+    for (const auto & param : params) {
         if (!firstParam) {
-            func_ir_str += ", ";
+            str += ", ";
         }
-        if (param && param->getType()) { // 添加空指针检查
-            func_ir_str += param->getType()->toString() + " " + param->getIRName();
+        if (param && param->getType()) {
+            str += param->getType()->toString();
+            str += " ";
+            str += param->getIRName();
         } else {
-            func_ir_str += "<invalid_param>";
+            str += "<invalid_param>";
         }
         firstParam = false;
     }
-    func_ir_str += "){\n"; // 添加函数体开始的 '{'
-
-    // --- 局部变量声明 ---
-    // 确保 var->getType()->toString(), var->getIRName(), var->getName(), var->getScopeLevel() 是 const
-    if (!varsVector.empty()) {
-        for (const auto & var : varsVector) { // 使用 const auto&
-            if (var && var->getType()) { // 添加空指针检查
-                func_ir_str += "\tdeclare " + var->getType()->toString() + " " + var->getIRName();
-                std::string realName = var->getName();
-                if (!realName.empty()) {
-                    func_ir_str += " ; " + std::to_string(var->getScopeLevel()) + ":" + realName;
-                }
-                func_ir_str += "\n";
+    str += "){\n";
+
+    // 局部变量声明
+    for (const auto & var : varsVector) {
+        if (var && var->getType()) {
+            str += "\tdeclare ";
+            str += var->getType()->toString();
+            str += " ";
+            str += var->getIRName();
+            const std::string & realName = var->getName();
+            if (!realName.empty()) {
+                str += " ; ";
+                str += std::to_string(var->getScopeLevel());
+                str += ":";
+                str += realName;
             }
+            str += "\n";
         }
-        
     }
 
-    if (!this->tempVars.empty()) { // 检查 tempVars 是否为空
-        for (const auto& temp_val_ptr : this->tempVars) { // 遍历 tempVars 向量
-            if (temp_val_ptr && temp_val_ptr->getType() && !temp_val_ptr->getIRName().empty()) { // 确保 Value 有效、有类型、有IR名
-                // 调试打印 (可选):
-                // std::cout << "toString declaring temp: " << temp_val_ptr->getIRName()
-                //           << " of type: " << temp_val_ptr->getType()->toString() << std::endl;
-
-                func_ir_str += "\tdeclare " + temp_val_ptr->getType()->toString() + " " + temp_val_ptr->getIRName() + "\n";
+    // 临时变量声明
+    if (!tempVars.empty()) {
+        for (const auto & temp_val_ptr : tempVars) {
+            if (temp_val_ptr && temp_val_ptr->getType() && (temp_val_ptr->getIRSlot() >= 0)) {
+                str += "\tdeclare ";
+                str += temp_val_ptr->getType()->toString();
+                str += " ";
+                str += temp_val_ptr->getIRName();
+                str += "\n";
             }
         }
-        func_ir_str += "\n"; // 在所有临时变量声明之后加一个换行
+        str += "\n";
     }
 
-    // --- 指令列表 ---
-    // 确保 inst->toString() 和 inst->getOp() 是 const
-    for (const auto & inst : code.getInsts()) { // 使用 const auto&
-        if (inst) { // 添加空指针检查
+    // 指令列表，Label指令不缩进
+    for (const auto & inst : code) {
+        if (inst) {
             std::string current_inst_str = inst->toString();
             if (!current_inst_str.empty()) {
-                if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
-                    func_ir_str += current_inst_str + "\n";
-                } else {
-                    func_ir_str += "\t" + current_inst_str + "\n";
+                if (inst->getOp() != IRInstOperator::IRINST_OP_LABEL) {
+                    str += "\t";
                 }
+                str += current_inst_str;
+                str += "\n";
             }
         }
     }
 
     // 输出函数尾部
-    func_ir_str += "}\n\n"; // 添加函数体结束的 '}' 和一个空行
-    return func_ir_str;    // 返回构建好的字符串
+    str += "}\n\n";
 }
 
 /// @brief 设置函数出口指令
@@ -256,89 +263,33 @@ LocalVariable *Function::newLocalVarValue(Type *type, std::string name, int32_t
     // 1. 创建 LocalVariable 对象
     //    你需要根据你的 LocalVariable.h 决定如何创建。
     //    假设 LocalVariable 构造函数是 public 或者 Function 是 friend:
-    LocalVariable *localVar = new LocalVariable(type, name, scope_level);
-    
-    if (!localVar) { // 理论上 new 不会返回 nullptr 除非 std::nothrow，但以防万一
-        minic_log(LOG_ERROR, "Function '%s': Failed to allocate LocalVariable for name '%s'.",
-                  this->getName().c_str(), name.c_str());
-        return nullptr;
-    }
-
-    // 确保 IRName 被设置 (如果 name 为空，LocalVariable 构造函数或 Value 基类应处理)
-    if (name.empty() && localVar->getIRName().find("UNNAMED_VALUE") != std::string::npos) {
-        // 如果需要，可以给一个更特定的临时局部变量名，但这通常由 Value 基类处理
-    } else if (!name.empty() && (localVar->getIRName().empty() || localVar->getIRName().find("UNNAMED_VALUE") != std::string::npos) ) {
-        localVar->setIRName(name + "_lv"); // 例如 %a_lv
-    }
+    LocalVariable *localVar = arena.create<LocalVariable>(type, name, scope_level);
 
+    // IR名字的编号在输出IR前由renameIR分配，这里不命名
 
-    // 2. 计算大小和对齐
-    int32_t var_size = type->getSize();
-    if (var_size <= 0) {
-         minic_log(LOG_WARNING, "Function '%s': LocalVariable '%s' (type: %s) has size %d. Defaulting to 4 bytes for offset calculation.",
-                   this->getName().c_str(), name.c_str(), type->toString().c_str(), var_size);
-         var_size = 4; // 至少分配一个字，避免0或负大小
-    }
-    int32_t aligned_size = (var_size + 3) & ~3; // 4字节对齐
-
-    // 3. 更新 currentNegativeStackOffsetSize_ (存储已分配的局部变量总大小的绝对值)
-    this->currentNegativeStackOffsetSize_ += aligned_size;
-
-    // 4. 计算新局部变量的栈偏移 (相对于 FP 的负偏移)
-    int32_t new_offset_for_var = -this->currentNegativeStackOffsetSize_;
+    // 2. 函数内稠密编号，栈内空间由后端按编号分配
+    numberValue(localVar);
 
-    // 5. 为 LocalVariable 设置内存地址
-    localVar->setMemoryAddr(ARM32_FP_REG_NO, new_offset_for_var);
-    
-    // 6. 将新创建的局部变量添加到函数的变量列表中
+    // 3. 将新创建的局部变量添加到函数的变量列表中
     varsVector.push_back(localVar);
 
-    // --- 日志 ---
-    int32_t check_base; 
-    int64_t check_off;
-    bool has_addr = localVar->getMemoryAddr(&check_base, &check_off); // 调用 getMemoryAddr 验证
-
-    minic_log(LOG_DEBUG, "Function '%s'::newLocalVarValue: Created LocalVar '%s' (IR: '%s', Ptr: %p). "
-                         "Type: %s, Size: %d (Aligned: %d). "
-                         "CumulativeNegOffsetSize: %d. Assigned Offset: %d. "
-                         "Verification -> HasAddr: %s, BaseRead: %d, OffsetRead: %lld",
+    minic_log(LOG_DEBUG, "Function '%s'::newLocalVarValue: Created LocalVar '%s' (IR: '%s', Ptr: %p, Index: %d). Type: %s",
               this->getName().c_str(),
               name.c_str(), localVar->getIRName().c_str(), static_cast<void*>(localVar),
-              type->toString().c_str(), var_size, aligned_size,
-              this->currentNegativeStackOffsetSize_, new_offset_for_var,
-              has_addr ? "true" : "false", check_base, static_cast<long long>(check_off));
-    // --- 结束日志 ---
-    
-    // 更新函数的总栈帧深度 (maxDepth 通常用于 CodeGeneratorArm32::allocStack)
-    // 注意：这里的 maxDepth 与 CodeGeneratorArm32::stackAlloc 中的 setMaxDep(sp_esp)
-    //       的 sp_esp 含义可能不同。
-    //       这里的 currentNegativeStackOffsetSize_ 只包含局部变量。
-    //       而 CodeGeneratorArm32::stackAlloc 中的 sp_esp 最终会包含局部变量+临时变量+调用参数空间。
-    //       通常，Function::maxDepth 由 CodeGeneratorArm32::stackAlloc 在最后设置。
-    //       所以，这里可能不需要直接更新 this->maxDepth，除非你有特定逻辑。
-    //       如果 newLocalVarValue 是早期分配，而 stackAlloc 是后期，那么 stackAlloc
-    //       会使用 getCurrentFuncFrameSizeNegative() 作为起点。
+              localVar->getValueIndex(), type->toString().c_str());
 
     return localVar;
 }
 
 
-// --- 实现新增的 getCurrentFuncFrameSizeNegative ---
-[[nodiscard]] int32_t Function::getCurrentFuncFrameSizeNegative() const {
-    minic_log(LOG_DEBUG, "Function '%s': getCurrentFuncFrameSizeNegative() returning %d (abs size of local vars stack)",
-              this->getName().c_str(), this->currentNegativeStackOffsetSize_);
-    return this->currentNegativeStackOffsetSize_;
-}
-// --- 结束实现 ---
-
-
 /// @brief 新建一个内存型的Value，并加入到符号表，用于后续释放空间
 /// \param type 变量类型
 /// \return 临时变量Value
 MemVariable * Function::newMemVariable(Type * type)
 {
     // 肯定唯一存在，直接插入即可
-    MemVariable * memValue = new MemVariable(type);
+    MemVariable * memValue = arena.create<MemVariable>(type);
+    numberValue(memValue);
 
     memVector.push_back(memValue);
 
@@ -348,15 +299,18 @@ MemVariable * Function::newMemVariable(Type * type)
 /// @brief 清理函数内申请的资源
 void Function::Delete()
 {
-    // 清理IR指令
-    code.Delete();
-
-    // 清理Value
-    for (auto & var: varsVector) {
-        delete var;
-    }
-
+    // 指令、Use与变量都在内存池中，一起释放，不再逐条指令清理
+    code.clear();
+    blocks.clear();
     varsVector.clear();
+    memVector.clear();
+    tempVars.clear();
+    tempVarMarks.clear();
+    exitLabel = nullptr;
+    returnValue = nullptr;
+    valueCount = 0;
+
+    arena.reset();
 }
 
 ///
@@ -369,36 +323,190 @@ void Function::renameIR()
         return;
     }
 
-    int32_t nameIndex = 0; // 本函数内统一的命名计数器
+    // 形参、局部变量与临时变量共用一个计数器，只分配编号，名字在输出时按编号生成
+    int32_t nameIndex = 0;
 
-    // 1. 重命名形式参数
+    // 1. 形式参数
     for (auto & param : this->params) {
-        param->setIRName(IR_TEMP_VARNAME_PREFIX + std::to_string(nameIndex++));
+        param->setIRSlot(nameIndex++);
     }
 
-    // 2. 重命名局部变量 (varsVector)
+    // 2. 局部变量
     for (auto & var : this->varsVector) {
-        var->setIRName(IR_LOCAL_VARNAME_PREFIX + std::to_string(nameIndex++));
+        var->setIRSlot(nameIndex++);
     }
 
-    // 3. 重命名临时变量 (tempVars) - 这是关键新增部分
+    // 3. 临时变量，含有结果的指令
     for (auto & temp_val : this->tempVars) {
-        temp_val->setIRName(IR_TEMP_VARNAME_PREFIX + std::to_string(nameIndex++));
+        temp_val->setIRSlot(nameIndex++);
+    }
+
+    // 标签在创建时已有模块内唯一的编号，不需要重命名
+}
+
+///
+/// @brief 按Label指令和跳转、出口指令把线性IR划分为基本块，建立控制流图
+/// @return true 成功 false 跳转目标不在本函数内，函数恢复为线性IR
+///
+bool Function::buildCFG()
+{
+    if (!blocks.empty()) {
+        flattenCFG();
+    }
+
+    // 以Label指令的稠密编号为下标查找所在的基本块，每条指令只访问常数次，总体是线性时间
+    std::vector<BasicBlock *> labelBlocks(valueCount, nullptr);
+
+    // 1. 划分基本块：Label指令开始新的基本块，跳转与出口指令结束当前基本块
+    BasicBlock * current = nullptr;
+    while (!code.empty()) {
+
+        Instruction * inst = *code.begin();
+        code.remove(inst);
+
+        bool isLabel = inst->getOp() == IRInstOperator::IRINST_OP_LABEL;
+        if (isLabel || !current) {
+            current = arena.create<BasicBlock>(this, (int32_t) blocks.size());
+            blocks.push_back(current);
+        }
+
+        if (isLabel) {
+            labelBlocks[inst->getValueIndex()] = current;
+        }
+
+        current->getInterCode().addInst(inst);
+
+        if (BasicBlock::isTerminator(inst)) {
+            current = nullptr;
+        }
+    }
+
+    // 2. 按基本块最后的指令建立边，没有跳转与出口指令的顺序执行到下一个基本块
+    auto targetBlock = [&labelBlocks](LabelInstruction * label) -> BasicBlock * {
+        int32_t index = label ? label->getValueIndex() : -1;
+        return ((index >= 0) && ((size_t) index < labelBlocks.size())) ? labelBlocks[index] : nullptr;
+    };
+
+    for (size_t k = 0; k < blocks.size(); ++k) {
+
+        BasicBlock * bb = blocks[k];
+        Instruction * term = bb->getTerminator();
+
+        if (!term) {
+            if (k + 1 < blocks.size()) {
+                bb->addSuccessor(blocks[k + 1]);
+            }
+            continue;
+        }
+
+        // 出口指令没有后继
+        LabelInstruction * targets[2];
+        int32_t targetCount = 0;
+        if (auto * gotoInst = dyn_cast<GotoInstruction>(term)) {
+            targets[targetCount++] = gotoInst->getTarget();
+        } else if (auto * bcInst = dyn_cast<BranchConditionalInstruction>(term)) {
+            targets[targetCount++] = bcInst->getTrueTarget();
+            targets[targetCount++] = bcInst->getFalseTarget();
+        }
+
+        for (int32_t t = 0; t < targetCount; ++t) {
+            BasicBlock * succ = targetBlock(targets[t]);
+            if (!succ) {
+                minic_log(LOG_ERROR, "Function '%s': jump target is not a label in this function", getName().c_str());
+                flattenCFG();
+                return false;
+            }
+            bb->addSuccessor(succ);
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 按基本块的排列次序拼接回线性IR，删除控制流图
+///
+void Function::flattenCFG()
+{
+    // 基本块的指令序列整体拼接，不逐条复制；基本块对象随函数的内存池释放
+    for (auto * bb: blocks) {
+        code.addInst(bb->getInterCode());
+    }
+
+    blocks.clear();
+}
+
+///
+/// @brief 删除入口不可达的基本块，出口Label所在的基本块总是保留
+/// @return int32_t 删除的基本块个数
+///
+int32_t Function::removeUnreachableBlocks()
+{
+    std::vector<bool> removed(blocks.size(), true);
+    for (BasicBlock * bb: PostOrderTraversal(this)) {
+        removed[bb->getIndex()] = false;
     }
 
-    // 4. 重命名标签 (如果需要，你的是在创建时命名，通常可以)
-    for (auto inst : this->getInterCode().getInsts()) {
-        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
-            // 你的注释说标签名在 newLabel() 中创建时即最终确定，这很好。
+    // 后端依赖出口指令产生函数的返回，即使死循环使出口不可达也保留
+    for (auto * bb: blocks) {
+        if (exitLabel && (bb->getLabel() == exitLabel)) {
+            removed[bb->getIndex()] = false;
         }
-        // 注意：不再需要在这里通过遍历指令去命名指令结果为临时变量。
-        // 因为所有临时变量（包括指令结果）都应该通过 Module::newTemporary 创建，
-        // 加入到 tempVars，并在上面的第3步被统一命名。
-        // 原来的 else if (inst->hasResultValue()) ... inst->setIRName(...) 部分可以考虑移除或修改，
-        // 确保它不会与第3步的命名冲突，或者只处理那些不由 newTemporary 管理的特殊结果值（如果有的话）。
-        // 最安全的是，如果一个指令的结果是一个 Value*，那个 Value* 应该就是 tempVars 中的一员，
-        // 其名字已在第3步被设置。
     }
+
+    // 删除的指令按稠密编号标记，之后从临时变量中去除
+    std::vector<bool> deadInsts(valueCount, false);
+    bool hasDeadTemp = false;
+
+    std::vector<BasicBlock *> kept;
+    kept.reserve(blocks.size());
+
+    for (auto * bb: blocks) {
+
+        if (!removed[bb->getIndex()]) {
+            kept.push_back(bb);
+            continue;
+        }
+
+        InterCode & insts = bb->getInterCode();
+        for (auto pIter = insts.begin(); pIter != insts.end();) {
+            Instruction * inst = *pIter;
+            deadInsts[inst->getValueIndex()] = true;
+            hasDeadTemp = hasDeadTemp || ((size_t) inst->getValueIndex() < tempVarMarks.size() &&
+                                          tempVarMarks[inst->getValueIndex()]);
+            pIter = insts.erase(pIter);
+        }
+    }
+
+    int32_t removedCount = (int32_t) (blocks.size() - kept.size());
+    if (removedCount == 0) {
+        return 0;
+    }
+
+    // 保留的基本块去掉被删除的前驱，之后重新连续编号
+    for (auto * bb: kept) {
+        bb->erasePredecessors(removed);
+    }
+    for (size_t k = 0; k < kept.size(); ++k) {
+        kept[k]->setIndex((int32_t) k);
+    }
+    blocks.swap(kept);
+
+    if (hasDeadTemp) {
+        tempVars.erase(std::remove_if(tempVars.begin(),
+                                      tempVars.end(),
+                                      [this, &deadInsts](Value * val) {
+                                          int32_t index = val->getValueIndex();
+                                          if ((size_t) index < deadInsts.size() && deadInsts[index]) {
+                                              tempVarMarks[index] = false;
+                                              return true;
+                                          }
+                                          return false;
+                                      }),
+                       tempVars.end());
+    }
+
+    return removedCount;
 }
 
 ///
@@ -426,36 +534,29 @@ void Function::renameIR()
 		this->realArgCount = 0;
     }
     
-	void Function::addTempVar(Value* val)
+/// @brief 登记函数内的临时变量，重复登记的忽略
+/// @param val 临时变量
+void Function::addTempVar(Value * val)
 {
-    // 检查传入的指针是否有效，避免向 vector 中添加空指针
-    if (val != nullptr) {
-        // 可选：防止重复添加同一个临时变量
-        // 如果你确定在调用 addTempVar 之前不会有重复添加的情况，可以省略这个检查以提高一点点性能。
-        // 但为了健壮性，加上检查通常是好的。
-        bool already_exists = false;
-        for (const auto& existing_temp_var : tempVars) {
-            if (existing_temp_var == val) {
-                already_exists = true;
-                break;
-            }
-        }
+    if (val == nullptr) {
+        return;
+    }
 
-        if (!already_exists) {
-            tempVars.push_back(val);
-        }
-        // 如果不需要去重，可以直接写：
-        // tempVars.push_back(val);
+    int32_t index = val->getValueIndex();
+    if (index < 0) {
+        // 没有编号的Value不属于本函数，不登记
+        minic_log(LOG_WARNING, "Function '%s': temp value '%s' has no value index",
+                  getName().c_str(), val->getIRName().c_str());
+        return;
+    }
+
+    // 按稠密编号标记是否已登记，代替在tempVars中的线性查找
+    if ((size_t) index >= tempVarMarks.size()) {
+        tempVarMarks.resize(std::max((size_t) index + 1, tempVarMarks.size() * 2));
     }
-    // else {
-        // 可选：如果 val 为 nullptr，可以记录一个警告或错误
-        // minic_log(LOG_WARNING, "Attempted to add a null Value as a temporary variable to function %s", getName().c_str());
-    // }
-}
 
-std::string Function::newTempName() {
-    // 假设 IR_TEMP_VARNAME_PREFIX 是在某处定义的宏或常量，例如 "%t"
-    // 如果没有定义，你需要定义它，例如：
-    // const std::string IR_TEMP_VARNAME_PREFIX = "%t"; (或者在 Common.h)
-    return IR_TEMP_VARNAME_PREFIX + std::to_string(tempNameCounter_++);
-}
\ No newline at end of file
+    if (!tempVarMarks[index]) {
+        tempVarMarks[index] = true;
+        tempVars.push_back(val);
+    }
+}
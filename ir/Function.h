@@ -2,8 +2,8 @@
 /// @file Function.cpp
 /// @brief 函数头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,11 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>函数内Value的稠密编号，局部变量不再在IR中分配栈空间，addTempVar按编号去重
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>增加基本块与控制流图的建立、拼接回线性IR以及删除不可达基本块
 /// </table>
 ///
 #pragma once
@@ -24,6 +29,8 @@
 #include "LocalVariable.h"
 #include "MemVariable.h"
 #include "IRCode.h"
+#include "BasicBlock.h"
+#include "Arena.h"
 #include <cstdint> // For int32_t
 ///
 /// @brief 描述函数信息的类，是全局静态存储，其Value的类型为FunctionType
@@ -43,6 +50,12 @@ public:
     /// @brief 注意：IR指令代码并未释放，需要手动释放
     ~Function() override;
 
+    /// @brief 用于isa/cast/dyn_cast，判断是否是函数
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::Function;
+    }
+
     /// @brief 获取函数返回类型
     /// @return 返回类型
     [[nodiscard]] Type* getReturnType() const;
@@ -55,13 +68,34 @@ public:
     /// @return IR指令代码
     InterCode & getInterCode();
 
+    /// @brief 获取函数的内存池，函数内的指令、Use、局部变量与临时变量都从中分配
+    /// @return 内存池
+    Arena & getArena()
+    {
+        return arena;
+    }
+
+    /// @brief 为函数内的Value分配稠密编号，编号从0开始连续
+    /// @param val 函数内新建的指令、局部变量、形参等
+    void numberValue(Value * val)
+    {
+        val->setValueIndex(valueCount++);
+    }
+
+    /// @brief 获取已分配的编号个数，可作为按编号索引的向量或位图的大小
+    /// @return 编号个数
+    [[nodiscard]] int32_t getValueCount() const
+    {
+        return valueCount;
+    }
+
     /// @brief 判断该函数是否是内置函数
     /// @return true: 内置函数，false：用户自定义
     bool isBuiltin();
 
-    /// @brief 函数指令信息输出
-    /// @param str 函数指令
-    [[nodiscard]] std::string toString() const; 
+    /// @brief 函数指令信息输出，追加到str的尾部
+    /// @param str 输出缓冲区，可在多个函数间重复使用
+    void toString(std::string & str) const;
 
     /// @brief 设置函数出口指令
     /// @param inst 出口Label指令
@@ -141,9 +175,6 @@ public:
     /// @param existInit 缺省为true。若真，则已存在需要进行初始化，否则什么都不做
     LocalVariable * newLocalVarValue(Type * type, std::string name = "", int32_t scope_level = 1);
 
-    // --- 新增的公有方法 ---
-    [[nodiscard]] int32_t getCurrentFuncFrameSizeNegative() const;
-
     /// @brief 新建一个内存型的Value，并加入到符号表，用于后续释放空间
     /// \param type 变量类型
     /// \return 临时变量Value
@@ -153,10 +184,49 @@ public:
     void Delete();
 
     ///
-    /// @brief 函数内的Value重命名，用于IR指令的输出
+    /// @brief 函数内的Value分配IR名字的编号，用于IR指令的输出
     ///
     void renameIR();
 
+    ///
+    /// @brief 按Label指令和跳转、出口指令把线性IR划分为基本块，建立控制流图
+    ///
+    /// 指令从函数的指令序列移入各基本块，建立后getInterCode()为空，
+    /// 需要线性IR时调用flattenCFG()。基本块按在线性IR中的次序排列，第一个是入口基本块。
+    ///
+    /// @return true 成功 false 跳转目标不在本函数内，函数恢复为线性IR
+    ///
+    bool buildCFG();
+
+    ///
+    /// @brief 按基本块的排列次序拼接回线性IR，删除控制流图
+    ///
+    void flattenCFG();
+
+    ///
+    /// @brief 删除入口不可达的基本块，出口Label所在的基本块总是保留
+    /// @return int32_t 删除的基本块个数
+    ///
+    int32_t removeUnreachableBlocks();
+
+    ///
+    /// @brief 获取基本块，按在线性IR中的次序排列，没有建立控制流图时为空
+    /// @return const std::vector<BasicBlock *>& 基本块
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getBasicBlocks() const
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取入口基本块
+    /// @return BasicBlock* 入口基本块，没有建立控制流图时为空
+    ///
+    [[nodiscard]] BasicBlock * getEntryBlock() const
+    {
+        return blocks.empty() ? nullptr : blocks.front();
+    }
+
     ///
     /// @brief 获取统计的ARG指令的个数
     /// @return int32_t 个数
@@ -177,7 +247,6 @@ public:
 
     void addTempVar(Value* val); // <--- 函数名是 addTempVar
     [[nodiscard]] const std::vector<Value*>& getTempVars() const;
-	std::string newTempName();
 
 private:
     ///
@@ -195,11 +264,21 @@ private:
     ///
     bool builtIn = false;
 
+    ///
+    /// @brief 函数内对象的内存池，Delete时整体释放
+    ///
+    Arena arena;
+
     ///
     /// @brief 线性IR指令块，可包含多条IR指令
     ///
     InterCode code;
 
+    ///
+    /// @brief 基本块，建立控制流图后指令在基本块中
+    ///
+    std::vector<BasicBlock *> blocks;
+
     ///
     /// @brief 函数内变量的向量表，可能重名，请注意
     ///
@@ -260,12 +339,18 @@ private:
     ///
     int32_t realArgCount = 0;
 
-	// --- 新增成员变量，用于跟踪局部变量分配的栈大小 ---
-	int32_t currentNegativeStackOffsetSize_ = 0; // 存储从FP负向分配的局部变量的总大小 (绝对值)
-	// --- 结束新增 ---
+    ///
+    /// @brief 已分配的稠密编号个数，即下一个编号
+    ///
+    int32_t valueCount = 0;
+
     std::vector<Value *> tempVars;
 
+    ///
+    /// @brief 按稠密编号标记是否已在tempVars中，用于addTempVar去重
+    ///
+    std::vector<bool> tempVarMarks;
+
     int32_t currentStackOffset;
-    int tempNameCounter_ = 0; // 或者其他合适的初始值
     
 };
\ No newline at end of file
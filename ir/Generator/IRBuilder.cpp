@@ -0,0 +1,200 @@
+///
+/// @file IRBuilder.cpp
+/// @brief 按插入点产生线性IR指令的构建器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>指令从函数的内存池分配
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// </table>
+///
+#include "IRBuilder.h"
+
+/// @brief 设置插入点为函数指令序列的尾部
+/// @param _func 函数
+void IRBuilder::setInsertPoint(Function * _func)
+{
+    func = _func;
+    pos = func->getInterCode().end();
+}
+
+/// @brief 设置插入点为函数指令序列中的指定位置，指令插入到它的前面
+/// @param _func 函数
+/// @param _pos 函数指令序列中的位置
+void IRBuilder::setInsertPoint(Function * _func, InterCode::iterator _pos)
+{
+    func = _func;
+    pos = _pos;
+}
+
+/// @brief 清除插入点，之后不能再产生指令
+void IRBuilder::clearInsertPoint()
+{
+    func = nullptr;
+    pos = InterCode::iterator();
+}
+
+/// @brief 获取插入点之前的最后一条指令
+/// @return Instruction* 指令，插入点之前没有指令时为空
+Instruction * IRBuilder::getLastInst() const
+{
+    if (!func || pos == func->getInterCode().begin()) {
+        return nullptr;
+    }
+
+    InterCode::iterator prev = pos;
+    return *--prev;
+}
+
+/// @brief 在插入点插入已创建的指令，如事先创建的标签指令
+/// @param inst 指令
+/// @return Instruction* 插入的指令
+Instruction * IRBuilder::insert(Instruction * inst)
+{
+    // 插入点总在插入的指令之后，连续插入的指令保持创建的次序
+    (void) func->getInterCode().insertBefore(pos, inst);
+
+    return inst;
+}
+
+/// @brief 创建标签指令并插入
+/// @param labelNo 标签编号
+/// @return LabelInstruction* 标签指令
+LabelInstruction * IRBuilder::createLabel(int32_t labelNo)
+{
+    auto * inst = func->getArena().create<LabelInstruction>(func, labelNo);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建函数入口指令并插入
+/// @return EntryInstruction* 入口指令
+EntryInstruction * IRBuilder::createEntry()
+{
+    auto * inst = func->getArena().create<EntryInstruction>(func);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建函数出口指令并插入
+/// @param result 返回值，没有时为空
+/// @return ExitInstruction* 出口指令
+ExitInstruction * IRBuilder::createExit(Value * result)
+{
+    auto * inst = func->getArena().create<ExitInstruction>(func, result);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建二元运算指令并插入，结果登记为函数的临时变量
+/// @param op 运算符
+/// @param lhs 左操作数
+/// @param rhs 右操作数
+/// @param type 结果类型
+/// @return BinaryInstruction* 二元运算指令
+BinaryInstruction * IRBuilder::createBinary(IRInstOperator op, Value * lhs, Value * rhs, Type * type)
+{
+    auto * inst = func->getArena().create<BinaryInstruction>(func, op, lhs, rhs, type);
+    insert(inst);
+    func->addTempVar(inst);
+    return inst;
+}
+
+/// @brief 创建一元运算指令并插入，结果登记为函数的临时变量
+/// @param op 运算符
+/// @param src 操作数
+/// @param type 结果类型
+/// @return UnaryInstruction* 一元运算指令
+UnaryInstruction * IRBuilder::createUnary(IRInstOperator op, Value * src, Type * type)
+{
+    auto * inst = func->getArena().create<UnaryInstruction>(func, op, src, type);
+    insert(inst);
+    func->addTempVar(inst);
+    return inst;
+}
+
+/// @brief 创建复制指令并插入
+/// @param dst 目的操作数
+/// @param src 源操作数
+/// @return MoveInstruction* 复制指令
+MoveInstruction * IRBuilder::createMove(Value * dst, Value * src)
+{
+    auto * inst = func->getArena().create<MoveInstruction>(func, dst, src);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建比较指令并插入
+/// @param dst 比较结果
+/// @param op 比较运算符
+/// @param lhs 左操作数
+/// @param rhs 右操作数
+/// @return CmpInstruction* 比较指令
+CmpInstruction * IRBuilder::createCmp(Value * dst, CmpInstruction::CmpOp op, Value * lhs, Value * rhs)
+{
+    auto * inst = func->getArena().create<CmpInstruction>(dst, op, lhs, rhs, func);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建无条件跳转指令并插入
+/// @param target 跳转的目标标签
+/// @return GotoInstruction* 跳转指令
+GotoInstruction * IRBuilder::createGoto(LabelInstruction * target)
+{
+    auto * inst = func->getArena().create<GotoInstruction>(func, target);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建条件跳转指令并插入
+/// @param cond 条件值
+/// @param trueTarget 条件为真时跳转的标签
+/// @param falseTarget 条件为假时跳转的标签
+/// @return BranchConditionalInstruction* 条件跳转指令
+BranchConditionalInstruction *
+IRBuilder::createCondBranch(Value * cond, LabelInstruction * trueTarget, LabelInstruction * falseTarget)
+{
+    auto * inst = func->getArena().create<BranchConditionalInstruction>(cond, trueTarget, falseTarget, func);
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建函数调用指令并插入，有返回值时结果登记为函数的临时变量
+/// @param name 被调用的函数名
+/// @param args 实参
+/// @param resultType 返回类型
+/// @param callee 被调用的函数，外部函数时为空
+/// @return FuncCallInstruction* 函数调用指令
+FuncCallInstruction * IRBuilder::createCall(const std::string & name,
+                                            const std::vector<Value *> & args,
+                                            Type * resultType,
+                                            Function * callee)
+{
+    auto * inst = func->getArena().create<FuncCallInstruction>(func, name, args, resultType, callee);
+
+    // 结果的IR名字在输出IR前由Function::renameIR统一编号
+    if (resultType && !resultType->isVoidType()) {
+        func->addTempVar(inst);
+    }
+
+    insert(inst);
+    return inst;
+}
+
+/// @brief 创建实参指令并插入
+/// @param src 实参
+/// @return ArgInstruction* 实参指令
+ArgInstruction * IRBuilder::createArg(Value * src)
+{
+    auto * inst = func->getArena().create<ArgInstruction>(func, src);
+    insert(inst);
+    return inst;
+}
@@ -0,0 +1,158 @@
+///
+/// @file IRBuilder.h
+/// @brief 按插入点产生线性IR指令的构建器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ArgInstruction.h"
+#include "BinaryInstruction.h"
+#include "BranchConditionalInstruction.h"
+#include "CmpInstruction.h"
+#include "EntryInstruction.h"
+#include "ExitInstruction.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "GotoInstruction.h"
+#include "IRCode.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "UnaryInstruction.h"
+
+///
+/// @brief 线性IR指令构建器
+///
+/// 记录当前的函数与插入点，create函数创建指令后直接插入到插入点，
+/// 每条指令只插入一次，就在函数指令序列中的最终位置上，不再经过AST节点的指令块逐层拼接。
+/// 插入点为函数指令序列中的某条指令时插入到它的前面，为end()时添加到尾部。
+///
+class IRBuilder {
+
+public:
+    /// @brief 构造函数
+    IRBuilder() = default;
+
+    /// @brief 析构函数
+    ~IRBuilder() = default;
+
+    /// @brief 设置插入点为函数指令序列的尾部
+    /// @param func 函数
+    void setInsertPoint(Function * func);
+
+    /// @brief 设置插入点为函数指令序列中的指定位置，指令插入到它的前面
+    /// @param func 函数
+    /// @param pos 函数指令序列中的位置
+    void setInsertPoint(Function * func, InterCode::iterator pos);
+
+    /// @brief 清除插入点，之后不能再产生指令
+    void clearInsertPoint();
+
+    /// @brief 获取当前的函数
+    /// @return Function* 当前的函数，没有插入点时为空
+    [[nodiscard]] Function * getFunction() const
+    {
+        return func;
+    }
+
+    /// @brief 获取插入点之前的最后一条指令
+    /// @return Instruction* 指令，插入点之前没有指令时为空
+    [[nodiscard]] Instruction * getLastInst() const;
+
+    /// @brief 在插入点插入已创建的指令，如事先创建的标签指令
+    /// @param inst 指令
+    /// @return Instruction* 插入的指令
+    Instruction * insert(Instruction * inst);
+
+    /// @brief 创建标签指令并插入
+    /// @param labelNo 标签编号
+    /// @return LabelInstruction* 标签指令
+    LabelInstruction * createLabel(int32_t labelNo);
+
+    /// @brief 创建函数入口指令并插入
+    /// @return EntryInstruction* 入口指令
+    EntryInstruction * createEntry();
+
+    /// @brief 创建函数出口指令并插入
+    /// @param result 返回值，没有时为空
+    /// @return ExitInstruction* 出口指令
+    ExitInstruction * createExit(Value * result = nullptr);
+
+    /// @brief 创建二元运算指令并插入，结果登记为函数的临时变量
+    /// @param op 运算符
+    /// @param lhs 左操作数
+    /// @param rhs 右操作数
+    /// @param type 结果类型
+    /// @return BinaryInstruction* 二元运算指令
+    BinaryInstruction * createBinary(IRInstOperator op, Value * lhs, Value * rhs, Type * type);
+
+    /// @brief 创建一元运算指令并插入，结果登记为函数的临时变量
+    /// @param op 运算符
+    /// @param src 操作数
+    /// @param type 结果类型
+    /// @return UnaryInstruction* 一元运算指令
+    UnaryInstruction * createUnary(IRInstOperator op, Value * src, Type * type);
+
+    /// @brief 创建复制指令并插入
+    /// @param dst 目的操作数
+    /// @param src 源操作数
+    /// @return MoveInstruction* 复制指令
+    MoveInstruction * createMove(Value * dst, Value * src);
+
+    /// @brief 创建比较指令并插入
+    /// @param dst 比较结果
+    /// @param op 比较运算符
+    /// @param lhs 左操作数
+    /// @param rhs 右操作数
+    /// @return CmpInstruction* 比较指令
+    CmpInstruction * createCmp(Value * dst, CmpInstruction::CmpOp op, Value * lhs, Value * rhs);
+
+    /// @brief 创建无条件跳转指令并插入
+    /// @param target 跳转的目标标签
+    /// @return GotoInstruction* 跳转指令
+    GotoInstruction * createGoto(LabelInstruction * target);
+
+    /// @brief 创建条件跳转指令并插入
+    /// @param cond 条件值
+    /// @param trueTarget 条件为真时跳转的标签
+    /// @param falseTarget 条件为假时跳转的标签
+    /// @return BranchConditionalInstruction* 条件跳转指令
+    BranchConditionalInstruction *
+    createCondBranch(Value * cond, LabelInstruction * trueTarget, LabelInstruction * falseTarget);
+
+    /// @brief 创建函数调用指令并插入
+    /// @param name 被调用的函数名
+    /// @param args 实参
+    /// @param resultType 返回类型
+    /// @param callee 被调用的函数，外部函数时为空
+    /// @return FuncCallInstruction* 函数调用指令
+    FuncCallInstruction * createCall(const std::string & name,
+                                     const std::vector<Value *> & args,
+                                     Type * resultType,
+                                     Function * callee = nullptr);
+
+    /// @brief 创建实参指令并插入
+    /// @param src 实参
+    /// @return ArgInstruction* 实参指令
+    ArgInstruction * createArg(Value * src);
+
+private:
+    /// @brief 当前的函数
+    Function * func = nullptr;
+
+    /// @brief 插入点，指令插入到它的前面
+    InterCode::iterator pos;
+};
@@ -2,8 +2,8 @@
 /// @file IRGenerator.cpp
 /// @brief AST遍历产生线性IR的源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.12
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,8 +12,20 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>标识符改为驻留编号
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>节点的指令块与Value改为按节点编号的附加表
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>翻译函数改为按运算符索引的表，遍历改为显式工作栈
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>指令由IRBuilder直接产生到函数的插入点，去掉节点的指令块
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>-O1以上折叠常量表达式与常量条件
+/// <tr><td>2026-10-16 <td>1.7     <td>zenglj  <td>二元运算可按Sethi-Ullman标号确定操作数的求值次序
+/// <tr><td>2026-10-16 <td>1.8     <td>zenglj  <td>指令从函数的内存池分配
+/// <tr><td>2026-10-16 <td>1.9     <td>zenglj  <td>以isa/dyn_cast代替dynamic_cast
+/// <tr><td>2026-10-16 <td>1.10    <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.11    <td>zenglj  <td>附加表按AST上下文的节点个数分配
+/// <tr><td>2026-10-16 <td>1.12    <td>zenglj  <td>调试输出只在输出调试日志时生成
 /// </table>
 ///
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <unordered_map>
@@ -41,56 +53,59 @@
 #include "ScopeStack.h"
 /// @brief 构造函数
 /// @param _root AST的根
+/// @param astContext AST所在的上下文
 /// @param _module 符号表
-IRGenerator::IRGenerator(ast_node * _root, Module * _module) : root(_root), module(_module)
+IRGenerator::IRGenerator(ast_node * _root, const ASTContext & astContext, Module * _module, int _optLevel)
+    : root(_root), nodeCount(astContext.getNodeCount()), module(_module), optLevel(_optLevel)
 {
+    // 不支持的运算符由ir_default处理，缺省为先序翻译，即翻译函数自行访问孩子
+    for (auto & entry: ast2ir_handlers) {
+        entry = {&IRGenerator::ir_default, nullptr, false};
+    }
+
     /* 叶子节点 */
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_LITERAL_UINT] = &IRGenerator::ir_leaf_node_uint;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_VAR_ID] = &IRGenerator::ir_leaf_node_var_id;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_TYPE] = &IRGenerator::ir_leaf_node_type;
-
-    /* 表达式运算， 加减 */
-    ast2ir_handlers[ast_operator_type::AST_OP_SUB] = &IRGenerator::ir_sub;
-    ast2ir_handlers[ast_operator_type::AST_OP_ADD] = &IRGenerator::ir_add;
-    /* 表达式运算， 乘、除、取模 */
-    ast2ir_handlers[ast_operator_type::AST_OP_MUL] = &IRGenerator::ir_mul;
-    ast2ir_handlers[ast_operator_type::AST_OP_DIV] = &IRGenerator::ir_div;
-    ast2ir_handlers[ast_operator_type::AST_OP_MOD] = &IRGenerator::ir_mod;
-    /* 表达式运算， 一元运算 */
-    ast2ir_handlers[ast_operator_type::AST_OP_NEG] = &IRGenerator::ir_neg;
-
-    /* 语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_ASSIGN] = &IRGenerator::ir_assign;
-    ast2ir_handlers[ast_operator_type::AST_OP_RETURN] = &IRGenerator::ir_return;
-
-    /* 函数调用 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_CALL] = &IRGenerator::ir_function_call;
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_LEAF_LITERAL_UINT] = {&IRGenerator::ir_leaf_node_uint, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_LEAF_VAR_ID] = {&IRGenerator::ir_leaf_node_var_id, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_LEAF_TYPE] = {&IRGenerator::ir_leaf_node_type, nullptr, false};
+
+    /* 表达式运算， 加减，后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_SUB] = {&IRGenerator::ir_sub, nullptr, true};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_ADD] = {&IRGenerator::ir_add, nullptr, true};
+    /* 表达式运算， 乘、除、取模，后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_MUL] = {&IRGenerator::ir_mul, nullptr, true};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_DIV] = {&IRGenerator::ir_div, nullptr, true};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_MOD] = {&IRGenerator::ir_mod, nullptr, true};
+    /* 表达式运算， 一元运算，后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_NEG] = {&IRGenerator::ir_neg, nullptr, true};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_LNOT] = {&IRGenerator::ir_lnot_expression, nullptr, true};
+
+    /* 语句，后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_ASSIGN] = {&IRGenerator::ir_assign, nullptr, true};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_RETURN] = {&IRGenerator::ir_return, nullptr, true};
+
+    /* 函数调用，实参后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_FUNC_CALL] = {&IRGenerator::ir_function_call, nullptr, true};
 
     /* 函数定义 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_DEF] = &IRGenerator::ir_function_define;
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS] = &IRGenerator::ir_function_formal_params;
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_FUNC_DEF] = {&IRGenerator::ir_function_define, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS] = {&IRGenerator::ir_function_formal_params,
+                                                                          nullptr,
+                                                                          false};
 
     /* 变量定义语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_DECL_STMT] = &IRGenerator::ir_declare_statment;
-    
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_DECL_STMT] = {&IRGenerator::ir_declare_statment, nullptr, false};
 
-    /* 语句块 */
-    ast2ir_handlers[ast_operator_type::AST_OP_BLOCK] = &IRGenerator::ir_block;
+    /* 语句块，进入时建立作用域，语句后序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_BLOCK] = {&IRGenerator::ir_block, &IRGenerator::ir_block_enter, true};
 
     /* 编译单元 */
-    ast2ir_handlers[ast_operator_type::AST_OP_COMPILE_UNIT] = &IRGenerator::ir_compile_unit;
-
-	/*--- 新增：为语句类型注册处理器 ---
-    这些处理器将由 ir_visit_ast_node 调用*/
-    ast2ir_handlers[ast_operator_type::AST_OP_IF] = &IRGenerator::ir_if_statement;
-    ast2ir_handlers[ast_operator_type::AST_OP_WHILE] = &IRGenerator::ir_while_statement;
-    ast2ir_handlers[ast_operator_type::AST_OP_BREAK] = &IRGenerator::ir_break_statement;
-    ast2ir_handlers[ast_operator_type::AST_OP_CONTINUE] = &IRGenerator::ir_continue_statement;
-
-  
-    ast2ir_handlers[ast_operator_type::AST_OP_LNOT] = &IRGenerator::ir_lnot_expression;
-
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_COMPILE_UNIT] = {&IRGenerator::ir_compile_unit, nullptr, false};
 
+    /* 控制流语句，标签要在孩子之前创建，先序翻译 */
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_IF] = {&IRGenerator::ir_if_statement, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_WHILE] = {&IRGenerator::ir_while_statement, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_BREAK] = {&IRGenerator::ir_break_statement, nullptr, false};
+    ast2ir_handlers[(int) ast_operator_type::AST_OP_CONTINUE] = {&IRGenerator::ir_continue_statement, nullptr, false};
 }
 
 /// @brief 遍历抽象语法树产生线性IR，保存到IRCode中
@@ -101,13 +116,41 @@ bool IRGenerator::run()
 {
     ast_node * node;
 
+    // 节点的Value按节点编号保存在附加信息表中，指令由builder直接产生到函数中
+    nodeValues.assign(nodeCount, nullptr);
+
+    // 求值次序按寄存器需求数确定时，先给表达式子树标号
+    if (sethiUllmanOrder) {
+        ir_label_register_need(root);
+    }
+
     // 从根节点进行遍历
     node = ir_visit_ast_node(root);
 
+    nodeValues.clear();
+    regNeeds.clear();
+    builder.clearInsertPoint();
+
     return node != nullptr;
 }
 
+/// @brief 获取AST节点翻译产生的Value
+/// @param node AST节点
+/// @return Value的引用，可直接赋值
+Value *& IRGenerator::nodeValue(ast_node * node)
+{
+    if (nodeValues.size() <= node->id) {
+        nodeValues.resize(node->id + 1, nullptr);
+    }
+
+    return nodeValues[node->id];
+}
+
 /// @brief 根据AST的节点运算符查找对应的翻译函数并执行翻译动作
+///
+/// 不递归，采用显式的工作栈：后序翻译的节点先压入其操作数，操作数都翻译完成后再调用翻译函数，
+/// 深的表达式与嵌套的语句块不会耗尽系统栈。先序翻译的节点由翻译函数自行调用本函数访问孩子。
+///
 /// @param node AST节点
 /// @return 成功返回node节点，否则返回nullptr
 ast_node * IRGenerator::ir_visit_ast_node(ast_node * node)
@@ -117,25 +160,283 @@ ast_node * IRGenerator::ir_visit_ast_node(ast_node * node)
         return nullptr;
     }
 
-    bool result;
+    // 先序翻译函数中的嵌套调用共用工作栈，每次调用只处理自己压入的部分
+    size_t base = visitStack.size();
+    visitStack.push_back({node, false});
 
-    std::unordered_map<ast_operator_type, ast2ir_handler_t>::const_iterator pIter;
-    pIter = ast2ir_handlers.find(node->node_type);
-    if (pIter == ast2ir_handlers.end()) {
-        // 没有找到，则说明当前不支持
-        result = (this->ir_default)(node);
-    } else {
-        result = (this->*(pIter->second))(node);
-    }
+    while (visitStack.size() > base) {
 
-    if (!result) {
-        // 语义解析错误，则出错返回
-        node = nullptr;
+        ast_node * cur = visitStack.back().node;
+        const ast2ir_entry & entry = ast2ir_handlers[(int) cur->node_type];
+
+        if (entry.postorder && !visitStack.back().expanded) {
+
+            visitStack.back().expanded = true;
+
+            // 进入动作，如语句块建立作用域
+            if (entry.enter && !(this->*entry.enter)(cur)) {
+                visitStack.resize(base);
+                return nullptr;
+            }
+
+            // 函数调用的操作数是实参，函数名不需要翻译
+            const ast_node_list & operands =
+                cur->node_type == ast_operator_type::AST_OP_FUNC_CALL ? cur->sons[1]->sons : cur->sons;
+
+            if (operands.size() == 2 && ir_right_operand_first(cur)) {
+                // 右操作数需要的寄存器多，先压左操作数，右操作数先翻译
+                visitStack.push_back({operands[0], false});
+                visitStack.push_back({operands[1], false});
+                continue;
+            }
+
+            // 逆序压栈，操作数按从左到右的次序翻译
+            for (size_t k = operands.size(); k > 0; --k) {
+                visitStack.push_back({operands[k - 1], false});
+            }
+
+            continue;
+        }
+
+        visitStack.pop_back();
+
+        if (!(this->*entry.handler)(cur)) {
+            // 语义解析错误，则出错返回
+            visitStack.resize(base);
+            return nullptr;
+        }
     }
 
     return node;
 }
 
+/// @brief 获取整型常量的值
+/// @param val Value
+/// @param out 常量的值
+/// @return true：是整型常量，false：不是
+static bool const_int_value(Value * val, int32_t & out)
+{
+    auto * constVal = dyn_cast_or_null<ConstInt>(val);
+    if (!constVal) {
+        return false;
+    }
+
+    out = constVal->getVal();
+    return true;
+}
+
+/// @brief 获取i32常量的值，i1等其它宽度的常量不参与算术折叠
+/// @param val Value
+/// @param out 常量的值
+/// @return true：是i32常量，false：不是
+static bool const_i32_value(Value * val, int32_t & out)
+{
+    return val && val->getType() && val->getType()->isInt32Type() && const_int_value(val, out);
+}
+
+/// @brief 两个操作数都是i32常量时按32位C语义计算二元运算，-O1以上有效
+///
+/// 加减乘按2^32回绕；除法与取模向零截断，除数为0时不折叠，留给运行时；
+/// INT_MIN除以-1的商回绕为INT_MIN，余数为0，与目标机器的sdiv及取模的展开一致。
+///
+/// @param op 运算符，加、减、乘、除、取模
+/// @param lhs 左操作数
+/// @param rhs 右操作数
+/// @return 结果常量，不能折叠时为空
+ConstInt * IRGenerator::fold_binary(IRInstOperator op, Value * lhs, Value * rhs)
+{
+    int32_t a, b;
+    if (optLevel < 1 || !const_i32_value(lhs, a) || !const_i32_value(rhs, b)) {
+        return nullptr;
+    }
+
+    // 无符号运算没有溢出的未定义行为，结果按补码转换回有符号数
+    uint32_t ua = (uint32_t) a;
+    uint32_t ub = (uint32_t) b;
+    int32_t result;
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+            result = (int32_t) (ua + ub);
+            break;
+        case IRInstOperator::IRINST_OP_SUB_I:
+            result = (int32_t) (ua - ub);
+            break;
+        case IRInstOperator::IRINST_OP_MUL_I:
+            result = (int32_t) (ua * ub);
+            break;
+        case IRInstOperator::IRINST_OP_DIV_I:
+            if (b == 0) {
+                return nullptr;
+            }
+            result = (a == INT32_MIN && b == -1) ? INT32_MIN : a / b;
+            break;
+        case IRInstOperator::IRINST_OP_MOD_I:
+            if (b == 0) {
+                return nullptr;
+            }
+            result = (a == INT32_MIN && b == -1) ? 0 : a % b;
+            break;
+        default:
+            return nullptr;
+    }
+
+    return module->newConstInt(result);
+}
+
+/// @brief 操作数是i32常量时计算取负，-O1以上有效
+/// @param src 操作数
+/// @return 结果常量，不能折叠时为空
+ConstInt * IRGenerator::fold_neg(Value * src)
+{
+    int32_t a;
+    if (optLevel < 1 || !const_i32_value(src, a)) {
+        return nullptr;
+    }
+
+    // -INT_MIN回绕为INT_MIN
+    return module->newConstInt((int32_t) (0u - (uint32_t) a));
+}
+
+/// @brief 两个操作数都是整型常量时计算比较，-O1以上有效
+/// @param op 比较运算符
+/// @param lhs 左操作数
+/// @param rhs 右操作数
+/// @param result 比较的结果
+/// @return true：已折叠，false：不能折叠
+bool IRGenerator::fold_compare(CmpInstruction::CmpOp op, Value * lhs, Value * rhs, bool & result)
+{
+    int32_t a, b;
+    if (optLevel < 1 || !const_int_value(lhs, a) || !const_int_value(rhs, b)) {
+        return false;
+    }
+
+    switch (op) {
+        case CmpInstruction::LT:
+            result = a < b;
+            break;
+        case CmpInstruction::LE:
+            result = a <= b;
+            break;
+        case CmpInstruction::GT:
+            result = a > b;
+            break;
+        case CmpInstruction::GE:
+            result = a >= b;
+            break;
+        case CmpInstruction::EQ:
+            result = a == b;
+            break;
+        case CmpInstruction::NE:
+            result = a != b;
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/// @brief 计算各表达式子树的寄存器需求数与是否含有函数调用，非递归后序遍历
+///
+/// 叶子需要一个寄存器；二元运算两侧需求数相同时为其加一，否则取大者，
+/// 即先求值需求数大的一侧，其结果占一个寄存器后另一侧仍然够用；
+/// 一元运算与函数调用取操作数的最大值，至少为一。
+///
+/// @param node AST的根
+void IRGenerator::ir_label_register_need(ast_node * node)
+{
+    regNeeds.assign(nodeCount, reg_need_label{1, false});
+
+    std::vector<visit_frame> stack;
+    stack.push_back({node, false});
+
+    while (!stack.empty()) {
+
+        visit_frame & frame = stack.back();
+        ast_node * cur = frame.node;
+
+        if (!frame.expanded) {
+            frame.expanded = true;
+            for (auto son: cur->sons) {
+                if (son) {
+                    stack.push_back({son, false});
+                }
+            }
+            continue;
+        }
+
+        stack.pop_back();
+
+        reg_need_label label{1, cur->node_type == ast_operator_type::AST_OP_FUNC_CALL};
+        uint16_t maxNeed = 0;
+
+        for (auto son: cur->sons) {
+            if (son) {
+                const reg_need_label & sonLabel = regNeeds[son->id];
+                maxNeed = std::max(maxNeed, sonLabel.need);
+                label.hasCall = label.hasCall || sonLabel.hasCall;
+            }
+        }
+
+        switch (cur->node_type) {
+            case ast_operator_type::AST_OP_ADD:
+            case ast_operator_type::AST_OP_SUB:
+            case ast_operator_type::AST_OP_MUL:
+            case ast_operator_type::AST_OP_DIV:
+            case ast_operator_type::AST_OP_MOD: {
+                uint16_t left = regNeeds[cur->sons[0]->id].need;
+                uint16_t right = regNeeds[cur->sons[1]->id].need;
+                label.need = left == right ? left + 1 : std::max(left, right);
+                break;
+            }
+            default:
+                label.need = std::max<uint16_t>(1, maxNeed);
+                break;
+        }
+
+        regNeeds[cur->id] = label;
+    }
+}
+
+/// @brief 二元运算的右操作数是否应先求值
+///
+/// 加法与乘法可交换，C语言也不规定操作数的求值次序，总可以先求右侧；
+/// 减法、除法与取模只在两侧都没有函数调用时调换，保持有副作用的表达式先左后右。
+/// 只调换求值次序，指令的左右操作数不变。
+///
+/// @param node 二元运算节点
+/// @return true：先右后左，false：先左后右
+bool IRGenerator::ir_right_operand_first(ast_node * node)
+{
+    if (regNeeds.empty()) {
+        return false;
+    }
+
+    switch (node->node_type) {
+        case ast_operator_type::AST_OP_ADD:
+        case ast_operator_type::AST_OP_MUL:
+        case ast_operator_type::AST_OP_SUB:
+        case ast_operator_type::AST_OP_DIV:
+        case ast_operator_type::AST_OP_MOD:
+            break;
+        default:
+            return false;
+    }
+
+    const reg_need_label & left = regNeeds[node->sons[0]->id];
+    const reg_need_label & right = regNeeds[node->sons[1]->id];
+
+    if (right.need <= left.need) {
+        return false;
+    }
+
+    bool commutative =
+        node->node_type == ast_operator_type::AST_OP_ADD || node->node_type == ast_operator_type::AST_OP_MUL;
+
+    return commutative || (!left.hasCall && !right.hasCall);
+}
+
 /// @brief 未知节点类型的节点处理
 /// @param node AST节点
 /// @return 翻译是否成功，true：成功，false：失败
@@ -191,7 +492,7 @@ bool IRGenerator::ir_function_define(ast_node * node)
     ast_node * block_node = node->sons[3];
 
     // 创建一个新的函数定义
-    Function * newFunc = module->newFunction(name_node->name, type_node->type);
+    Function * newFunc = module->newFunction(symbol_name(name_node->name), type_node->type);
     if (!newFunc) {
         // 新定义的函数已经存在，则失败返回。
         // TODO 自行追加语义错误处理
@@ -204,18 +505,16 @@ bool IRGenerator::ir_function_define(ast_node * node)
     // 进入函数的作用域
     module->enterScope();
 
-    // 获取函数的IR代码列表，用于后面追加指令用，注意这里用的是引用传值
-    InterCode & irCode = newFunc->getInterCode();
+    // 函数内的指令都由builder依次添加到函数IR代码列表的尾部
+    builder.setInsertPoint(newFunc);
 
     // 这里也可增加一个函数入口Label指令，便于后续基本块划分
-	LabelInstruction* entryLabel = new LabelInstruction(newFunc, ".L" + std::to_string(label_counter_++));
-	irCode.addInst(entryLabel);
+    builder.createLabel(label_counter_++);
     // 创建并加入Entry入口指令
-    irCode.addInst(new EntryInstruction(newFunc));
+    builder.createEntry();
 
     // 创建出口指令并不加入出口指令，等函数内的指令处理完毕后加入出口指令
-    std::string exit_label_name = ".L" + std::to_string(label_counter_++); // 或者其他唯一名称生成方式
-	LabelInstruction * exitLabelInst = new LabelInstruction(newFunc, exit_label_name);
+	LabelInstruction * exitLabelInst = newFunc->getArena().create<LabelInstruction>(newFunc, label_counter_++);
 
     // 函数出口指令保存到函数信息中，因为在语义分析函数体时return语句需要跳转到函数尾部，需要这个label指令
     newFunc->setExitLabel(exitLabelInst);
@@ -227,7 +526,6 @@ bool IRGenerator::ir_function_define(ast_node * node)
         // TODO 自行追加语义错误处理
         return false;
     }
-    node->blockInsts.addInst(param_node->blockInsts);
 
     // 新建一个Value，用于保存函数的返回值，如果没有返回值可不用申请
     LocalVariable * retValue = nullptr;
@@ -244,29 +542,23 @@ bool IRGenerator::ir_function_define(ast_node * node)
     block_node->needScope = false;
 
     // 遍历block
-    result = ir_block(block_node);
-    if (!result) {
+    if (!ir_visit_ast_node(block_node)) {
         // block解析失败
         // TODO 自行追加语义错误处理
         return false;
     }
 
-    // IR指令追加到当前的节点中
-    node->blockInsts.addInst(block_node->blockInsts);
-
-    // 此时，所有指令都加入到当前函数中，也就是node->blockInsts
-
-    // node节点的指令移动到函数的IR指令列表中
-    irCode.addInst(node->blockInsts);
+    // 此时，函数体的指令都已加入到当前函数中
 
     // 添加函数出口Label指令，主要用于return语句跳转到这里进行函数的退出
-    irCode.addInst(exitLabelInst);
+    builder.insert(exitLabelInst);
 
     // 函数出口指令
-    irCode.addInst(new ExitInstruction(newFunc, retValue));
+    builder.createExit(retValue);
 
     // 恢复成外部函数
     module->setCurrentFunction(nullptr);
+    builder.clearInsertPoint();
 
     // 退出函数的作用域
     module->leaveScope();
@@ -302,12 +594,12 @@ bool IRGenerator::ir_function_call(ast_node * node)
     Function * currentFunc = module->getCurrentFunction();
 
     ast_node * funcNameNode = node->sons[0];
-    std::string ast_func_name_str = funcNameNode->name; 
+    const std::string & ast_func_name_str = symbol_name(funcNameNode->name);
     minic_log(LOG_DEBUG, "IRGenerator::ir_function_call: Function name extracted from AST (node->sons[0]->name) is: ---->'%s'<----", ast_func_name_str.c_str());
     
     ast_node * paramsNode = node->sons[1];
     int64_t lineno = funcNameNode->line_no;
-    Function * calledFuncObject = module->findFunction(ast_func_name_str);
+    Function * calledFuncObject = module->findFunction(funcNameNode->name);
 
     if (!ast_func_name_str.empty() && calledFuncObject == nullptr) {
         minic_log(LOG_WARNING, "IRGenerator: Function '%s' called at line %lld but not found in current module. Assuming external/library function.", 
@@ -324,15 +616,14 @@ bool IRGenerator::ir_function_call(ast_node * node)
         return false;
     }
 
+    // 实参已由ir_visit_ast_node按次序翻译
     if (paramsNode && !paramsNode->sons.empty()) { // 检查 paramsNode 是否为 null
         for (auto son: paramsNode->sons) {
-            ast_node * temp = ir_visit_ast_node(son);
-            if (!temp || !temp->val) { 
+            if (!nodeValue(son)) {
                  minic_log(LOG_ERROR, "IRGenerator: Failed to evaluate argument for function call '%s'", ast_func_name_str.c_str());
                 return false;
             }
-            realParams.push_back(temp->val);
-            node->blockInsts.addInst(temp->blockInsts);
+            realParams.push_back(nodeValue(son));
         }
     }
 
@@ -353,54 +644,37 @@ bool IRGenerator::ir_function_call(ast_node * node)
     if (!return_type) return_type = VoidType::getType(); 
 
 
-    // --- 修正 FuncCallInstruction 构造函数的参数传递顺序 ---
-    FuncCallInstruction * funcCallInst = new FuncCallInstruction(
-        currentFunc,            // 1. parentFuncScope (Function*)
-        ast_func_name_str,      // 2. func_name_to_call (const std::string&) <--- 现在传递的是从AST提取的字符串名称
-        realParams,             // 3. args (const std::vector<Value*>&)
-        return_type,            // 4. result_type_if_any (Type*)
-        calledFuncObject        // 5. target_func_object (Function*, 可以是 nullptr)
-    );
-    // --- 结束修正 ---
+    // 有返回值时结果登记为临时变量
+    FuncCallInstruction * funcCallInst = builder.createCall(ast_func_name_str, realParams, return_type, calledFuncObject);
 
     if (return_type && !return_type->isVoidType()) {
-        std::string temp_name = currentFunc->newTempName(); 
-        funcCallInst->setIRName(temp_name); 
-        currentFunc->addTempVar(funcCallInst); 
         minic_log(LOG_DEBUG, "IRGenerator: FuncCall '%s' will store result in '%s'", 
-                  ast_func_name_str.c_str(), temp_name.c_str());
-    } else {
-        funcCallInst->setIRName(""); 
+                  ast_func_name_str.c_str(), funcCallInst->getIRName().c_str());
     }
 
-    node->blockInsts.addInst(funcCallInst);
-    node->val = funcCallInst; 
+    nodeValue(node) = funcCallInst; 
 
     return true;
 }
 
-/// @brief 语句块（含函数体）AST节点翻译成线性中间IR
+/// @brief 进入语句块（含函数体），在语句翻译之前建立作用域
 /// @param node AST节点
 /// @return 翻译是否成功，true：成功，false：失败
-bool IRGenerator::ir_block(ast_node * node)
+bool IRGenerator::ir_block_enter(ast_node * node)
 {
     // 进入作用域
     if (node->needScope) {
         module->enterScope();
     }
 
-    std::vector<ast_node *>::iterator pIter;
-    for (pIter = node->sons.begin(); pIter != node->sons.end(); ++pIter) {
-
-        // 遍历Block的每个语句，进行显示或者运算
-        ast_node * temp = ir_visit_ast_node(*pIter);
-        if (!temp) {
-            return false;
-        }
-
-        node->blockInsts.addInst(temp->blockInsts);
-    }
+    return true;
+}
 
+/// @brief 语句块（含函数体）AST节点翻译成线性中间IR，语句已由ir_visit_ast_node按次序翻译
+/// @param node AST节点
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::ir_block(ast_node * node)
+{
     // 离开作用域
     if (node->needScope) {
         module->leaveScope();
@@ -417,36 +691,24 @@ bool IRGenerator::ir_add(ast_node * node)
     ast_node * src1_node = node->sons[0];
     ast_node * src2_node = node->sons[1];
 
-    // 加法节点，左结合，先计算左节点，后计算右节点
-
-    // 加法的左边操作数
-    ast_node * left = ir_visit_ast_node(src1_node);
-    if (!left) {
-        // 某个变量没有定值
-        return false;
-    }
-
-    // 加法的右边操作数
-    ast_node * right = ir_visit_ast_node(src2_node);
-    if (!right) {
-        // 某个变量没有定值
-        return false;
-    }
+    // 加法节点，左结合，左右操作数已由ir_visit_ast_node先后翻译
+    ast_node * left = src1_node;
+    ast_node * right = src2_node;
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * addInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_ADD_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    // 两个操作数都是常量时直接得到结果常量，不产生指令
+    if (ConstInt * folded = fold_binary(IRInstOperator::IRINST_OP_ADD_I, nodeValue(left), nodeValue(right))) {
+        nodeValue(node) = folded;
+        return true;
+    }
 
-    // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(addInst);
-	module->getCurrentFunction()->addTempVar(addInst);
-    node->val = addInst;
+    // 创建临时变量保存IR的值，以及线性IR指令，操作数的指令已在前面产生
+    BinaryInstruction * addInst = builder.createBinary(IRInstOperator::IRINST_OP_ADD_I,
+                                                      nodeValue(left),
+                                                      nodeValue(right),
+                                                      IntegerType::getTypeInt());
+    nodeValue(node) = addInst;
 
     return true;
 }
@@ -459,36 +721,24 @@ bool IRGenerator::ir_sub(ast_node * node)
     ast_node * src1_node = node->sons[0];
     ast_node * src2_node = node->sons[1];
 
-    // 加法节点，左结合，先计算左节点，后计算右节点
-
-    // 加法的左边操作数
-    ast_node * left = ir_visit_ast_node(src1_node);
-    if (!left) {
-        // 某个变量没有定值
-        return false;
-    }
-
-    // 加法的右边操作数
-    ast_node * right = ir_visit_ast_node(src2_node);
-    if (!right) {
-        // 某个变量没有定值
-        return false;
-    }
+    // 减法节点，左结合，左右操作数已由ir_visit_ast_node先后翻译
+    ast_node * left = src1_node;
+    ast_node * right = src2_node;
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * subInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_SUB_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    // 两个操作数都是常量时直接得到结果常量，不产生指令
+    if (ConstInt * folded = fold_binary(IRInstOperator::IRINST_OP_SUB_I, nodeValue(left), nodeValue(right))) {
+        nodeValue(node) = folded;
+        return true;
+    }
 
-    // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(subInst);
-	module->getCurrentFunction()->addTempVar(subInst);
-    node->val = subInst;
+    // 创建临时变量保存IR的值，以及线性IR指令，操作数的指令已在前面产生
+    BinaryInstruction * subInst = builder.createBinary(IRInstOperator::IRINST_OP_SUB_I,
+                                                      nodeValue(left),
+                                                      nodeValue(right),
+                                                      IntegerType::getTypeInt());
+    nodeValue(node) = subInst;
 
     return true;
 }
@@ -499,31 +749,22 @@ bool IRGenerator::ir_mul(ast_node * node)
 {
     ast_node * src1_node = node->sons[0];
     ast_node * src2_node = node->sons[1];
-    // 乘法节点，左结合，先计算左节点，后计算右节点
-    // 乘法的左边操作数
-    ast_node * left = ir_visit_ast_node(src1_node);
-    if (!left) {
-        // 某个变量没有定值
-        return false;
-    }
-    // 乘法的右边操作数
-    ast_node * right = ir_visit_ast_node(src2_node);
-    if (!right) {
-        // 某个变量没有定值
-        return false;
-    }
+    // 乘法节点，左结合，左右操作数已由ir_visit_ast_node先后翻译
+    ast_node * left = src1_node;
+    ast_node * right = src2_node;
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
-    BinaryInstruction * mulInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_MUL_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
-    // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(mulInst);
-    module->getCurrentFunction()->addTempVar(mulInst);
-    node->val = mulInst;
+    // 两个操作数都是常量时直接得到结果常量，不产生指令
+    if (ConstInt * folded = fold_binary(IRInstOperator::IRINST_OP_MUL_I, nodeValue(left), nodeValue(right))) {
+        nodeValue(node) = folded;
+        return true;
+    }
+
+    // 创建临时变量保存IR的值，以及线性IR指令，操作数的指令已在前面产生
+    BinaryInstruction * mulInst = builder.createBinary(IRInstOperator::IRINST_OP_MUL_I,
+                                                      nodeValue(left),
+                                                      nodeValue(right),
+                                                      IntegerType::getTypeInt());
+    nodeValue(node) = mulInst;
     return true;
 }
 
@@ -534,32 +775,22 @@ bool IRGenerator::ir_div(ast_node * node)
 {
     ast_node * src1_node = node->sons[0];
     ast_node * src2_node = node->sons[1];
-    // 除法节点，左结合，先计算左节点，后计算右节点
-    // 除法的左边操作数
-    ast_node * left = ir_visit_ast_node(src1_node);
-    if (!left) {
-        // 某个变量没有定值
-        return false;
-    }
-    // 除法的右边操作数
-    ast_node * right = ir_visit_ast_node(src2_node);
-    if (!right) {
-
-        // 某个变量没有定值
-        return false;
-    }
+    // 除法节点，左结合，左右操作数已由ir_visit_ast_node先后翻译
+    ast_node * left = src1_node;
+    ast_node * right = src2_node;
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
-    BinaryInstruction * divInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_DIV_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
-    // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(divInst);
-    module->getCurrentFunction()->addTempVar(divInst);
-    node->val = divInst;
+    // 两个操作数都是常量时直接得到结果常量，不产生指令
+    if (ConstInt * folded = fold_binary(IRInstOperator::IRINST_OP_DIV_I, nodeValue(left), nodeValue(right))) {
+        nodeValue(node) = folded;
+        return true;
+    }
+
+    // 创建临时变量保存IR的值，以及线性IR指令，操作数的指令已在前面产生
+    BinaryInstruction * divInst = builder.createBinary(IRInstOperator::IRINST_OP_DIV_I,
+                                                      nodeValue(left),
+                                                      nodeValue(right),
+                                                      IntegerType::getTypeInt());
+    nodeValue(node) = divInst;
     return true;
 }
 
@@ -576,23 +807,29 @@ bool IRGenerator::ir_mod(ast_node * node) {
     ast_node * src1_node = node->sons[0]; // a
     ast_node * src2_node = node->sons[1]; // b
 
-    // --- 访问左操作数 (a) ---
-    ast_node * visited_left = ir_visit_ast_node(src1_node);
-    if (!visited_left || !visited_left->val) {
+    // 左右操作数已由ir_visit_ast_node先后翻译
+
+    // --- 左操作数 (a) ---
+    ast_node * visited_left = src1_node;
+    if (!nodeValue(visited_left)) {
         minic_log(LOG_ERROR, "MOD: Failed to visit or get value for left operand.");
         return false;
     }
-    appendInstructionsToNode(node, visited_left->blockInsts); // 添加计算 a 的指令
-    Value* val_a = visited_left->val;
+    Value* val_a = nodeValue(visited_left);
 
-    // --- 访问右操作数 (b) ---
-    ast_node * visited_right = ir_visit_ast_node(src2_node);
-    if (!visited_right || !visited_right->val) {
+    // --- 右操作数 (b) ---
+    ast_node * visited_right = src2_node;
+    if (!nodeValue(visited_right)) {
         minic_log(LOG_ERROR, "MOD: Failed to visit or get value for right operand.");
         return false;
     }
-    appendInstructionsToNode(node, visited_right->blockInsts); // 添加计算 b 的指令
-    Value* val_b = visited_right->val;
+    Value* val_b = nodeValue(visited_right);
+
+    // 常量取模直接得到结果，不展开成除、乘、减
+    if (ConstInt * folded = fold_binary(IRInstOperator::IRINST_OP_MOD_I, val_a, val_b)) {
+        nodeValue(node) = folded;
+        return true;
+    }
 
     Function* current_func = module->getCurrentFunction();
     if (!current_func) { // 防御性检查
@@ -601,42 +838,21 @@ bool IRGenerator::ir_mod(ast_node * node) {
     }
 
     // --- 1. 计算 t_div = a / b ---
-    BinaryInstruction* divInst = new BinaryInstruction(
-        current_func,
-        IRInstOperator::IRINST_OP_DIV_I,
-        val_a,
-        val_b,
-        IntegerType::getTypeInt() // 假设除法结果是 i32
-    );
-    node->blockInsts.addInst(divInst);
-    current_func->addTempVar(divInst); // <--- 重要：将 divInst 注册为临时变量
+    // 假设除法结果是 i32，builder将 divInst 注册为临时变量
+    BinaryInstruction* divInst = builder.createBinary(IRInstOperator::IRINST_OP_DIV_I, val_a, val_b, IntegerType::getTypeInt());
 
     // --- 2. 计算 t_mul = t_div * b ---
     // divInst (作为 Value*) 现在是乘法的第一个操作数
-    BinaryInstruction* mulInst = new BinaryInstruction(
-        current_func,
-        IRInstOperator::IRINST_OP_MUL_I,
-        divInst,  // 使用上一步的 divInst 作为源操作数
-        val_b,
-        IntegerType::getTypeInt() // 假设乘法结果是 i32
-    );
-    node->blockInsts.addInst(mulInst);
-    current_func->addTempVar(mulInst); // <--- 重要：将 mulInst 注册为临时变量
+    // 使用上一步的 divInst 作为源操作数
+    BinaryInstruction* mulInst = builder.createBinary(IRInstOperator::IRINST_OP_MUL_I, divInst, val_b, IntegerType::getTypeInt());
 
     // --- 3. 计算 result_mod = a - t_mul ---
     // mulInst (作为 Value*) 现在是减法的第二个操作数
-    BinaryInstruction* modInst = new BinaryInstruction(
-        current_func,
-        IRInstOperator::IRINST_OP_SUB_I,
-        val_a,
-        mulInst, // 使用上一步的 mulInst 作为源操作数
-        IntegerType::getTypeInt() // 假设减法/取模结果是 i32
-    );
-    node->blockInsts.addInst(modInst);
-    current_func->addTempVar(modInst); // <--- 重要：将最终的 modInst (即 sub 指令) 注册为临时变量
+    // 使用上一步的 mulInst 作为源操作数，最终的 modInst (即 sub 指令) 同样注册为临时变量
+    BinaryInstruction* modInst = builder.createBinary(IRInstOperator::IRINST_OP_SUB_I, val_a, mulInst, IntegerType::getTypeInt());
 
     // 设置当前 AST 节点 (AST_OP_MOD) 的值为最终的取模结果指令
-    node->val = modInst;
+    nodeValue(node) = modInst;
 
     return true;
 }
@@ -654,42 +870,52 @@ bool IRGenerator::ir_neg(ast_node * node) {
         return false;
     }
     ast_node * src1_node = node->sons[0];
-    std::cerr << "[IR_NEG_TRACE] Visiting operand for NEG. Operand AST node type: " << static_cast<int>(src1_node->node_type) << std::endl;
-    ast_node * src1 = ir_visit_ast_node(src1_node);
-
-    if (!src1) {
-        std::cerr << "[IR_NEG_FAIL] ir_visit_ast_node(src1_node) returned nullptr." << std::endl;
-        minic_log(LOG_ERROR, "Operand of NEG: visiting child node failed.");
-        return false;
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::cerr << "[IR_NEG_TRACE] Visiting operand for NEG. Operand AST node type: " << static_cast<int>(src1_node->node_type) << std::endl;
     }
-    if (!src1->val) {
+
+    // 操作数已由ir_visit_ast_node翻译
+    ast_node * src1 = src1_node;
+    if (!nodeValue(src1)) {
         std::cerr << "[IR_NEG_FAIL] src1->val is nullptr after visiting child. Child AST node type was: " << static_cast<int>(src1_node->node_type) << std::endl;
         minic_log(LOG_ERROR, "Operand of NEG is null after visiting child (node->val is null).");
         return false;
     }
-    appendInstructionsToNode(node, src1->blockInsts);
 
-    Value* operand_val = src1->val;
+    Value* operand_val = nodeValue(src1);
+
+    // 常量取负直接得到结果常量
+    if (ConstInt * folded = fold_neg(operand_val)) {
+        nodeValue(node) = folded;
+        return true;
+    }
+
     Type* operand_type = operand_val->getType();
     if (!operand_type) {
         std::cerr << "[IR_NEG_FAIL] Operand of NEG has a null type. Operand IRName: " << operand_val->getIRName() << std::endl;
         minic_log(LOG_ERROR, "Operand of NEG has a null type.");
         return false;
+        std::cerr << "[IR_NEG_TRACE] Operand for NEG has type: " << operand_type->toString() << " (IRName: " << operand_val->getIRName() << ")" << std::endl;
     }
-    std::cerr << "[IR_NEG_TRACE] Operand for NEG has type: " << operand_type->toString() << " (IRName: " << operand_val->getIRName() << ")" << std::endl;
 
     Type* neg_result_type = nullptr;
 
     if (operand_type->isIntegerType()) {
         IntegerType* int_operand_type = static_cast<IntegerType*>(operand_type);
         int bitwidth = int_operand_type->getBitWidth();
-        std::cerr << "[IR_NEG_TRACE] Operand is IntegerType with bitwidth: " << bitwidth << std::endl;
+        if (minic_log_enabled(LOG_DEBUG)) {
+            std::cerr << "[IR_NEG_TRACE] Operand is IntegerType with bitwidth: " << bitwidth << std::endl;
+        }
 
         if (bitwidth == 32) {
-            std::cerr << "[IR_NEG_TRACE] Operand is i32. Setting result type to i32." << std::endl;
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[IR_NEG_TRACE] Operand is i32. Setting result type to i32." << std::endl;
+            }
             neg_result_type = IntegerType::getTypeInt();
         } else if (bitwidth == 1) {
-            std::cerr << "[IR_NEG_TRACE] Operand is i1. Setting result type to i32." << std::endl;
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[IR_NEG_TRACE] Operand is i1. Setting result type to i32." << std::endl;
+            }
             neg_result_type = IntegerType::getTypeInt();
         } else {
             std::cerr << "[IR_NEG_FAIL] Operand of NEG is an integer type with unsupported bitwidth: " << bitwidth << std::endl;
@@ -706,20 +932,15 @@ bool IRGenerator::ir_neg(ast_node * node) {
         std::cerr << "[IR_NEG_FAIL] neg_result_type is unexpectedly null." << std::endl;
         minic_log(LOG_ERROR, "NEG: Failed to determine result type.");
         return false;
+        std::cerr << "[IR_NEG_TRACE] Determined neg_result_type: " << neg_result_type->toString() << std::endl;
     }
-    std::cerr << "[IR_NEG_TRACE] Determined neg_result_type: " << neg_result_type->toString() << std::endl;
 
-    UnaryInstruction * negInst = new UnaryInstruction(
-        module->getCurrentFunction(),
-        IRInstOperator::IRINST_OP_NEG_I,
-        operand_val, // 使用 operand_val 而不是 src1->val 以确保一致性
-        neg_result_type
-    );
-    
-    node->blockInsts.addInst(negInst);
-    module->getCurrentFunction()->addTempVar(negInst);
-    node->val = negInst;
-    std::cerr << "[IR_NEG_SUCCESS] Successfully processed NEG. node->val set to " << negInst->getIRName() << " (type " << negInst->getType()->toString() << ")" << std::endl;
+    // 使用 operand_val 而不是 src1->val 以确保一致性
+    UnaryInstruction * negInst = builder.createUnary(IRInstOperator::IRINST_OP_NEG_I, operand_val, neg_result_type);
+    nodeValue(node) = negInst;
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::cerr << "[IR_NEG_SUCCESS] Successfully processed NEG. node->val set to " << negInst->getIRName() << " (type " << negInst->getType()->toString() << ")" << std::endl;
+    }
     return true;
 }
 /// @brief 赋值AST节点翻译成线性中间IR
@@ -730,34 +951,17 @@ bool IRGenerator::ir_assign(ast_node * node)
     ast_node * son1_node = node->sons[0];
     ast_node * son2_node = node->sons[1];
 
-    // 赋值节点，自右往左运算
-
-    // 赋值运算符的左侧操作数
-    ast_node * left = ir_visit_ast_node(son1_node);
-    if (!left) {
-        // 某个变量没有定值
-        // 这里缺省设置变量不存在则创建，因此这里不会错误
-        return false;
-    }
-
-    // 赋值运算符的右侧操作数
-    ast_node * right = ir_visit_ast_node(son2_node);
-    if (!right) {
-        // 某个变量没有定值
-        return false;
-    }
+    // 赋值节点，自右往左运算，左右两侧已由ir_visit_ast_node翻译
+    ast_node * left = son1_node;
+    ast_node * right = son2_node;
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    MoveInstruction * movInst = new MoveInstruction(module->getCurrentFunction(), left->val, right->val);
-
-    // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(movInst);
+    // 两侧的指令已在前面产生，这里只产生赋值指令
+    MoveInstruction * movInst = builder.createMove(nodeValue(left), nodeValue(right));
 
     // 这里假定赋值的类型是一致的
-    node->val = movInst;
+    nodeValue(node) = movInst;
 
     return true;
 }
@@ -772,15 +976,8 @@ bool IRGenerator::ir_return(ast_node * node)
     // return语句可能没有没有表达式，也可能有，因此这里必须进行区分判断
     if (!node->sons.empty()) {
 
-        ast_node * son_node = node->sons[0];
-
-        // 返回的表达式的指令保存在right节点中
-        right = ir_visit_ast_node(son_node);
-        if (!right) {
-
-            // 某个变量没有定值
-            return false;
-        }
+        // 返回的表达式已由ir_visit_ast_node翻译，指令已经产生
+        right = node->sons[0];
     }
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
@@ -789,16 +986,13 @@ bool IRGenerator::ir_return(ast_node * node)
     // 返回值存在时则移动指令到node中
     if (right) {
 
-        // 创建临时变量保存IR的值，以及线性IR指令
-        node->blockInsts.addInst(right->blockInsts);
-
         // 返回值赋值到函数返回值变量上，然后跳转到函数的尾部
-        node->blockInsts.addInst(new MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
+        builder.createMove(currentFunc->getReturnValue(), nodeValue(right));
 
-        node->val = right->val;
+        nodeValue(node) = nodeValue(right);
     } else {
         // 没有返回值
-        node->val = nullptr;
+        nodeValue(node) = nullptr;
     }
     Instruction* exit_instruction_base_ptr = currentFunc->getExitLabel();
 
@@ -808,13 +1002,13 @@ bool IRGenerator::ir_return(ast_node * node)
     }
 
     // 安全地转换为 LabelInstruction*
-    LabelInstruction* exit_label_derived_ptr = dynamic_cast<LabelInstruction*>(exit_instruction_base_ptr);
+    LabelInstruction* exit_label_derived_ptr = dyn_cast<LabelInstruction>(exit_instruction_base_ptr);
 
     if (exit_label_derived_ptr) {
         // 跳转到函数的尾部出口指令上
-        node->blockInsts.addInst(new GotoInstruction(currentFunc, exit_label_derived_ptr)); // <--- 传递正确的 LabelInstruction*
+        builder.createGoto(exit_label_derived_ptr); // <--- 传递正确的 LabelInstruction*
     } else {
-        // 如果 dynamic_cast 失败，说明 getExitLabel() 返回的不是一个 LabelInstruction
+        // 如果 dyn_cast 失败，说明 getExitLabel() 返回的不是一个 LabelInstruction
         // 这通常意味着在 ir_function_define 中设置出口标签时逻辑有误
         minic_log(LOG_ERROR, "Function @%s exit label is not a LabelInstruction (type mismatch)!", currentFunc->getName().c_str());
         return false; // 或者其他错误处理方式
@@ -846,7 +1040,7 @@ bool IRGenerator::ir_leaf_node_var_id(ast_node * node)
 
     val = module->findVarValue(node->name);
 
-    node->val = val;
+    nodeValue(node) = val;
 
     return true;
 }
@@ -862,7 +1056,7 @@ bool IRGenerator::ir_leaf_node_uint(ast_node * node)
     // 新建一个整数常量Value
     val = module->newConstInt((int32_t) node->integer_val);
 
-    node->val = val;
+    nodeValue(node) = val;
 
     return true;
 }
@@ -881,16 +1075,14 @@ bool IRGenerator::ir_declare_statment(ast_node * decl_stmt_node) {
         return false;
     }
 
-    // AST_OP_DECL_STMT 节点的 blockInsts 将收集所有由其子声明（包括初始化）产生的指令
-    decl_stmt_node->blockInsts.clear(); // 清空，确保从头开始收集
-
+    // 子声明（包括初始化）产生的指令由builder按次序加入当前函数
     bool all_children_processed_successfully = true;
     for (ast_node* single_var_decl_node : decl_stmt_node->sons) {
         if (single_var_decl_node && single_var_decl_node->node_type == ast_operator_type::AST_OP_VAR_DECL) {
             // 将 decl_stmt_node 传递下去，以便初始化产生的指令可以附加到它上面
             if (!ir_variable_declare_single(single_var_decl_node, decl_stmt_node)) { // 调用新的辅助函数
                 minic_log(LOG_ERROR, "IRGenerator: Failed to process a VAR_DECL child (Name: %s) of DECL_STMT.",
-                          single_var_decl_node->sons[1]->node_type == ast_operator_type::AST_OP_LEAF_VAR_ID ? single_var_decl_node->sons[1]->name.c_str() : single_var_decl_node->sons[1]->sons[0]->name.c_str() );
+                          symbol_name(single_var_decl_node->sons[1]->node_type == ast_operator_type::AST_OP_LEAF_VAR_ID ? single_var_decl_node->sons[1]->name : single_var_decl_node->sons[1]->sons[0]->name).c_str());
                 all_children_processed_successfully = false;
                 break; // 如果一个声明失败，通常整个声明语句都失败
             }
@@ -903,14 +1095,14 @@ bool IRGenerator::ir_declare_statment(ast_node * decl_stmt_node) {
     }
     
     // AST_OP_DECL_STMT 本身不产生一个可运行的 Value，它的效果是声明变量和执行初始化（指令已收集）
-    decl_stmt_node->val = nullptr; 
+    nodeValue(decl_stmt_node) = nullptr; 
     return all_children_processed_successfully;
 }
 
 /// @brief 单个变量声明节点翻译成线性中间IR (处理单个变量声明，可能带初始化)
 ///        这个函数现在是 ir_declare_statment 的辅助函数。
 /// @param var_decl_node AST节点 (类型为 AST_OP_VAR_DECL)
-/// @param parent_decl_stmt_node 父节点 (类型为 AST_OP_DECL_STMT)，用于附加生成的指令
+/// @param parent_decl_stmt_node 父节点 (类型为 AST_OP_DECL_STMT)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node * parent_decl_stmt_node) {
     minic_log(LOG_DEBUG, "IRGenerator: Visiting single AST_OP_VAR_DECL (Ptr: %p).", (void*)var_decl_node);
@@ -935,37 +1127,38 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
     Function* current_func = module->getCurrentFunction(); // 用于区分全局/局部
 
     Value* created_variable = nullptr; // 将会是 LocalVariable* 或 GlobalVariable*
-    std::string variable_name;
+    SymbolId variable_id = SYMBOL_NONE;
     ast_node* expr_init_node = nullptr; // 初始化表达式节点 (如果存在)
 
     // 1. 提取变量名并确定是否有初始化表达式
     if (var_def_node->node_type == ast_operator_type::AST_OP_LEAF_VAR_ID) {
-        variable_name = var_def_node->name;
-        var_decl_node->val = created_variable; // 让 VAR_DECL 指向其 VarDef (ID)
+        variable_id = var_def_node->name;
+        nodeValue(var_decl_node) = created_variable; // 让 VAR_DECL 指向其 VarDef (ID)
     } else if (var_def_node->node_type == ast_operator_type::AST_OP_INIT) {
         if (var_def_node->sons.size() < 2 || !var_def_node->sons[0] || var_def_node->sons[0]->node_type != ast_operator_type::AST_OP_LEAF_VAR_ID) {
             minic_log(LOG_ERROR, "IRGenerator (single): AST_OP_INIT node has invalid structure.");
             return false;
         }
-        variable_name = var_def_node->sons[0]->name;
+        variable_id = var_def_node->sons[0]->name;
         expr_init_node = var_def_node->sons[1];
-        var_decl_node->val = created_variable; // 让 VAR_DECL 指向其 VarDef (INIT)
+        nodeValue(var_decl_node) = created_variable; // 让 VAR_DECL 指向其 VarDef (INIT)
     } else {
         minic_log(LOG_ERROR, "IRGenerator (single): Unexpected node type '%d' for VarDef under AST_OP_VAR_DECL.", (int)var_def_node->node_type);
         return false;
     }
 
-    if (variable_name.empty()) {
+    if (variable_id == SYMBOL_NONE) {
         minic_log(LOG_ERROR, "IRGenerator (single): Variable name is empty for declaration.");
         return false;
     }
+    const std::string & variable_name = symbol_name(variable_id);
     minic_log(LOG_DEBUG, "  IRGenerator (single): Processing declaration for '%s' (type: %s).", 
               variable_name.c_str(), declared_type->toString().c_str());
 
     // 2. 检查重定义并创建变量对象 (Local or Global)
     if (current_func) {
         // 局部变量
-        if (module->getScopeStack()->findCurrentScope(variable_name)) {
+        if (module->getScopeStack()->findCurrentScope(variable_id)) {
             minic_log(LOG_ERROR, "    IRGenerator (single): Local variable '%s' redefinition in function '%s'.", variable_name.c_str(), current_func->getName().c_str());
             return false;
         }
@@ -977,11 +1170,11 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
         minic_log(LOG_DEBUG, "    IRGenerator (single): Created LocalVariable '%s' (IR: '%s').", created_variable->getName().c_str(), created_variable->getIRName().c_str());
     } else {
         // 全局变量
-        if (module->findGlobalVariable(variable_name) || module->getScopeStack()->findCurrentScope(variable_name) /* 假设当前是全局作用域 */) {
+        if (module->findGlobalVariable(variable_id) || module->getScopeStack()->findCurrentScope(variable_id) /* 假设当前是全局作用域 */) {
             minic_log(LOG_ERROR, "    IRGenerator (single): Global variable '%s' redefinition.", variable_name.c_str());
             return false;
         }
-        created_variable = module->newGlobalVariable(declared_type, variable_name); // newGlobalVariable 应该将其加入 Module 的全局列表
+        created_variable = module->newGlobalVariable(declared_type, variable_id); // newGlobalVariable 应该将其加入 Module 的全局列表
         if (!created_variable) {
             minic_log(LOG_ERROR, "    IRGenerator (single): Failed to create GlobalVariable '%s'.", variable_name.c_str());
             return false;
@@ -991,10 +1184,10 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
     
     // 将创建的 Value 对象设置回 AST 相关节点，方便调试或后续步骤
     if (var_def_node->node_type == ast_operator_type::AST_OP_LEAF_VAR_ID) {
-        var_def_node->val = created_variable;
+        nodeValue(var_def_node) = created_variable;
     } else { // AST_OP_INIT
-        var_def_node->sons[0]->val = created_variable; // ID 节点
-        var_def_node->val = created_variable;          // INIT 节点本身也指向，可选
+        nodeValue(var_def_node->sons[0]) = created_variable; // ID 节点
+        nodeValue(var_def_node) = created_variable;          // INIT 节点本身也指向，可选
     }
     // var_decl_node->val 之前在上面已设置指向 VarDef 节点，这里不再覆盖为 Value*
     // 或者你也可以选择让 var_decl_node->val 直接指向 created_variable
@@ -1002,7 +1195,7 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
     // 3. 将变量添加到 ScopeStack
     if (module && module->getScopeStack()) {
         // findCurrentScope 已经在上面用于重定义检查，这里直接插入
-        module->getScopeStack()->insertValue(created_variable); // 假设 insertValue(Value*) 总是插入到当前作用域
+        module->getScopeStack()->insertValue(variable_id, created_variable); // 插入到当前作用域
         minic_log(LOG_DEBUG, "    IRGenerator (single): Added '%s' (IR: '%s') to ScopeStack level %d.",
                   variable_name.c_str(), created_variable->getIRName().c_str(), module->getScopeStack()->getCurrentScopeLevel());
     } else {
@@ -1017,28 +1210,22 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
         
         ast_node* visited_expr_node = ir_visit_ast_node(expr_init_node); 
         
-        if (!visited_expr_node || !visited_expr_node->val) { 
+        if (!visited_expr_node || !nodeValue(visited_expr_node)) { 
             minic_log(LOG_ERROR, "    IRGenerator (single): Failed to visit or get value from RHS expression for '%s'.", variable_name.c_str());
             return false; 
         }
         
-        // 将初始化表达式产生的指令附加到父 DECL_STMT 节点的 blockInsts
-        if (!visited_expr_node->blockInsts.getInsts().empty()) {
-            parent_decl_stmt_node->blockInsts.addInst(visited_expr_node->blockInsts);
-        }
-        
-        Value* rhs_init_value = visited_expr_node->val;
+        Value* rhs_init_value = nodeValue(visited_expr_node);
 
         if (current_func) {
             // 局部变量初始化: 生成 Move 指令
             minic_log(LOG_DEBUG, "    IRGenerator (single): Creating MoveInstruction for local INIT: %s = %s",
                       created_variable->getIRName().c_str(), rhs_init_value->getIRName().c_str());
-            MoveInstruction* movInst = new MoveInstruction(current_func, created_variable, rhs_init_value);
-            parent_decl_stmt_node->blockInsts.addInst(movInst);
+            builder.createMove(created_variable, rhs_init_value);
         } else {
             // 全局变量初始化
             GlobalVariable* gv = static_cast<GlobalVariable*>(created_variable);
-            Constant* const_init_val = dynamic_cast<Constant*>(rhs_init_value);
+            Constant* const_init_val = dyn_cast_or_null<Constant>(rhs_init_value);
             if (const_init_val) {
                 // 检查类型是否匹配，或者是否可以安全转换
                 // 例如，如果全局变量是 i32，初始值也应该是 i32 常量
@@ -1064,8 +1251,8 @@ bool IRGenerator::ir_variable_declare_single(ast_node * var_decl_node, ast_node
 
 // 辅助函数：创建新的唯一标签
 LabelInstruction* IRGenerator::newLabel() {
-    std::string label_ir_name = ".L" + std::to_string(label_counter_++); // 例如 ".L0"
-    return new LabelInstruction(getCurrentFunction(), label_ir_name);
+    Function * func = getCurrentFunction();
+    return func->getArena().create<LabelInstruction>(func, label_counter_++);
 }
 
 // 辅助函数：获取当前函数
@@ -1073,29 +1260,6 @@ Function* IRGenerator::getCurrentFunction() {
     return module->getCurrentFunction();
 }
 
-/* // 如果需要，可以取消注释并实现这些辅助函数
-// 辅助函数：将指令添加到当前函数
-void IRGenerator::addInstructionToCurrentFunction(Instruction* inst) {
-    if (getCurrentFunction() && inst) {
-        getCurrentFunction()->getInterCode().addInst(inst);
-    }
-}
-*/
-
-// 辅助函数：将指令添加到指定AST节点的指令列表 (blockInsts)
-void IRGenerator::addInstructionToNode(ast_node* node, Instruction* inst) {
-    if (node && inst) {
-        node->blockInsts.addInst(inst);
-    }
-}
-
-// 辅助函数：将一个指令列表 (InterCode) 追加到指定AST节点的指令列表
-void IRGenerator::appendInstructionsToNode(ast_node* node, InterCode& instructions) {
-    if (node) {
-        node->blockInsts.addInst(instructions); // 假设 InterCode 有 addInst(InterCode&) 或类似方法
-    }
-}
-
 
 // 用于条件上下文的访问器
 // 本函数假设当 'node' 的结果被用来控制一个分支时被调用。
@@ -1103,7 +1267,7 @@ void IRGenerator::appendInstructionsToNode(ast_node* node, InterCode& instructio
 bool IRGenerator::ir_visit_conditional_node(ast_node* node, LabelInstruction* true_label, LabelInstruction* false_label) {
     if (!node || !true_label || !false_label) return false;
 
-    node->val = nullptr;
+    nodeValue(node) = nullptr;
 
     switch (node->node_type) {
         case ast_operator_type::AST_OP_LT:
@@ -1122,9 +1286,11 @@ bool IRGenerator::ir_visit_conditional_node(ast_node* node, LabelInstruction* tr
             return ir_logical_not(node, true_label, false_label);
 
         default: {
-            std::cerr << "[COND_NODE_DEFAULT_TRACE] Entered default case for AST node type: "
-                      << static_cast<int>(node->node_type)
-                      << " (processing as a value-condition)" << std::endl;
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[COND_NODE_DEFAULT_TRACE] Entered default case for AST node type: "
+                          << static_cast<int>(node->node_type)
+                          << " (processing as a value-condition)" << std::endl;
+            }
 
             // 步骤 1: 访问节点以获取其计算值和产生的指令
             ast_node* visited_node = ir_visit_ast_node(node);
@@ -1136,57 +1302,24 @@ bool IRGenerator::ir_visit_conditional_node(ast_node* node, LabelInstruction* tr
                 minic_log(LOG_ERROR, "Default conditional: visited_node is null after ir_visit_ast_node.");
                 return false;
             }
-            if (!visited_node->val) {
+            if (!nodeValue(visited_node)) {
                 std::cerr << "[COND_NODE_DEFAULT_FAIL] visited_node->val is nullptr. AST Node type was: "
                           << static_cast<int>(node->node_type) << std::endl;
                 minic_log(LOG_ERROR, "Default conditional: visited_node->val is null after ir_visit_ast_node.");
                 return false;
             }
 
-            // 步骤 2: 将子表达式（visited_node）产生的指令追加到当前条件节点（node）的指令列表中
-            // 这些指令是计算 cond_val (即 visited_node->val) 所必需的
-            std::cerr << "[COND_NODE_DEFAULT_TRACE] Appending instructions from visited_node (type "
-                      << static_cast<int>(visited_node->node_type) << ", val "
-                      << (visited_node->val ? visited_node->val->getIRName() : "null_val")
-                      << ") into current conditional node (type " << static_cast<int>(node->node_type) << ")" << std::endl;
-
-            // --- 调试打印 visited_node->blockInsts 的内容 ---
-            std::cerr << "    --- Instructions in visited_node->blockInsts (BEFORE append): ---" << std::endl;
-            if (visited_node->blockInsts.getInsts().empty()) { // 假设 getInsts() 返回 const std::vector<Instruction*>&
-                 std::cerr << "        (empty)" << std::endl;
-            } else {
-                for (const auto& inst_in_visited : visited_node->blockInsts.getInsts()) {
-                    if (inst_in_visited) {
-                        std::cerr << "        " << inst_in_visited->toString() << std::endl;
-                    } else {
-                        std::cerr << "        (null instruction in visited_node->blockInsts)" << std::endl;
-                    }
-                }
-            }
-            std::cerr << "    --- End of instructions in visited_node->blockInsts ---" << std::endl;
-            // --- 调试打印结束 ---
-
-            
+            // 步骤 2: 计算 cond_val (即 visited_node->val) 所需的指令已由builder产生
 
-            // --- 调试打印追加后的 node->blockInsts 的内容 ---
-            std::cerr << "    --- Instructions in current node->blockInsts (AFTER append): ---" << std::endl;
-             if (node->blockInsts.getInsts().empty()) {
-                 std::cerr << "        (empty)" << std::endl;
-            } else {
-                for (const auto& inst_in_current : node->blockInsts.getInsts()) {
-                    if (inst_in_current) {
-                        std::cerr << "        " << inst_in_current->toString() << std::endl;
-                    } else {
-                        std::cerr << "        (null instruction in current node->blockInsts after append)" << std::endl;
-                    }
-                }
+            // 常量条件直接跳转到确定的出口，-O1以上有效
+            int32_t const_cond;
+            if (optLevel >= 1 && const_int_value(nodeValue(visited_node), const_cond)) {
+                builder.createGoto(const_cond != 0 ? true_label : false_label);
+                return true;
             }
-            std::cerr << "    --- End of instructions in current node->blockInsts ---" << std::endl;
-            // --- 调试打印结束 ---
-
 
             // 步骤 3: 获取计算出的条件值及其类型
-            Value* cond_val = visited_node->val; // cond_val 现在是表达式 node 的计算结果 (例如 -!!!a 的结果)
+            Value* cond_val = nodeValue(visited_node); // cond_val 现在是表达式 node 的计算结果 (例如 -!!!a 的结果)
             Type* cond_type = cond_val->getType();
 
             if (!cond_type) {
@@ -1194,42 +1327,50 @@ bool IRGenerator::ir_visit_conditional_node(ast_node* node, LabelInstruction* tr
                           << cond_val->getIRName() << std::endl;
                 minic_log(LOG_ERROR, "Default conditional: cond_val has null type.");
                 return false;
+                std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_val (result of visited_node) type: "
+                          << cond_type->toString() << " (IRName: " << cond_val->getIRName() << ")" << std::endl;
+                std::cerr << "[COND_NODE_DEFAULT_TRACE] Checking cond_type->isInt32Type(): "
+                          << (cond_type->isInt32Type() ? "true" : "false") << std::endl;
+                std::cerr << "[COND_NODE_DEFAULT_TRACE] Checking cond_type->isInt1Byte(): "
+                          << (cond_type->isInt1Byte() ? "true" : "false") << std::endl;
             }
-            std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_val (result of visited_node) type: "
-                      << cond_type->toString() << " (IRName: " << cond_val->getIRName() << ")" << std::endl;
-            std::cerr << "[COND_NODE_DEFAULT_TRACE] Checking cond_type->isInt32Type(): "
-                      << (cond_type->isInt32Type() ? "true" : "false") << std::endl;
-            std::cerr << "[COND_NODE_DEFAULT_TRACE] Checking cond_type->isInt1Byte(): "
-                      << (cond_type->isInt1Byte() ? "true" : "false") << std::endl;
 
 
             // 步骤 4: 根据条件值的类型生成相应的比较和分支指令
             if (cond_type->isInt32Type()) {
-                std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_type is i32. Creating Cmp NE with zero." << std::endl;
+                if (minic_log_enabled(LOG_DEBUG)) {
+                    std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_type is i32. Creating Cmp NE with zero." << std::endl;
+                }
                 Value* zero_i32 = module->newConstInt(0); // 默认 i32 类型
                 Value* temp_i1_result = module->newTemporary(IntegerType::getTypeBool(), "cond_bool_res"); // 存储比较结果的 i1 临时变量
 
                 if (!zero_i32 || !temp_i1_result) {
                      std::cerr << "[COND_NODE_DEFAULT_FAIL] Failed to create zero_i32 or temp_i1_result." << std::endl;
                      return false;
+                    std::cerr << "[COND_NODE_DEFAULT_TRACE] zero_i32 IRName: " << zero_i32->getIRName() << std::endl;
+                    std::cerr << "[COND_NODE_DEFAULT_TRACE] temp_i1_result IRName: " << temp_i1_result->getIRName()
+                              << ", Type: " << temp_i1_result->getType()->toString() << std::endl;
                 }
-                std::cerr << "[COND_NODE_DEFAULT_TRACE] zero_i32 IRName: " << zero_i32->getIRName() << std::endl;
-                std::cerr << "[COND_NODE_DEFAULT_TRACE] temp_i1_result IRName: " << temp_i1_result->getIRName()
-                          << ", Type: " << temp_i1_result->getType()->toString() << std::endl;
 
 
-                addInstructionToNode(node, new CmpInstruction(temp_i1_result, CmpInstruction::NE, cond_val, zero_i32, getCurrentFunction()));
-                addInstructionToNode(node, new BranchConditionalInstruction(temp_i1_result, true_label, false_label, getCurrentFunction()));
+                builder.createCmp(temp_i1_result, CmpInstruction::NE, cond_val, zero_i32);
+                builder.createCondBranch(temp_i1_result, true_label, false_label);
                 
-                std::cerr << "[COND_NODE_DEFAULT_SUCCESS] Processed i32 condition. Generated: "
-                          << temp_i1_result->getIRName() << " = icmp ne " << cond_val->getIRName() << ", " << zero_i32->getIRName()
-                          << "; then bc " << temp_i1_result->getIRName() << ", ..." << std::endl;
+                if (minic_log_enabled(LOG_DEBUG)) {
+                    std::cerr << "[COND_NODE_DEFAULT_SUCCESS] Processed i32 condition. Generated: "
+                              << temp_i1_result->getIRName() << " = icmp ne " << cond_val->getIRName() << ", " << zero_i32->getIRName()
+                              << "; then bc " << temp_i1_result->getIRName() << ", ..." << std::endl;
+                }
                 return true;
 
             } else if (cond_type->isInt1Byte()) {
-                std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_type is i1. Creating direct BranchConditional." << std::endl;
-                addInstructionToNode(node, new BranchConditionalInstruction(cond_val, true_label, false_label, getCurrentFunction()));
-                std::cerr << "[COND_NODE_DEFAULT_SUCCESS] Processed i1 condition. Generated: bc " << cond_val->getIRName() << ", ..." << std::endl;
+                if (minic_log_enabled(LOG_DEBUG)) {
+                    std::cerr << "[COND_NODE_DEFAULT_TRACE] cond_type is i1. Creating direct BranchConditional." << std::endl;
+                }
+                builder.createCondBranch(cond_val, true_label, false_label);
+                if (minic_log_enabled(LOG_DEBUG)) {
+                    std::cerr << "[COND_NODE_DEFAULT_SUCCESS] Processed i1 condition. Generated: bc " << cond_val->getIRName() << ", ..." << std::endl;
+                }
                 return true;
 
             } else {
@@ -1246,21 +1387,14 @@ bool IRGenerator::ir_visit_conditional_node(ast_node* node, LabelInstruction* tr
 
 // 处理关系运算符
 bool IRGenerator::ir_relational_op(ast_node * node, LabelInstruction* true_label, LabelInstruction* false_label) {
-    node->blockInsts.clear(); // 每个处理器开始时清空当前节点的指令列表 (或者不由它收集，而是返回 InterCode)
     ast_node* left_child = node->sons[0];
     ast_node* right_child = node->sons[1];
 
-	if (!ir_visit_ast_node(left_child) || !left_child->val) return false;
-	if (!ir_visit_ast_node(right_child) || !right_child->val) return false;
-
-	appendInstructionsToNode(node, left_child->blockInsts);
-	appendInstructionsToNode(node, right_child->blockInsts);
+	if (!ir_visit_ast_node(left_child) || !nodeValue(left_child)) return false;
+	if (!ir_visit_ast_node(right_child) || !nodeValue(right_child)) return false;
 
-	Value* lhs_val = left_child->val;
-	Value* rhs_val = right_child->val;
-
-	// Value* cmp_result_temp = module->newTemporary(IRType::getI1Type()); // 使用你的类型系统
-	Value* cmp_result_temp = module->newTemporary(IntegerType::get(1)); // 获取 i1 类型
+	Value* lhs_val = nodeValue(left_child);
+	Value* rhs_val = nodeValue(right_child);
 
 	CmpInstruction::CmpOp cmp_op_enum; // 使用新指令定义的枚举
 	switch (node->node_type) {
@@ -1273,46 +1407,48 @@ bool IRGenerator::ir_relational_op(ast_node * node, LabelInstruction* true_label
 		default: return false;
 	}
 
-	addInstructionToNode(node, new CmpInstruction(cmp_result_temp, cmp_op_enum, lhs_val, rhs_val, getCurrentFunction()));
-	addInstructionToNode(node, new BranchConditionalInstruction(cmp_result_temp, true_label, false_label, getCurrentFunction()));
+	// 两侧都是常量时比较结果确定，直接跳转到对应的出口
+	bool taken;
+	if (fold_compare(cmp_op_enum, lhs_val, rhs_val, taken)) {
+		builder.createGoto(taken ? true_label : false_label);
+		return true;
+	}
+
+	// Value* cmp_result_temp = module->newTemporary(IRType::getI1Type()); // 使用你的类型系统
+	Value* cmp_result_temp = module->newTemporary(IntegerType::get(1)); // 获取 i1 类型
+
+	builder.createCmp(cmp_result_temp, cmp_op_enum, lhs_val, rhs_val);
+	builder.createCondBranch(cmp_result_temp, true_label, false_label);
 	return true;
 }
 // 处理逻辑与 &&
 bool IRGenerator::ir_logical_and(ast_node * node, LabelInstruction* true_label, LabelInstruction* false_label) {
-    node->blockInsts.clear();
     ast_node* expr1 = node->sons[0];
     ast_node* expr2 = node->sons[1];
     LabelInstruction* eval_expr2_label = newLabel();
 
     if (!ir_visit_conditional_node(expr1, eval_expr2_label, false_label)) return false;
-    appendInstructionsToNode(node, expr1->blockInsts);
-    addInstructionToNode(node, eval_expr2_label);
+    builder.insert(eval_expr2_label);
     if (!ir_visit_conditional_node(expr2, true_label, false_label)) return false;
-    appendInstructionsToNode(node, expr2->blockInsts);
     return true;
 }
 
 // 处理逻辑或 ||
 bool IRGenerator::ir_logical_or(ast_node * node, LabelInstruction* true_label, LabelInstruction* false_label) {
-    node->blockInsts.clear();
     ast_node* expr1 = node->sons[0];
     ast_node* expr2 = node->sons[1];
     LabelInstruction* eval_expr2_label = newLabel();
 
     if (!ir_visit_conditional_node(expr1, true_label, eval_expr2_label)) return false;
-    appendInstructionsToNode(node, expr1->blockInsts);
-    addInstructionToNode(node, eval_expr2_label);
+    builder.insert(eval_expr2_label);
     if (!ir_visit_conditional_node(expr2, true_label, false_label)) return false;
-    appendInstructionsToNode(node, expr2->blockInsts);
     return true;
 }
 
 // 处理逻辑非 !
 bool IRGenerator::ir_logical_not(ast_node * node, LabelInstruction* true_label, LabelInstruction* false_label) {
-    node->blockInsts.clear();
     ast_node* expr = node->sons[0];
     if (!ir_visit_conditional_node(expr, true_label, false_label)) return false;
-    appendInstructionsToNode(node, expr->blockInsts);
     return true;
 }
 
@@ -1336,35 +1472,29 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
         return false;
     }
 
-    std::cerr << "[LNOT_EXPR_TRACE] Visiting operand for LNOT. Operand AST node type: " << static_cast<int>(operand_node_ptr->node_type) << std::endl;
-    ast_node* visited_operand_node = ir_visit_ast_node(operand_node_ptr);
-
-    if (!visited_operand_node) {
-        std::cerr << "[LNOT_EXPR_FAIL] ir_visit_ast_node(operand_node) returned nullptr." << std::endl;
-        minic_log(LOG_ERROR, "LNOT expression: Failed to visit operand node.");
-        return false;
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::cerr << "[LNOT_EXPR_TRACE] Visiting operand for LNOT. Operand AST node type: " << static_cast<int>(operand_node_ptr->node_type) << std::endl;
     }
-    if (!visited_operand_node->val) {
+
+    // 操作数已由ir_visit_ast_node翻译
+    ast_node* visited_operand_node = operand_node_ptr;
+    if (!nodeValue(visited_operand_node)) {
         std::cerr << "[LNOT_EXPR_FAIL] visited_operand_node->val is nullptr after visit. Operand AST node type was: " << static_cast<int>(operand_node_ptr->node_type) << std::endl;
         minic_log(LOG_ERROR, "LNOT expression: Failed to get value for LNOT operand.");
         return false;
     }
     
-    // 将子节点产生的指令追加到当前 LNOT 节点的指令列表中
-    // 只有在 operand_node_ptr 和 visited_operand_node 是同一个对象时，blockInsts 才有意义
-    // 通常 ir_visit_ast_node 返回的是其参数 node (除非出错返回 nullptr)
-    // 所以 operand_node_ptr->blockInsts 就是 visited_operand_node->blockInsts
-    appendInstructionsToNode(node, operand_node_ptr->blockInsts);
+    // 子节点的指令已由builder产生，这里只需要它的值
 
-    Value* operand_val = visited_operand_node->val; // 使用访问后的节点的 val
+    Value* operand_val = nodeValue(visited_operand_node); // 使用访问后的节点的 val
     Type* operand_type = operand_val->getType();
 
     if (!operand_type) {
         std::cerr << "[LNOT_EXPR_FAIL] Operand of LNOT has a null type. Operand IRName: " << operand_val->getIRName() << std::endl;
         minic_log(LOG_ERROR, "LNOT expression: Operand has a null type.");
         return false;
+        std::cerr << "[LNOT_EXPR_TRACE] Operand for LNOT has type: " << operand_type->toString() << " (IRName: " << operand_val->getIRName() << ")" << std::endl;
     }
-    std::cerr << "[LNOT_EXPR_TRACE] Operand for LNOT has type: " << operand_type->toString() << " (IRName: " << operand_val->getIRName() << ")" << std::endl;
 
     // 逻辑非的结果总是 i1 (布尔) 类型
     Value* result_i1_val = module->newTemporary(IntegerType::getTypeBool(), "lnot_res");
@@ -1372,27 +1502,37 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
          std::cerr << "[LNOT_EXPR_FATAL] Failed to create a valid i1 temporary for LNOT result." << std::endl;
          minic_log(LOG_ERROR, "LNOT expression: Failed to create i1 temporary for result.");
          return false; // 如果无法创建有效的i1临时变量
+        std::cerr << "[LNOT_EXPR_TRACE] Created temporary for LNOT result: " << result_i1_val->getIRName() << " type: " << result_i1_val->getType()->toString() << std::endl;
     }
-    std::cerr << "[LNOT_EXPR_TRACE] Created temporary for LNOT result: " << result_i1_val->getIRName() << " type: " << result_i1_val->getType()->toString() << std::endl;
 
 
     if (operand_type->isIntegerType()) {
         IntegerType* int_operand_type = static_cast<IntegerType*>(operand_type);
         int bitwidth = int_operand_type->getBitWidth();
-        std::cerr << "[LNOT_EXPR_TRACE] Operand is IntegerType with bitwidth: " << bitwidth << std::endl;
+        if (minic_log_enabled(LOG_DEBUG)) {
+            std::cerr << "[LNOT_EXPR_TRACE] Operand is IntegerType with bitwidth: " << bitwidth << std::endl;
+        }
 
         if (bitwidth == 32) {
-            std::cerr << "[LNOT_EXPR_TRACE] Operand is i32. Comparing with i32 zero." << std::endl;
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[LNOT_EXPR_TRACE] Operand is i32. Comparing with i32 zero." << std::endl;
+            }
             Value* zero_i32 = module->newConstInt(0); // 默认创建 i32 类型的0
             if(!zero_i32 || !zero_i32->getType()){ std::cerr<<"[LNOT_EXPR_FATAL] zero_i32 or its type is null"<<std::endl; return false;}
-            std::cerr << "[LNOT_EXPR_TRACE] zero_i32 type: " << zero_i32->getType()->toString() << std::endl;
-            addInstructionToNode(node, new CmpInstruction(result_i1_val, CmpInstruction::EQ, operand_val, zero_i32, getCurrentFunction()));
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[LNOT_EXPR_TRACE] zero_i32 type: " << zero_i32->getType()->toString() << std::endl;
+            }
+            builder.createCmp(result_i1_val, CmpInstruction::EQ, operand_val, zero_i32);
         } else if (bitwidth == 1) {
-            std::cerr << "[LNOT_EXPR_TRACE] Operand is i1. Comparing with i1 zero." << std::endl;
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[LNOT_EXPR_TRACE] Operand is i1. Comparing with i1 zero." << std::endl;
+            }
             Value* zero_i1 = module->newConstInt(0, IntegerType::getTypeBool()); // 明确创建 i1 类型的0
             if(!zero_i1 || !zero_i1->getType()){ std::cerr<<"[LNOT_EXPR_FATAL] zero_i1 or its type is null"<<std::endl; return false;}
-            std::cerr << "[LNOT_EXPR_TRACE] zero_i1 type: " << zero_i1->getType()->toString() << std::endl;
-            addInstructionToNode(node, new CmpInstruction(result_i1_val, CmpInstruction::EQ, operand_val, zero_i1, getCurrentFunction()));
+            if (minic_log_enabled(LOG_DEBUG)) {
+                std::cerr << "[LNOT_EXPR_TRACE] zero_i1 type: " << zero_i1->getType()->toString() << std::endl;
+            }
+            builder.createCmp(result_i1_val, CmpInstruction::EQ, operand_val, zero_i1);
         } else {
             std::cerr << "[LNOT_EXPR_FAIL] Operand of LNOT is an integer type with unsupported bitwidth: " << bitwidth << std::endl;
             minic_log(LOG_ERROR, "LNOT expression: Operand is an integer with unsupported bitwidth: %d", bitwidth);
@@ -1404,15 +1544,17 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
         return false;
     }
 
-    node->val = result_i1_val;
-    std::cerr << "[LNOT_EXPR_SUCCESS] Successfully processed LNOT. node->val set to " << node->val->getIRName() << " (type " << node->val->getType()->toString() << ")" << std::endl;
+    nodeValue(node) = result_i1_val;
+    if (minic_log_enabled(LOG_DEBUG)) {
+        std::cerr << "[LNOT_EXPR_SUCCESS] Successfully processed LNOT. node->val set to " << nodeValue(node)->getIRName() << " (type " << nodeValue(node)->getType()->toString() << ")" << std::endl;
+    }
     return true;
 }
 
 // 处理 if 语句
 // ir/Generator/IRGenerator.cpp
 /*bool IRGenerator::ir_if_statement(ast_node * node) {
-    node->blockInsts.clear();
+    blockInsts(node).clear();
 
     ast_node * cond_expr_node = node->sons[0];
     ast_node * then_block_node = node->sons[1];
@@ -1425,15 +1567,15 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
         LabelInstruction* after_if_label = newLabel();
 
         if (!ir_visit_conditional_node(cond_expr_node, then_entry_label, after_if_label)) return false;
-        appendInstructionsToNode(node, cond_expr_node->blockInsts);
+        appendInstructionsToNode(node, blockInsts(cond_expr_node));
 
         addInstructionToNode(node, then_entry_label);
         if (!ir_visit_ast_node(then_block_node)) return false;
-        appendInstructionsToNode(node, then_block_node->blockInsts);
+        appendInstructionsToNode(node, blockInsts(then_block_node));
 
         // 只在不是终结指令时跳转
-        if (!then_block_node->blockInsts.empty()) {
-            auto last = then_block_node->blockInsts.getLastInst();
+        if (!blockInsts(then_block_node).empty()) {
+            auto last = blockInsts(then_block_node).getLastInst();
             if (!last || !last->isTerminator()) {
                 addInstructionToNode(node, new GotoInstruction(current_func, after_if_label));
             }
@@ -1446,14 +1588,14 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
         LabelInstruction* end_if_label = newLabel();
 
         if (!ir_visit_conditional_node(cond_expr_node, then_entry_label, else_entry_label)) return false;
-        appendInstructionsToNode(node, cond_expr_node->blockInsts);
+        appendInstructionsToNode(node, blockInsts(cond_expr_node));
 
         addInstructionToNode(node, then_entry_label);
         if (!ir_visit_ast_node(then_block_node)) return false;
-        appendInstructionsToNode(node, then_block_node->blockInsts);
+        appendInstructionsToNode(node, blockInsts(then_block_node));
 
-        if (!then_block_node->blockInsts.empty()) {
-            auto last = then_block_node->blockInsts.getLastInst();
+        if (!blockInsts(then_block_node).empty()) {
+            auto last = blockInsts(then_block_node).getLastInst();
             if (!last || !last->isTerminator()) {
                 addInstructionToNode(node, new GotoInstruction(current_func, end_if_label));
             }
@@ -1461,10 +1603,10 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
 
         addInstructionToNode(node, else_entry_label);
         if (!ir_visit_ast_node(else_block_node)) return false;
-        appendInstructionsToNode(node, else_block_node->blockInsts);
+        appendInstructionsToNode(node, blockInsts(else_block_node));
 
-        if (!else_block_node->blockInsts.empty()) {
-            auto last = else_block_node->blockInsts.getLastInst();
+        if (!blockInsts(else_block_node).empty()) {
+            auto last = blockInsts(else_block_node).getLastInst();
             if (!last || !last->isTerminator()) {
                 addInstructionToNode(node, new GotoInstruction(current_func, end_if_label));
             }
@@ -1473,7 +1615,7 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
         addInstructionToNode(node, end_if_label);
     }
 
-    node->val = nullptr;
+    nodeValue(node) = nullptr;
     return true;
 }
 */
@@ -1481,7 +1623,6 @@ bool IRGenerator::ir_lnot_expression(ast_node * node) {
 // IRGenerator.cpp
 
 bool IRGenerator::ir_if_statement(ast_node * node) {
-    node->blockInsts.clear();
 
     ast_node * cond_expr_node = node->sons[0];
     ast_node * then_block_node = node->sons[1]; // 现在会用到这个
@@ -1496,7 +1637,7 @@ bool IRGenerator::ir_if_statement(ast_node * node) {
         minic_log(LOG_ERROR, "Function @%s has no exit label set!", current_func->getName().c_str());
         return false;
     }
-    LabelInstruction* merge_label_for_if = dynamic_cast<LabelInstruction*>(exit_label_inst_base);
+    LabelInstruction* merge_label_for_if = dyn_cast<LabelInstruction>(exit_label_inst_base);
     if (!merge_label_for_if && else_block_node) { // 如果有else, 我们需要一个if自己的合并点
         merge_label_for_if = newLabel(); // If has else, create a specific merge label for the if construct
     } else if (!merge_label_for_if) { // No else, merge directly to function exit
@@ -1530,58 +1671,50 @@ bool IRGenerator::ir_if_statement(ast_node * node) {
     if (!ir_visit_conditional_node(cond_expr_node, then_entry_label, (else_block_node ? else_entry_label : actual_merge_target) )) {
         return false;
     }
-    appendInstructionsToNode(node, cond_expr_node->blockInsts);
 
     // 4. "then" 分支
-    addInstructionToNode(node, then_entry_label);
+    builder.insert(then_entry_label);
     if (!ir_visit_ast_node(then_block_node)) { // 递归访问 then_block_node
         return false;
     }
-    appendInstructionsToNode(node, then_block_node->blockInsts);
 
     // 如果 then_block 不是以终结指令结束，则跳转到 if 语句的合并点
     bool then_is_terminated = false;
-    if (!then_block_node->blockInsts.empty()) {
-        Instruction* last_then_inst = then_block_node->blockInsts.getLastInst();
-        if (last_then_inst && last_then_inst->isTerminator()) {
-            then_is_terminated = true;
-        }
+    Instruction* last_then_inst = builder.getLastInst();
+    if (last_then_inst && last_then_inst->isTerminator()) {
+        then_is_terminated = true;
     }
     if (!then_is_terminated) {
-        addInstructionToNode(node, new GotoInstruction(current_func, actual_merge_target));
+        builder.createGoto(actual_merge_target);
     }
 
     // 5. "else" 分支 (如果存在)
     if (else_block_node) {
-        addInstructionToNode(node, else_entry_label); // else 代码块的入口
+        builder.insert(else_entry_label); // else 代码块的入口
         if (!ir_visit_ast_node(else_block_node)) { // 递归访问 else_block_node
             return false;
         }
-        appendInstructionsToNode(node, else_block_node->blockInsts);
 
         // 如果 else_block 不是以终结指令结束，则跳转到 if 语句的合并点
         bool else_is_terminated = false;
-        if (!else_block_node->blockInsts.empty()) {
-            Instruction* last_else_inst = else_block_node->blockInsts.getLastInst();
-            if (last_else_inst && last_else_inst->isTerminator()) {
-                else_is_terminated = true;
-            }
+        Instruction* last_else_inst = builder.getLastInst();
+        if (last_else_inst && last_else_inst->isTerminator()) {
+            else_is_terminated = true;
         }
         if (!else_is_terminated) {
-            addInstructionToNode(node, new GotoInstruction(current_func, actual_merge_target));
+            builder.createGoto(actual_merge_target);
         }
     }
 
     // 6. 添加 if 语句的合并点标签 (actual_merge_target)
     // 这个标签是 then (和 else, 如果存在) 分支执行完毕后的汇合点。
-    addInstructionToNode(node, actual_merge_target);
+    builder.insert(actual_merge_target);
 
-    node->val = nullptr;
+    nodeValue(node) = nullptr;
     return true;
 }
 // 处理 while 语句
 bool IRGenerator::ir_while_statement(ast_node * node) {
-    node->blockInsts.clear();
     ast_node* cond_expr_node = node->sons[0];
     ast_node* body_block_node = node->sons[1];
 
@@ -1592,48 +1725,44 @@ bool IRGenerator::ir_while_statement(ast_node * node) {
     continue_target_stack_.push_back(loop_condition_label);
     break_target_stack_.push_back(loop_exit_label);
 
-    addInstructionToNode(node, new GotoInstruction(getCurrentFunction(), loop_condition_label)); // unconditional jump to L1
-    addInstructionToNode(node, loop_condition_label); // L1:
+    builder.createGoto(loop_condition_label); // unconditional jump to L1
+    builder.insert(loop_condition_label); // L1:
     if (!ir_visit_conditional_node(cond_expr_node, loop_body_label, loop_exit_label)) { // if cond goto L2; else goto L3
         break_target_stack_.pop_back(); continue_target_stack_.pop_back(); return false;
     }
-    appendInstructionsToNode(node, cond_expr_node->blockInsts);
 
-    addInstructionToNode(node, loop_body_label); // L2:
+    builder.insert(loop_body_label); // L2:
     if (!ir_visit_ast_node(body_block_node)) {
         break_target_stack_.pop_back(); continue_target_stack_.pop_back(); return false;
     }
-    appendInstructionsToNode(node, body_block_node->blockInsts);
-    addInstructionToNode(node, new GotoInstruction(getCurrentFunction(), loop_condition_label)); // goto L1
+    builder.createGoto(loop_condition_label); // goto L1
 
-    addInstructionToNode(node, loop_exit_label); // L3:
+    builder.insert(loop_exit_label); // L3:
 
     break_target_stack_.pop_back();
     continue_target_stack_.pop_back();
-    node->val = nullptr;
+    nodeValue(node) = nullptr;
     return true;
 }
 
 // 处理 break 语句
 bool IRGenerator::ir_break_statement(ast_node * node) {
-    node->blockInsts.clear();
     if (break_target_stack_.empty()) {
         minic_log(LOG_ERROR, "Line %lld: 'break' 语句不在循环体内部。", (long long)node->line_no);
         return false;
     }
-    addInstructionToNode(node, new GotoInstruction(getCurrentFunction(), break_target_stack_.back()));
-    node->val = nullptr;
+    builder.createGoto(break_target_stack_.back());
+    nodeValue(node) = nullptr;
     return true;
 }
 
 // 处理 continue 语句
 bool IRGenerator::ir_continue_statement(ast_node * node) {
-    node->blockInsts.clear();
     if (continue_target_stack_.empty()) {
         minic_log(LOG_ERROR, "Line %lld: 'continue' 语句不在循环体内部。", (long long)node->line_no);
         return false;
     }
-    addInstructionToNode(node, new GotoInstruction(getCurrentFunction(), continue_target_stack_.back()));
-    node->val = nullptr;
+    builder.createGoto(continue_target_stack_.back());
+    nodeValue(node) = nullptr;
     return true;
 }
\ No newline at end of file
@@ -2,8 +2,8 @@
 /// @file IRGenerator.h
 /// @brief AST遍历产生线性IR的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.7
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,13 +12,22 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>节点的指令块与Value改为按节点编号的附加表
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>翻译函数改为按运算符索引的表，遍历改为显式工作栈
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>指令由IRBuilder直接产生到函数的插入点，去掉节点的指令块
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>-O1以上折叠常量表达式与常量条件
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>二元运算可按Sethi-Ullman标号确定操作数的求值次序
+/// <tr><td>2026-10-16 <td>1.7     <td>zenglj  <td>附加表按AST上下文的节点个数分配
 /// </table>
 ///
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 #include "AST.h"
+#include "ConstInt.h"
+#include "IRBuilder.h"
 #include "Module.h"
 #include "LabelInstruction.h" 
 #include "CmpInstruction.h"   
@@ -29,8 +38,10 @@ class IRGenerator {
 public:
     /// @brief 构造函数
     /// @param root
+    /// @param astContext AST所在的上下文，附加表按其中的节点个数分配
     /// @param _module
-    IRGenerator(ast_node * root, Module * _module);
+    /// @param _optLevel 优化级别，1及以上时折叠常量表达式与常量条件
+    IRGenerator(ast_node * root, const ASTContext & astContext, Module * _module, int _optLevel = 0);
 
     /// @brief 析构函数
     ~IRGenerator() = default;
@@ -38,6 +49,13 @@ public:
     /// @brief 运行产生IR
     bool run();
 
+    /// @brief 设置二元运算是否按Sethi-Ullman寄存器需求数确定操作数的求值次序
+    /// @param enable true：需求数多的操作数先求值，false：总是先左后右
+    void setSethiUllmanOrder(bool enable)
+    {
+        sethiUllmanOrder = enable;
+    }
+
 protected:
     /// @brief 编译单元AST节点翻译成线性中间IR
     /// @param node AST节点
@@ -59,6 +77,11 @@ protected:
     /// @return 翻译是否成功，true：成功，false：失败
     bool ir_function_call(ast_node * node);
 
+    /// @brief 进入语句块（含函数体），在语句翻译之前建立作用域
+    /// @param node AST节点
+    /// @return 翻译是否成功，true：成功，false：失败
+    bool ir_block_enter(ast_node * node);
+
     /// @brief 语句块（含函数体）AST节点翻译成线性中间IR
     /// @param node AST节点
     /// @return 翻译是否成功，true：成功，false：失败
@@ -165,19 +188,71 @@ protected:
     /// 而不是存储在 node->val 中的数据值。
 	bool ir_visit_conditional_node(ast_node* node, LabelInstruction* true_label, LabelInstruction* false_label);
     
+    /// @brief 两个操作数都是i32常量时按32位C语义计算二元运算，-O1以上有效
+    /// @param op 运算符，加、减、乘、除、取模
+    /// @param lhs 左操作数
+    /// @param rhs 右操作数
+    /// @return 结果常量，不能折叠时为空
+    ConstInt * fold_binary(IRInstOperator op, Value * lhs, Value * rhs);
+
+    /// @brief 操作数是i32常量时计算取负，-O1以上有效
+    /// @param src 操作数
+    /// @return 结果常量，不能折叠时为空
+    ConstInt * fold_neg(Value * src);
+
+    /// @brief 两个操作数都是整型常量时计算比较，-O1以上有效
+    /// @param op 比较运算符
+    /// @param lhs 左操作数
+    /// @param rhs 右操作数
+    /// @param result 比较的结果
+    /// @return true：已折叠，false：不能折叠
+    bool fold_compare(CmpInstruction::CmpOp op, Value * lhs, Value * rhs, bool & result);
+
+    /// @brief 计算各表达式子树的寄存器需求数与是否含有函数调用，非递归后序遍历
+    /// @param node AST的根
+    void ir_label_register_need(ast_node * node);
+
+    /// @brief 二元运算的右操作数是否应先求值
+    /// @param node 二元运算节点
+    /// @return true：先右后左，false：先左后右
+    bool ir_right_operand_first(ast_node * node);
+
     /// @brief AST的节点操作函数
     typedef bool (IRGenerator::*ast2ir_handler_t)(ast_node *);
 
-    /// @brief AST节点运算符与动作函数关联的映射表
-    std::unordered_map<ast_operator_type, ast2ir_handler_t> ast2ir_handlers;
+    ///
+    /// @brief AST节点运算符的翻译动作
+    ///
+    /// 后序翻译时ir_visit_ast_node先调用enter，再翻译全部操作数，最后调用handler；
+    /// 先序翻译时直接调用handler，由其自行访问孩子。
+    ///
+    struct ast2ir_entry {
+        /// @brief 翻译函数
+        ast2ir_handler_t handler;
+
+        /// @brief 后序翻译时在操作数之前执行的动作，可为空
+        ast2ir_handler_t enter;
+
+        /// @brief 是否后序翻译
+        bool postorder;
+    };
+
+    /// @brief AST节点运算符与翻译动作的关联表，按运算符直接索引
+    ast2ir_entry ast2ir_handlers[(int) ast_operator_type::AST_OP_MAX];
 
 private:
     /// @brief 抽象语法树的根
     ast_node * root;
 
+    /// @brief AST的节点个数，节点编号都小于该值
+    uint32_t nodeCount;
+
     /// @brief 符号表:模块
     Module * module;
 
+    /// @brief 优化级别
+    int optLevel;
+
 	    // --- 新增：用于标签生成和控制流的成员变量 ---
     int label_counter_ = 1; // 用于生成唯一标签的后缀计数器
     LabelInstruction* newLabel(); // 创建新的唯一标签的辅助函数
@@ -188,9 +263,48 @@ private:
 
     // 获取当前函数和发射指令的辅助函数 (如果你还没有类似功能)
     Function* getCurrentFunction(); // 获取当前正在处理的函数
-    // void addInstructionToCurrentFunction(Instruction* inst); // 将指令添加到当前函数的IR列表中
-    void addInstructionToNode(ast_node* node, Instruction* inst); // 将指令添加到 node->blockInsts
-    void appendInstructionsToNode(ast_node* node, InterCode& instructions); // 将指令列表追加到 node->blockInsts
 
     bool ir_variable_declare_single(ast_node * var_decl_node, ast_node * parent_decl_stmt_node); 
+
+    /// @brief 获取AST节点翻译产生的Value
+    /// @param node AST节点
+    /// @return Value的引用，可直接赋值
+    Value *& nodeValue(ast_node * node);
+
+    /// @brief 指令构建器，指令直接产生到当前函数的插入点
+    IRBuilder builder;
+
+    /// @brief 各AST节点翻译产生的Value，按节点编号索引
+    std::vector<Value *> nodeValues;
+
+    /// @brief 是否按Sethi-Ullman寄存器需求数确定操作数的求值次序
+    bool sethiUllmanOrder = false;
+
+    ///
+    /// @brief 表达式子树的Sethi-Ullman标号
+    ///
+    struct reg_need_label {
+        /// @brief 不溢出时求值需要的寄存器个数
+        uint16_t need;
+
+        /// @brief 子树中是否有函数调用，有副作用
+        bool hasCall;
+    };
+
+    /// @brief 各AST节点的Sethi-Ullman标号，按节点编号索引，未开启时为空
+    std::vector<reg_need_label> regNeeds;
+
+    ///
+    /// @brief ir_visit_ast_node工作栈中的节点
+    ///
+    struct visit_frame {
+        /// @brief AST节点
+        ast_node * node;
+
+        /// @brief 后序翻译的节点是否已压入操作数
+        bool expanded;
+    };
+
+    /// @brief ir_visit_ast_node的工作栈，代替递归调用
+    std::vector<visit_frame> visitStack;
 };
@@ -3,8 +3,8 @@
 /// @brief 描述全局值或对象的类，可以是常量、函数、全局变量等
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
 /// </table>
 ///
 #pragma once
@@ -62,18 +64,24 @@ public:
     /// @brief 构造函数
     /// @param _type  类型
     /// @param _name  全局符号名
+    /// @param _kind  种类
     ///
-    GlobalValue(Type * _type, std::string _name) : Constant(_type)
+    GlobalValue(Type * _type, std::string _name, ValueKind _kind) : Constant(_type, _kind)
     {
         this->name = _name;
-        this->IRName = IR_GLOBAL_VARNAME_PREFIX + this->name;
     }
 
-    /// @brief 获取名字
-    /// @return 变量名
+    /// @brief 用于isa/cast/dyn_cast，判断是否是全局符号
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::GlobalVariable;
+    }
+
+    /// @brief 获取IR名字，全局符号的IR名字是在原来的名称前追加@
+    /// @return IR名字
     [[nodiscard]] std::string getIRName() const override
     {
-        return IRName;
+        return IR_GLOBAL_VARNAME_PREFIX + name;
     }
 
     ///
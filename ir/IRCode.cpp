@@ -2,8 +2,8 @@
 /// @file IRCode.cpp
 /// @brief IR指令序列类实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,70 +11,138 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>指令序列改为侵入式双向链表，拼接、插入与删除为O(1)
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
 /// </table>
 ///
 #include "IRCode.h"
 
-/// @brief 析构函数
-InterCode::~InterCode()
+/// @brief 移动构造函数，指令转移到新的序列中
+/// @param other 被移动的指令序列，之后为空
+InterCode::InterCode(InterCode && other) noexcept : head(other.head), tail(other.tail), count(other.count)
 {
-    Delete();
+    other.head = other.tail = nullptr;
+    other.count = 0;
 }
 
 /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容
 /// @param block 指令块，请注意加入后会自动清空block的指令
 void InterCode::addInst(InterCode & block)
 {
-    std::vector<Instruction *> & insert = block.getInsts();
+    if (&block == this || block.head == nullptr) {
+        return;
+    }
+
+    // 整个链表接到尾部，不逐条复制
+    if (tail) {
+        tail->nextInst = block.head;
+        block.head->prevInst = tail;
+    } else {
+        head = block.head;
+    }
 
-    code.insert(code.end(), insert.begin(), insert.end());
+    tail = block.tail;
+    count += block.count;
 
-    // InterCode析构会清理资源，因此移动指令到code中后必须清理，否则会释放多次导致程序例外
-    // 当然，这里也可不清理，但InterCode的析构函数不能清理，需专门的函数清理即可。
-    insert.clear();
+    // 指令已链入本序列，block置空，避免两个序列共享同一段链表
+    block.head = block.tail = nullptr;
+    block.count = 0;
 }
 
 /// @brief 添加一条中间指令
 /// @param inst IR指令
 void InterCode::addInst(Instruction * inst)
 {
-    code.push_back(inst);
+    (void) insertBefore(end(), inst);
 }
 
-/// @brief 获取指令序列
-/// @return 指令序列
-const std::vector<Instruction*>& InterCode::getInsts() const { // <--- 返回类型和函数本身都要有 const
-    return code;
+/// @brief 在指定位置之前插入指令
+/// @param pos 插入位置，为end()时添加到尾部
+/// @param inst IR指令
+/// @return iterator 指向插入的指令
+InterCode::iterator InterCode::insertBefore(iterator pos, Instruction * inst)
+{
+    Instruction * next = *pos;
+    Instruction * prev = next ? next->prevInst : tail;
+
+    inst->prevInst = prev;
+    inst->nextInst = next;
+
+    if (prev) {
+        prev->nextInst = inst;
+    } else {
+        head = inst;
+    }
+
+    if (next) {
+        next->prevInst = inst;
+    } else {
+        tail = inst;
+    }
+
+    count++;
+
+    return iterator(inst, this);
 }
-std::vector<Instruction*>& InterCode::getInsts() {
-    return code; // 使用正确的成员变量名 code
+
+/// @brief 在指定位置之后插入指令
+/// @param pos 插入位置，必须指向序列中的指令
+/// @param inst IR指令
+/// @return iterator 指向插入的指令
+InterCode::iterator InterCode::insertAfter(iterator pos, Instruction * inst)
+{
+    return insertBefore(iterator((*pos)->nextInst, this), inst);
 }
-/// @brief 删除所有指令
-void InterCode::Delete()
+
+/// @brief 从序列中摘除指令，指令不释放
+/// @param inst IR指令，必须在本序列中
+void InterCode::remove(Instruction * inst)
 {
-    // 不能直接删除指令，需要先清除操作数
-    for (auto inst: code) {
-        inst->clearOperands();
+    if (inst->prevInst) {
+        inst->prevInst->nextInst = inst->nextInst;
+    } else {
+        head = inst->nextInst;
     }
 
-    // 资源清理
-    for (auto inst: code) {
-        delete inst;
+    if (inst->nextInst) {
+        inst->nextInst->prevInst = inst->prevInst;
+    } else {
+        tail = inst->prevInst;
     }
 
-    code.clear();
+    inst->prevInst = inst->nextInst = nullptr;
+    count--;
+}
+
+/// @brief 删除指定位置的指令并清除其操作数，指令的内存随函数的内存池释放
+/// @param pos 删除位置，必须指向序列中的指令
+/// @return iterator 指向被删除指令的下一条指令
+InterCode::iterator InterCode::erase(iterator pos)
+{
+    Instruction * inst = *pos;
+    iterator next(inst->nextInst, this);
+
+    remove(inst);
+
+    inst->clearOperands();
+
+    return next;
 }
-void InterCode::clear() {
-    // 如果需要释放指令内存，这里要小心
-    // for (Instruction* inst : code) { delete inst; } // 只有在InterCode拥有指令所有权时
-    code.clear();
+
+/// @brief 清空序列，指令不释放
+void InterCode::clear()
+{
+    // 指令的所有权不在这里，只断开序列，指令的前后指针在再次加入序列时重置
+    head = tail = nullptr;
+    count = 0;
 }
-bool InterCode::empty() const {
-    return code.empty();
+
+bool InterCode::empty() const
+{
+    return head == nullptr;
 }
-Instruction* InterCode::getLastInst() const {
-    return code.empty() ? nullptr : code.back();
+
+Instruction * InterCode::getLastInst() const
+{
+    return tail;
 }
-const std::vector<Instruction*>& InterCode::getInstructions() const {
-    return code;
-}
\ No newline at end of file
@@ -2,8 +2,8 @@
 /// @file IRCode.cpp
 /// @brief IR指令序列类头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,28 +11,107 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>指令序列改为侵入式双向链表，拼接、插入与删除为O(1)
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
 /// </table>
 ///
 
 #pragma once
 
-#include <vector>
+#include <cstddef>
+#include <iterator>
 
 #include "Instruction.h"
 
+///
 /// @brief 中间IR指令序列管理类
+///
+/// 指令通过自身的前后指针组成侵入式双向链表，指令块的拼接、在任意位置的插入与删除都是O(1)，
+/// AST逐层向上收集指令时不再复制。一条指令同一时刻只能属于一个指令序列。
+///
 class InterCode {
 
-protected:
-    /// @brief 指令块的指令序列
-    std::vector<Instruction *> code;
-
 public:
+    ///
+    /// @brief 指令序列的双向迭代器，解引用得到指令
+    ///
+    class iterator {
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Instruction *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Instruction * const *;
+        using reference = Instruction *;
+
+        /// @brief 构造函数
+        /// @param _inst 指向的指令，空指针表示结尾
+        /// @param _owner 所属的指令序列，结尾处后退时需要
+        explicit iterator(Instruction * _inst = nullptr, const InterCode * _owner = nullptr)
+            : inst(_inst), owner(_owner)
+        {}
+
+        Instruction * operator*() const
+        {
+            return inst;
+        }
+
+        iterator & operator++()
+        {
+            inst = inst->getNextInst();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        iterator & operator--()
+        {
+            inst = inst ? inst->getPrevInst() : owner->tail;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator & other) const
+        {
+            return inst == other.inst;
+        }
+
+        bool operator!=(const iterator & other) const
+        {
+            return inst != other.inst;
+        }
+
+    private:
+        /// @brief 指向的指令，空指针表示结尾
+        Instruction * inst;
+
+        /// @brief 所属的指令序列
+        const InterCode * owner;
+    };
+
     /// @brief 构造函数
     InterCode() = default;
 
-    /// @brief 析构函数
-    ~InterCode();
+    /// @brief 移动构造函数，指令转移到新的序列中
+    /// @param other 被移动的指令序列，之后为空
+    InterCode(InterCode && other) noexcept;
+
+    InterCode(const InterCode &) = delete;
+    InterCode & operator=(const InterCode &) = delete;
+
+    /// @brief 析构函数，指令由所在函数的内存池释放，这里不释放
+    ~InterCode() = default;
 
     /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容
     /// @param block 指令块，请注意加入后会自动清空block的指令
@@ -42,16 +121,59 @@ public:
     /// @param inst IR指令
     void addInst(Instruction * inst);
 
-    /// @brief 获取指令序列
-    /// @return 指令序列
-    [[nodiscard]] std::vector<Instruction*>& getInsts(); 
-	[[nodiscard]] const std::vector<Instruction*>& getInsts() const;
+    /// @brief 在指定位置之前插入指令
+    /// @param pos 插入位置，为end()时添加到尾部
+    /// @param inst IR指令
+    /// @return iterator 指向插入的指令
+    iterator insertBefore(iterator pos, Instruction * inst);
+
+    /// @brief 在指定位置之后插入指令
+    /// @param pos 插入位置，必须指向序列中的指令
+    /// @param inst IR指令
+    /// @return iterator 指向插入的指令
+    iterator insertAfter(iterator pos, Instruction * inst);
+
+    /// @brief 从序列中摘除指令，指令不释放
+    /// @param inst IR指令，必须在本序列中
+    void remove(Instruction * inst);
 
-    /// @brief 删除所有指令
-    void Delete();
+    /// @brief 删除指定位置的指令并清除其操作数，指令的内存随函数的内存池释放
+    /// @param pos 删除位置，必须指向序列中的指令
+    /// @return iterator 指向被删除指令的下一条指令
+    iterator erase(iterator pos);
 
+    /// @brief 第一条指令的位置
+    [[nodiscard]] iterator begin() const
+    {
+        return iterator(head, this);
+    }
+
+    /// @brief 最后一条指令之后的位置
+    [[nodiscard]] iterator end() const
+    {
+        return iterator(nullptr, this);
+    }
+
+    /// @brief 获取指令条数
+    /// @return 指令条数
+    [[nodiscard]] size_t size() const
+    {
+        return count;
+    }
+
+    /// @brief 清空序列，指令不释放
     void clear();
+
     [[nodiscard]] bool empty() const;
-    [[nodiscard]] Instruction* getLastInst() const;
-    [[nodiscard]] const std::vector<Instruction*>& getInstructions() const; 
+    [[nodiscard]] Instruction * getLastInst() const;
+
+private:
+    /// @brief 第一条指令
+    Instruction * head = nullptr;
+
+    /// @brief 最后一条指令
+    Instruction * tail = nullptr;
+
+    /// @brief 指令条数
+    size_t count = 0;
 };
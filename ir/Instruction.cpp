@@ -2,8 +2,8 @@
 /// @file Instruction.cpp
 /// @brief IR指令类实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,9 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>删除后端的寄存器与栈内位置，指令在函数内稠密编号
 /// </table>
 ///
 #include <string>
@@ -23,14 +26,14 @@
 /// @param result
 /// @param srcVal1
 /// @param srcVal2
-Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type) : User(_type), op(_op), func(_func)
-{}
-
-/// @brief 获取指令操作码
-/// @return 指令操作码
-IRInstOperator Instruction::getOp() const
+Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type)
+    : User(_type, ValueKind::Instruction), op(_op), func(_func)
 {
-    return op;
+    // 操作数的Use与指令一样从函数的内存池中分配，指令在函数内稠密编号
+    if (_func) {
+        useArena = &_func->getArena();
+        _func->numberValue(this);
+    }
 }
 
 /// @brief 转换成字符串
@@ -2,8 +2,8 @@
 /// @file Instruction.h
 /// @brief IR指令头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,9 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>指令增加所在序列中的前后指针
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>删除后端的寄存器与栈内位置，指令在函数内稠密编号
 /// </table>
 ///
 #pragma once
@@ -87,7 +90,16 @@ public:
 
     /// @brief 获取指令操作码
     /// @return 指令操作码
-    [[nodiscard]] IRInstOperator getOp() const;
+    [[nodiscard]] IRInstOperator getOp() const
+    {
+        return op;
+    }
+
+    /// @brief 用于isa/cast/dyn_cast，判断是否是指令
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::Instruction;
+    }
 
     ///
     /// @brief 转换成IR指令文本形式
@@ -117,63 +129,21 @@ public:
     [[nodiscard]] bool hasResultValue() const;
 
     ///
-    /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
+    /// @brief 获取所在指令序列中的前一条指令
+    /// @return Instruction* 前一条指令，第一条指令时为空
     ///
-    int32_t getRegId() override
+    [[nodiscard]] Instruction * getPrevInst() const
     {
-        return regId;
+        return prevInst;
     }
 
     ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
-    ///
-    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) override {
-		minic_log(LOG_DEBUG, "Instruction (Ptr: %p, IRName: %s): getMemoryAddr() called. Internal baseRegNo: %d, offset: %lld.",
-				  (void*)this, this->getIRName().c_str(), this->baseRegNo, (long long)this->offset); // (long long) for %lld
-		if (this->baseRegNo == -1) {
-			return false;
-		}
-		if (_regId) { *_regId = this->baseRegNo; }
-		if (_offset) { *_offset = this->offset; }
-		return true;
-	}
-
-    ///
-    /// @brief 设置内存寻址的基址寄存器和偏移
-    /// @param _regId 基址寄存器编号
-    /// @param _offset 偏移
-    ///
-    void setMemoryAddr(int32_t _regId, int64_t _offset_param){ // changed _offset to _offset_param to avoid confusion
-		this->baseRegNo = _regId;
-		this->offset = _offset_param;
-		minic_log(LOG_DEBUG, "Instruction (Ptr: %p, IRName: %s): setMemoryAddr called. baseRegNo set to %d, offset_param was %lld, member offset set to %lld.",
-				  (void*)this, this->getIRName().c_str(), this->baseRegNo, (long long)_offset_param, (long long)this->offset);
-		// 新增日志
-		minic_log(LOG_DEBUG, "Instruction (Ptr: %p, IRName: %s): AFTER SETTING, this->baseRegNo = %d, this->offset = %lld",
-			(void*)this, this->getIRName().c_str(), this->baseRegNo, (long long)this->offset);
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
+    /// @brief 获取所在指令序列中的后一条指令
+    /// @return Instruction* 后一条指令，最后一条指令时为空
     ///
-    int32_t getLoadRegId() override
+    [[nodiscard]] Instruction * getNextInst() const
     {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
+        return nextInst;
     }
 
     
@@ -194,28 +164,17 @@ protected:
     ///
     Function * func = nullptr;
 
-    ///
-    /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
-    ///
-    int32_t regId = -1;
-
-    ///
-    /// @brief 变量在栈内的偏移量，对于全局变量默认为0，临时变量没有意义
-    ///
-    int32_t offset = 0;
-
-    ///
-    /// @brief 栈内寻找时基址寄存器编号
-    ///
-    int32_t baseRegNo = -1;
+private:
+    /// @brief 指令序列InterCode维护前后指针
+    friend class InterCode;
 
     ///
-    /// @brief 栈内寻找时基址寄存器名字
+    /// @brief 所在指令序列中的前一条指令
     ///
-    std::string baseRegName;
+    Instruction * prevInst = nullptr;
 
     ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
+    /// @brief 所在指令序列中的后一条指令
     ///
-    int32_t loadRegNo = -1;
+    Instruction * nextInst = nullptr;
 };
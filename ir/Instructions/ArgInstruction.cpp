@@ -1,9 +1,9 @@
-///
+﻿///
 /// @file ArgInstruction.cpp
 /// @brief 函数调用前的实参指令
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,11 +11,13 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>删除后端的寄存器与栈内位置
 /// </table>
 ///
 #include <string>
 #include "ArgInstruction.h"
 #include "Function.h"
+#include "RegVariable.h"
 #include "VoidType.h"
 
 /// @brief 函数实参指令
@@ -39,13 +41,9 @@ std::string ArgInstruction::toString() const { // <--- 签名修改
     // DragonIR 中没有 'arg' 指令。输出为注释。
     result_str_build = "; arg " + src->getIRName(); // 确保 getIRName 是 const
 
-    int32_t regId_val;
-    int64_t offset_val;
-    // 确保 getRegId 和 getMemoryAddr 是 const
-    if (src->getRegId() != -1) {
-        result_str_build += " ; (reg: " + std::to_string(src->getRegId()) + ")";
-    } else if (src->getMemoryAddr(&regId_val, &offset_val)) {
-        result_str_build += " ; (mem: " + std::to_string(regId_val) + "[" + std::to_string(offset_val) + "])";
+    // 寄存器与栈内位置由后端记录，IR中只有寄存器变量能显示其寄存器
+    if (auto * regVal = dyn_cast<RegVariable>(src)) {
+        result_str_build += " ; (reg: " + std::to_string(regVal->getRegId()) + ")";
     }
     // 移除 func->realArgCountInc();
     return result_str_build;
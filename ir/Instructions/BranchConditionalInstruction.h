@@ -18,6 +18,12 @@ private:
     LabelInstruction *false_target_; // 条件为假时的跳转目标标签
 
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是条件跳转指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_BRANCH_COND;
+    }
+
     /// @brief 构造函数
     /// @param cond 条件Value (必须是i1类型)
     /// @param true_label 真出口标签
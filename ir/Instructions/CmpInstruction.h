@@ -13,6 +13,12 @@ class Type;
 /// @details 例如: %t1 = cmp lt %op1, %op2
 class CmpInstruction : public Instruction {
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是比较指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_CMP;
+    }
+
     /// @brief Cmp指令的比较操作符枚举
     enum CmpOp {
         EQ, // ==
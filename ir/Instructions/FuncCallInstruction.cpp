@@ -2,8 +2,8 @@
 /// @file FuncCallInstruction.cpp
 /// @brief 函数调用指令
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>按实参个数预留操作数空间
 /// </table>
 ///
 // ir/Instructions/FuncCallInstruction.cpp
@@ -39,6 +40,9 @@ FuncCallInstruction::FuncCallInstruction(
     calledFunctionName_(func_name_to_call),
     calledFunction_(target_func_object) // 假设 .h 中成员名为 calledFunction_
 {
+    // 实参较多时一次分配好操作数的空间
+    reserveOperands((int32_t) args.size());
+
     for (Value* arg_val : args) {
         if (arg_val) {
             addOperand(arg_val); 
@@ -14,6 +14,12 @@ private:
     Function*   calledFunction_;     // 使用下划线
 
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是函数调用指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL;
+    }
+
     FuncCallInstruction(
         Function* parentFuncScope,              
         const std::string& func_name_to_call,   
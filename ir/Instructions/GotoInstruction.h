@@ -3,8 +3,8 @@
 /// @brief 无条件跳转指令即goto指令
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
 /// </table>
 ///
 #pragma once
@@ -28,6 +29,12 @@
 class GotoInstruction final : public Instruction {
 
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是无条件跳转指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_GOTO;
+    }
+
     ///
     /// @brief 无条件跳转指令的构造函数
     /// @param target 跳转目标
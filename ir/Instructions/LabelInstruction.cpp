@@ -2,8 +2,8 @@
 /// @file LabelInstruction.cpp
 /// @brief Label指令
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,25 +11,37 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
 /// </table>
 ///
 #include "VoidType.h"
 #include "Function.h" 
+#include "IRConstant.h"
 #include "LabelInstruction.h"
-#include "Value.h" // For setName/setIRName
+#include "Value.h"
 ///
 /// @brief 构造函数
 /// @param _func 所属函数
+/// @param labelNo 标签编号，模块内唯一，作为IR名字的编号
 ///
-
-
-LabelInstruction::LabelInstruction(Function* _func, const std::string& name_for_label)
+LabelInstruction::LabelInstruction(Function* _func, int32_t labelNo)
     : Instruction(_func, IRInstOperator::IRINST_OP_LABEL, VoidType::getType()) {
-    this->setIRName(name_for_label); // <--- 核心: 创建时就设置最终的IRName
-    this->setName(name_for_label);   // (可选) 也可以设置原始 name
-    // 移除 this->name_ = name; 如果 name_ 是独立成员
+    // 标签的编号在创建时确定，名字字符串只在输出时生成
+    this->setIRSlot(labelNo);
 }
 
 std::string LabelInstruction::toString() const {
-    return this->getIRName() + ":"; // 使用 getIRName()
+    return this->getIRName() + ":";
+}
+
+/// @brief 获取IR名字，按标签编号生成
+/// @return IR名字
+std::string LabelInstruction::getIRName() const {
+    return IR_LABEL_PREFIX + std::to_string(irSlot);
+}
+
+/// @brief 获取名字，后端没有重新命名时同IR名字
+/// @return 名字
+std::string LabelInstruction::getName() const {
+    return name.empty() ? getIRName() : name;
 }
\ No newline at end of file
@@ -3,8 +3,8 @@
 /// @brief Label指令
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
 /// </table>
 ///
 #pragma once
@@ -28,7 +30,24 @@ class Function;
 // ir/Instructions/LabelInstruction.h
 class LabelInstruction : public Instruction {
 	public:
-		explicit LabelInstruction(Function * _func, const std::string& unique_ir_name);
+		/// @brief 用于isa/cast/dyn_cast，判断是否是标签指令
+		static bool classof(const Value * val)
+		{
+			return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_LABEL;
+		}
+
+		/// @brief 构造函数
+		/// @param _func 所属函数
+		/// @param labelNo 标签编号，模块内唯一，作为IR名字的编号
+		LabelInstruction(Function * _func, int32_t labelNo);
+
 		[[nodiscard]] std::string toString() const override;
-		// getName() 和 getIRName() 将使用 Value 基类的默认实现
+
+		/// @brief 获取IR名字，按标签编号生成
+		/// @return IR名字
+		[[nodiscard]] std::string getIRName() const override;
+
+		/// @brief 获取名字，后端没有重新命名时同IR名字
+		/// @return 名字
+		[[nodiscard]] std::string getName() const override;
 	};
\ No newline at end of file
@@ -3,8 +3,8 @@
 /// @brief Move指令，也就是DragonIR的Asssign指令
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
 /// </table>
 ///
 #pragma once
@@ -29,6 +30,12 @@ class Function;
 class MoveInstruction : public Instruction {
 
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是复制指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_ASSIGN;
+    }
+
     ///
     /// @brief 构造函数
     /// @param _func 所属的函数
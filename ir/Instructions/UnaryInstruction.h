@@ -3,6 +3,12 @@
 
 class UnaryInstruction : public Instruction {
 public:
+    /// @brief 用于isa/cast/dyn_cast，判断是否是一元运算指令
+    static bool classof(const Value * val)
+    {
+        return isa<Instruction>(val) && cast<Instruction>(val)->getOp() == IRInstOperator::IRINST_OP_NEG_I;
+    }
+
     UnaryInstruction(Function *func, 
                     IRInstOperator op, 
                     Value *srcVal, 
@@ -3,8 +3,8 @@
 /// @brief 整型类型类，可描述1位的bool类型或32位的int类型
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,53 +12,67 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>同一位宽只有一个类型实例，预先创建小整数常量
 /// </table>
 ///
 
 // IntegerType.cpp
 #include "IntegerType.h"
 #include <map>
+#include <mutex>
 #include <string> // std::to_string 需要
 
 #include "Common.h"
-// 静态成员定义
-IntegerType * IntegerType::oneInstanceBool = nullptr; // 初始化为 nullptr
-IntegerType * IntegerType::oneInstanceInt = nullptr;  // 初始化为 nullptr
-
-// 静态缓存定义
-static std::map<int, IntegerType*> integer_type_cache_for_get;
+#include "ConstInt.h"
 
 // 构造函数实现
 IntegerType::IntegerType(int bitWidthValue) // 使用与 .h 中声明一致的参数名
     : Type(Type::TypeID::IntegerTyID), bit_width_(bitWidthValue) { // 正确初始化 bit_width_
-    // 不需要其他操作
+
+    // 预先创建常用的小整数常量，i1类型只有0和1
+    for (int32_t val = INT_SMALL_CONST_MIN; val <= INT_SMALL_CONST_MAX; ++val) {
+        if (bit_width_ != 1 || val == 0 || val == 1) {
+            smallConsts[val - INT_SMALL_CONST_MIN] = new ConstInt(this, val);
+        }
+    }
 }
 
-// get(int bitWidth) 实现 (保持不变，它是正确的)
+/// @brief 按位宽获取类型，同一位宽全局只有一份，1位与32位分别就是bool与int类型
+/// @param bitWidth 位宽
+/// @return IntegerType* 类型
 IntegerType* IntegerType::get(int bitWidth) {
-    auto it = integer_type_cache_for_get.find(bitWidth);
-    if (it != integer_type_cache_for_get.end()) {
-        return it->second;
+    if (bitWidth == 1) {
+        return getTypeBool();
+    }
+    if (bitWidth == 32) {
+        return getTypeInt();
+    }
+
+    // 其它位宽很少用到，加锁查找即可
+    static std::mutex mutex;
+    static std::map<int, IntegerType*> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    IntegerType *& type = cache[bitWidth];
+    if (!type) {
+        type = new IntegerType(bitWidth);
     }
-    IntegerType* new_type = new IntegerType(bitWidth);
-    integer_type_cache_for_get[bitWidth] = new_type;
-    return new_type;
+    return type;
 }
 
-// getTypeBool() 实现 (保持不变，它是正确的)
+/// @brief 获取bool类型，首次使用时创建，多线程下也只创建一次
+/// @return IntegerType* 类型
 IntegerType * IntegerType::getTypeBool() {
-    if (!oneInstanceBool) {
-        oneInstanceBool = new IntegerType(1); // 内部调用构造函数，设置 bit_width_ = 1
-    }
-    return oneInstanceBool;
+    static IntegerType * instance = new IntegerType(1);
+    return instance;
 }
 
-// getTypeInt() 实现 (保持不变，它是正确的)
+/// @brief 获取int类型，首次使用时创建，多线程下也只创建一次
+/// @return IntegerType* 类型
 IntegerType * IntegerType::getTypeInt() {
-    if (!oneInstanceInt) {
-        oneInstanceInt = new IntegerType(32); // 内部调用构造函数，设置 bit_width_ = 32
-    }
-    return oneInstanceInt;
+    static IntegerType * instance = new IntegerType(32);
+    return instance;
 }
 int32_t IntegerType::getSize() const {
     // 假设你有 isInt32Type() 和 isInt1Byte() 的实现
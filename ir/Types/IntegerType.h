@@ -3,8 +3,8 @@
 /// @brief 整型类型类，可描述1位的bool类型或32位的int类型
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>同一位宽只有一个类型实例，预先创建小整数常量
 /// </table>
 ///
 
@@ -21,6 +22,12 @@
 
 #include "Type.h"
 
+class ConstInt;
+
+/// @brief 预先创建的小整数常量的范围，含两端
+#define INT_SMALL_CONST_MIN (-8)
+#define INT_SMALL_CONST_MAX 63
+
 class IntegerType final : public Type {
 
 public:
@@ -84,25 +91,31 @@ public:
     
 
 	[[nodiscard]] static IntegerType* get(int bitWidth);
-private:
-	int32_t bit_width_;
 
-	// 将构造函数设为私有，强制通过静态 get() 方法获取实例
-	explicit IntegerType(int bitWidth);
     ///
-    /// @brief 构造函数
+    /// @brief 获取预先创建的小整数常量，创建类型时建好，之后只读，多线程使用不需要加锁
+    /// @param val 整数值，i1类型只有0和1
+    /// @return ConstInt* 常量，不在预先创建的范围内时为空
     ///
+    [[nodiscard]] ConstInt * getSmallConstant(int32_t val) const
+    {
+        if (val < INT_SMALL_CONST_MIN || val > INT_SMALL_CONST_MAX) {
+            return nullptr;
+        }
 
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static IntegerType * oneInstanceBool;
+        return smallConsts[val - INT_SMALL_CONST_MIN];
+    }
+
+private:
+	int32_t bit_width_;
 
     ///
-    /// @brief 唯一的VOID类型实例
+    /// @brief 预先创建的小整数常量，按值减去INT_SMALL_CONST_MIN索引
     ///
-    static IntegerType * oneInstanceInt;
+    ConstInt * smallConsts[INT_SMALL_CONST_MAX - INT_SMALL_CONST_MIN + 1] = {};
 
+	// 将构造函数设为私有，强制通过静态 get() 方法获取实例
+	explicit IntegerType(int bitWidth);
     ///
     /// @brief 位宽
     ///
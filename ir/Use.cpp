@@ -3,8 +3,8 @@
 /// @brief Use类定义了一条Define-Use边，usee为定义的Value，user代表使用该Value的User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>同一个Value的Use组成侵入式双向链表，增删为O(1)
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>增加空Use的构造与moveFrom，用于内嵌存放与搬移
 /// </table>
 ///
 
@@ -24,9 +26,15 @@
 ///
 void Use::setUsee(Value * newVal)
 {
-    this->usee->removeUse(this);
+    if (this->usee) {
+        this->usee->removeUse(this);
+    }
+
     this->usee = newVal;
-    this->usee->addUse(this);
+
+    if (this->usee) {
+        this->usee->addUse(this);
+    }
 }
 
 ///
@@ -35,6 +43,32 @@ void Use::setUsee(Value * newVal)
 ///
 void Use::remove()
 {
-    usee->removeUse(this);
+    if (usee) {
+        usee->removeUse(this);
+    }
     user->removeOperandRaw(this);
-}
\ No newline at end of file
+}
+
+///
+/// @brief 把other的内容搬到本Use中，并在Value的use链表中替换other，other变为空
+/// @param other 被搬移的Use，本Use必须不在任何use链表中
+///
+void Use::moveFrom(Use & other)
+{
+    usee = other.usee;
+    user = other.user;
+    next = other.next;
+    prev = other.prev;
+
+    // 链表中指向other的指针改为指向本Use
+    if (prev) {
+        *prev = this;
+    }
+    if (next) {
+        next->prev = &next;
+    }
+
+    other.usee = nullptr;
+    other.next = nullptr;
+    other.prev = nullptr;
+}
@@ -3,8 +3,8 @@
 /// @brief Use类定义了一条Define-Use边，usee为定义的Value，user代表使用该Value的User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>同一个Value的Use组成侵入式双向链表，增删为O(1)
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>增加空Use的构造与moveFrom，用于内嵌存放与搬移
 /// </table>
 ///
 #pragma once
@@ -32,8 +34,17 @@ class Value;
 /// User持有一个Use链表(成员uses)，每个Use指向一个Value
 /// Value持有一个User链表(成员uses)，每个User指向一个使用该Value的User对象
 ///
+/// 同一个Value的所有Use通过next与prev组成侵入式链表，加入与移除都是O(1)。
+/// prev指向前一个Use的next成员或者Value的链表头，移除时不需要知道链表头在哪里。
+///
 class Use {
 
+    /// @brief Value维护use链表的指针
+    friend class Value;
+
+    /// @brief User设置内嵌Use的使用者
+    friend class User;
+
 protected:
     ///
     /// @brief 指向要使用的value
@@ -45,7 +56,22 @@ protected:
     ///
     User * user = nullptr;
 
+    ///
+    /// @brief 同一个Value的use链表中的下一个Use
+    ///
+    Use * next = nullptr;
+
+    ///
+    /// @brief 指向前一个Use的next或者Value的链表头，不在链表中时为空
+    ///
+    Use ** prev = nullptr;
+
 public:
+    ///
+    /// @brief 构造空的Use，用于User内嵌或者按数组分配的Use
+    ///
+    Use() = default;
+
     /**
      * 构建函数，构建一条define-use的边
      * <br>
@@ -84,6 +110,15 @@ public:
         return usee;
     }
 
+    ///
+    /// @brief 获取同一个Value的use链表中的下一个Use
+    /// @return Use* 下一个Use，没有时为空
+    ///
+    [[nodiscard]] Use * getNext() const
+    {
+        return next;
+    }
+
     ///
     /// @brief 不再使用Use原来的Value，更新为新的Value
     /// @param newVal 新的Value
@@ -94,4 +129,10 @@ public:
     /// @brief def-use边取消，但不会删除该Use
     ///
     void remove();
+
+    ///
+    /// @brief 把other的内容搬到本Use中，并在Value的use链表中替换other，other变为空
+    /// @param other 被搬移的Use，本Use必须不在任何use链表中
+    ///
+    void moveFrom(Use & other);
 };
\ No newline at end of file
@@ -3,8 +3,8 @@
 /// @brief 使用Value的User，该User也是Value。函数、指令都是User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,24 +12,83 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>操作数的Use按位置内嵌存放，超过3个时整体搬到另外分配的数组
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
 /// </table>
 ///
 
-#include <algorithm>
+#include <new>
 
+#include "Arena.h"
 #include "User.h"
-#include "Value.h" // For Value::removeUse
-#include "Use.h"   // For Use class and delete use_edge
+#include "Value.h"
+#include "Use.h"
+
 ///
 /// @brief 构造函数
 /// @param _type  类型
+/// @param _kind  种类
 ///
-User::User(Type * _type) : Value(_type)
+User::User(Type * _type, ValueKind _kind) : Value(_type, _kind), ops(inlineOps)
 {}
 
-User::~User() {
-    clearOperands(); // 在析构时调用 clearOperands 来释放资源
+///
+/// @brief 析构函数，清除所有的操作数
+///
+User::~User()
+{
+    clearOperands();
+    freeOperands();
+}
+
+///
+/// @brief 释放另外分配的ops数组，内嵌的或者从内存池中分配的不需要释放
+///
+void User::freeOperands()
+{
+    if (ops != inlineOps && !useArena) {
+        delete[] ops;
+    }
+}
+
+///
+/// @brief 扩大ops数组的容量，已有的Use搬到新的数组中
+/// @param cap 新的容量
+///
+void User::growOperands(int32_t cap)
+{
+    Use * newOps;
+    if (useArena) {
+        newOps = useArena->allocateArray<Use>(cap);
+        for (int32_t k = 0; k < cap; ++k) {
+            new (&newOps[k]) Use();
+        }
+    } else {
+        newOps = new Use[cap];
+    }
+
+    for (int32_t k = 0; k < numOps; ++k) {
+        newOps[k].moveFrom(ops[k]);
+    }
+
+    freeOperands();
+
+    ops = newOps;
+    capOps = cap;
+}
+
+///
+/// @brief 预留操作数的空间，已知操作数个数时可避免多次搬移
+/// @param n 操作数个数
+///
+void User::reserveOperands(int32_t n)
+{
+    if (n > capOps) {
+        growOperands(n);
+    }
 }
+
 ///
 /// @brief 更新指定Pos的Value
 /// @param pos 位置
@@ -37,45 +96,55 @@ User::~User() {
 ///
 void User::setOperand(int32_t pos, Value * val)
 {
-    if (pos < (int32_t) operands.size()) {
-        operands[pos]->setUsee(val);
+    if (pos < numOps) {
+        ops[pos].setUsee(val);
     }
 }
 
 ///
 /// @brief 增加操作数，或者说本身的值由这些操作数来计算得到
-/// @param pos 索引位置
 /// @param val 值
 ///
 void User::addOperand(Value * val)
 {
-    // If not, add the given Value as a new use.
-    auto use = new Use(val, this);
+    if (numOps == capOps) {
+        growOperands(capOps * 2);
+    }
+
+    Use * use = &ops[numOps++];
+    use->user = this;
+    use->setUsee(val);
+}
 
-    // 增加到操作数中
-    operands.push_back(use);
+///
+/// @brief 删除指定位置的Use，后面的Use依次前移，不处理被删除Use的def-use边
+/// @param pos 位置
+///
+void User::eraseOperand(int32_t pos)
+{
+    for (int32_t k = pos + 1; k < numOps; ++k) {
+        ops[k - 1].moveFrom(ops[k]);
+    }
 
-    // 该val被使用
-    val->addUse(use);
+    // 最后的位置空出，以便再次加入操作数
+    ops[--numOps] = Use();
 }
 
 ///
 /// @brief 清除指定的操作数
 /// @param val 操作数
 ///
-void User::removeOperand(Value * val_to_remove) {
-    if (!val_to_remove) return;
-
-    // 遍历查找对应的 Use 对象
-    for (auto it = operands.begin(); it != operands.end(); ++it) {
-        Use* use_edge = *it;
-        if (use_edge && use_edge->getUsee() == val_to_remove) {
-            operands.erase(it); // 从 User 的 operands 列表移除
+void User::removeOperand(Value * val)
+{
+    if (!val) {
+        return;
+    }
 
-            // value_being_used 就是 val_to_remove
-            val_to_remove->removeUse(use_edge); // 通知 Value 移除
-            delete use_edge; // 删除 Use 对象
-            return; // 假设每个 Value 只作为操作数出现一次，找到就返回
+    // 假设每个 Value 只作为操作数出现一次，找到就返回
+    for (int32_t k = 0; k < numOps; ++k) {
+        if (ops[k].getUsee() == val) {
+            removeOperand(k);
+            return;
         }
     }
 }
@@ -84,33 +153,22 @@ void User::removeOperand(Value * val_to_remove) {
 /// @brief 清除指定的操作数
 /// @param pos 操作数的索引
 ///
-void User::removeOperand(int pos) {
-    if (pos >= 0 && pos < (int32_t)operands.size()) {
-        Use * use_edge = operands[pos]; // 获取要删除的 Use
-
-        // 1. 从 User 的 operands 列表中移除 (erase会使后续迭代器/索引失效，所以要小心)
-        //    一种安全的方式是先获取，再移除，再处理
-        operands.erase(operands.begin() + pos);
-
-        if (use_edge) {
-            Value* value_being_used = use_edge->getUsee();
-            if (value_being_used) {
-                value_being_used->removeUse(use_edge);
-            }
-            delete use_edge; // 删除 Use 对象
-        }
+void User::removeOperand(int pos)
+{
+    if (pos >= 0 && pos < numOps) {
+        ops[pos].setUsee(nullptr);
+        eraseOperand(pos);
     }
 }
 
 ///
-/// @brief 清除指定的操作数
-/// @param pos 操作数的索引
+/// @brief 直接清除操作数的元素，def-use边已由调用者断开
+/// @param use 指定的元素use
 ///
 void User::removeOperandRaw(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
-        operands.erase(pIter);
+    if (use >= ops && use < ops + numOps) {
+        eraseOperand((int32_t) (use - ops));
     }
 }
 
@@ -120,8 +178,7 @@ void User::removeOperandRaw(Use * use)
 ///
 void User::removeUse(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
+    if (use >= ops && use < ops + numOps) {
         use->remove();
     }
 }
@@ -129,34 +186,12 @@ void User::removeUse(Use * use)
 ///
 /// @brief 清除所有的操作数
 ///
-// User.cpp
-void User::clearOperands() {
-    // 从后向前遍历并删除，这样在删除元素时不会影响后续迭代
-    while (!operands.empty()) {
-        Use* use_edge = operands.back(); // 获取最后一个 Use 对象
-        operands.pop_back();             // 从 User 的 operands 列表中移除指针
-
-        if (use_edge) {
-            Value* value_being_used = use_edge->getUsee(); // 获取被该 Use 边指向的 Value
-            if (value_being_used) {
-                // 通知被使用的 Value 对象，移除这个 Use 引用
-                // Value::removeUse 应该只从 Value::uses 向量中移除指针，不 delete Use 对象
-                value_being_used->removeUse(use_edge);
-            }
-            // User 作为 Use 对象的所有者，负责 delete 它
-            delete use_edge;
-            use_edge = nullptr; // 好习惯
-        }
-    }
-    // operands vector 现在应该是空的
-}
-///
-/// @brief Get the Operands object
-/// @return std::vector<Use *>&
-///
-std::vector<Use *> & User::getOperands()
+void User::clearOperands()
 {
-    return operands;
+    // 断开def-use边，Use的空间保留给后续的操作数
+    while (numOps > 0) {
+        ops[--numOps].setUsee(nullptr);
+    }
 }
 
 ///
@@ -166,31 +201,9 @@ std::vector<Use *> & User::getOperands()
 std::vector<Value *> User::getOperandsValue() const
 {
     std::vector<Value *> operandsVec;
-    for (auto & use: operands) {
-        operandsVec.emplace_back(use->getUsee());
+    operandsVec.reserve(numOps);
+    for (int32_t k = 0; k < numOps; ++k) {
+        operandsVec.emplace_back(ops[k].getUsee());
     }
     return operandsVec;
 }
-
-///
-/// @brief 获取操作数的个数
-/// @return int32_t 个数
-///
-int32_t User::getOperandsNum() const
-{
-    return (int32_t) operands.size();
-}
-
-///
-/// @brief 获取指定的操作数
-/// @param pos 位置
-/// @return Value* 操作数
-///
-Value * User::getOperand(int32_t pos) const
-{
-    if (pos < (int32_t) operands.size()) {
-        return operands[pos]->getUsee();
-    }
-
-    return nullptr;
-}
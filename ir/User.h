@@ -3,8 +3,8 @@
 /// @brief 使用Value的User，该User也是Value。函数、指令都是User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,16 +12,24 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>操作数的Use按位置内嵌存放，超过3个时整体搬到另外分配的数组
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
 /// </table>
 ///
 #pragma once
 
-#include <unordered_map>
-#include <list>
+#include <cstdint>
+#include <vector>
 
 #include "Value.h"
 #include "Use.h"
-class Use; // 前向声明
+
+class Arena;
+
+/// @brief User内嵌的Use个数，常见指令的操作数不超过这个个数，不需要另外分配
+#define USER_INLINE_OPERANDS 3
+
 ///
 /// @brief 本身代表一个Value，这个Value可通过其中的操作数计算得到
 ///
@@ -29,28 +37,99 @@ class Use; // 前向声明
 /// User可以是指令(Instruction)、常量表达式(ConstantExpr)、全局变量(GlobalVariable)等。
 /// User持有对Value的引用，并且可以有多个Value作为其操作数(Operands)
 ///
+/// 操作数的Use按位置连续存放，不超过USER_INLINE_OPERANDS个时就在User内，
+/// 超过时整体搬到另外分配的数组中，如实参较多的函数调用指令。
+///
 class User : public Value {
 
     ///
-    /// @brief 操作数列表，指向当前Value的所有操作数
+    /// @brief 操作数的Use数组，指向inlineOps或者另外分配的数组
     ///
-    std::vector<Use *> operands;
+    Use * ops;
 
-public:
-	
+    ///
+    /// @brief 操作数个数
+    ///
+    int32_t numOps = 0;
+
+    ///
+    /// @brief ops数组的容量
+    ///
+    int32_t capOps = USER_INLINE_OPERANDS;
 
+    ///
+    /// @brief 内嵌的Use
+    ///
+    Use inlineOps[USER_INLINE_OPERANDS];
+
+    ///
+    /// @brief 扩大ops数组的容量，已有的Use搬到新的数组中
+    /// @param cap 新的容量
+    ///
+    void growOperands(int32_t cap);
+
+    ///
+    /// @brief 释放另外分配的ops数组，内嵌的或者从内存池中分配的不需要释放
+    ///
+    void freeOperands();
+
+    ///
+    /// @brief 删除指定位置的Use，后面的Use依次前移，不处理被删除Use的def-use边
+    /// @param pos 位置
+    ///
+    void eraseOperand(int32_t pos);
+
+protected:
+    ///
+    /// @brief 分配超出内嵌个数的Use数组的内存池，为空时从堆上分配，如函数内的指令使用函数的内存池
+    ///
+    Arena * useArena = nullptr;
+
+public:
     ///
     /// @brief 构造函数
     /// @param _type  类型
-    /// @param _name  名称
+    /// @param _kind  种类
+    ///
+    User(Type * _type, ValueKind _kind);
+
+    ///
+    /// @brief 析构函数，清除所有的操作数
     ///
-    User(Type * _type);
-	~User(); // <--- 添加析构函数声明
+    ~User() override;
+
+    User(const User &) = delete;
+    User & operator=(const User &) = delete;
+
+    /// @brief 用于isa/cast/dyn_cast，判断是否是User
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() >= ValueKind::Instruction;
+    }
+
+    ///
+    /// @brief 预留操作数的空间，已知操作数个数时可避免多次搬移
+    /// @param n 操作数个数
+    ///
+    void reserveOperands(int32_t n);
+
+    ///
+    /// @brief 第一个操作数的Use
+    /// @return Use*
+    ///
+    Use * op_begin()
+    {
+        return ops;
+    }
+
     ///
-    /// @brief Get the Operands object
-    /// @return std::vector<Use *>&
+    /// @brief 最后一个操作数的Use之后的位置
+    /// @return Use*
     ///
-    std::vector<Use *> & getOperands();
+    Use * op_end()
+    {
+        return ops + numOps;
+    }
 
     ///
     /// @brief 取得操作数
@@ -62,14 +141,20 @@ public:
     /// @brief 获取操作数的个数
     /// @return int32_t 个数
     ///
-    [[nodiscard]] int32_t getOperandsNum() const; 
+    [[nodiscard]] int32_t getOperandsNum() const
+    {
+        return numOps;
+    }
 
     ///
     /// @brief 获取指定的操作数
     /// @param pos 位置
-    /// @return Value* 操作数
+    /// @return Value* 操作数，位置无效时为空
     ///
-    [[nodiscard]] Value* getOperand(int32_t pos) const;
+    [[nodiscard]] Value * getOperand(int32_t pos) const
+    {
+        return pos < numOps ? ops[pos].getUsee() : nullptr;
+    }
 
     ///
     /// @brief 更新指定Pos的Value
@@ -80,7 +165,6 @@ public:
 
     ///
     /// @brief 增加操作数，或者说本身的值由这些操作数来计算得到
-    /// @param pos 索引位置
     /// @param val 值
     ///
     void addOperand(Value * val);
@@ -98,7 +182,7 @@ public:
     void removeOperand(Value * val);
 
     ///
-    /// @brief 直接清除操作数的元素
+    /// @brief 直接清除操作数的元素，def-use边已由调用者断开
     /// @param use 指定的元素use
     ///
     void removeOperandRaw(Use * use);
@@ -113,4 +197,4 @@ public:
     /// @brief 清除所有的操作数
     ///
     void clearOperands();
-};
\ No newline at end of file
+};
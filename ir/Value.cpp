@@ -3,8 +3,8 @@
 /// @brief 值操作类型，所有的变量、函数、常量都是Value
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.6
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,17 +12,23 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>use链表改为侵入式，增加replaceAllUsesWith、use_begin/use_end与hasOneUse
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>删除后端的寄存器与栈内位置，增加函数内的稠密编号
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>整型常量不记录use链表，共享时只读
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>整型常量上查询或替换use链表时断言失败，不再静默返回错误结果
 /// </table>
 ///
 
-#include <algorithm>
-
+#include "IRConstant.h"
 #include "Value.h"
 #include "Use.h"
 
 /// @brief 构造函数
-/// @param _type
-Value::Value(Type * _type) : type(_type)
+/// @param _type 类型
+/// @param _kind 种类
+Value::Value(Type * _type, ValueKind _kind) : type(_type), kind(_kind)
 {
     // 不需要增加代码
 }
@@ -30,7 +36,12 @@ Value::Value(Type * _type) : type(_type)
 /// @brief 析构函数
 Value::~Value()
 {
-    // 如有资源清理，请这里追加代码
+    // 仍在使用本Value的边与之断开，User之后清理操作数时不再访问已释放的Value
+    while (useList) {
+        Use * use = useList;
+        removeUse(use);
+        use->usee = nullptr;
+    }
 }
 
 /// @brief 获取名字
@@ -49,32 +60,21 @@ void Value::setName(std::string _name)
     this->name = _name;
 }
 
-/// @brief 获取名字
-/// @return 变量名
+/// @brief 获取IR名字，按IR名字的编号生成
+/// @return IR名字
 std::string Value::getIRName() const
 {
-    if (IRName.empty()) { // 如果 IRName 还没有被显式设置（通过 setIRName）
-        // 对于未命名的Value (比如指令结果在被 renameIR 处理前)，
-        // 或者某些确实没有源码名的Value，生成一个唯一的临时占位符。
-        // 你的实现是 "UNNAMED_VALUE(...)" 或 "name_NO_IRNAME"，
-        // 这在 renameIR 之前是可接受的。
-        // renameIR 之后，所有应该有规范名称的 Value 都应该有非空的 IRName。
-        if (!name.empty()) { // 仅当 name 非空时才使用它作为后缀的基础
-            return name + "_IR_UNSET"; // 或者其他明确表示“尚未最终命名”的后缀
-        }
-        // 对于完全无名的（如大多数指令结果在最终命名之前）
-        return "TEMP_VAL_ADDR_" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    if (irSlot >= 0) {
+        const char * prefix = (kind == ValueKind::LocalVariable) ? IR_LOCAL_VARNAME_PREFIX : IR_TEMP_VARNAME_PREFIX;
+        return prefix + std::to_string(irSlot);
     }
-    return IRName;
-}
 
-///
-/// @brief 设置名字
-/// @param _name 名字
-///
-void Value::setIRName(std::string _name)
-{
-    this->IRName = _name;
+    // 尚未命名时，如调试日志中，有原始名字的用原始名字，否则用函数内的稠密编号区分
+    if (!name.empty()) {
+        return name;
+    }
+
+    return "%v" + std::to_string(valueIndex);
 }
 
 /// @brief 获取类型
@@ -90,7 +90,18 @@ Type * Value::getType() const
 ///
 void Value::addUse(Use * use)
 {
-    uses.push_back(use);
+    // 整型常量在模块间、线程间共享，不记录use链表，使其创建后只读
+    if (kind == ValueKind::ConstInt) {
+        return;
+    }
+
+    // 插入到链表头
+    use->next = useList;
+    if (useList) {
+        useList->prev = &use->next;
+    }
+    use->prev = &useList;
+    useList = use;
 }
 
 ///
@@ -99,36 +110,44 @@ void Value::addUse(Use * use)
 ///
 void Value::removeUse(Use * use)
 {
-    auto pIter = std::find(uses.begin(), uses.end(), use);
-    if (pIter != uses.end()) {
-        uses.erase(pIter);
+    // 不在链表中
+    if (!use->prev) {
+        return;
     }
+
+    *use->prev = use->next;
+    if (use->next) {
+        use->next->prev = use->prev;
+    }
+
+    use->next = nullptr;
+    use->prev = nullptr;
 }
 
 ///
-/// @brief 取得变量所在的作用域层级
-/// @return int32_t 层级
+/// @brief 所有使用本Value的地方改为使用newVal，每条边O(1)。
+/// 整型常量不记录use链表，找不到使用它的地方，不能替换
+/// @param newVal 新的Value
 ///
-int32_t Value::getScopeLevel() const
+void Value::replaceAllUsesWith(Value * newVal)
 {
-    return -1;
+    assert(kind != ValueKind::ConstInt && "replaceAllUsesWith() on ConstInt, whose uses are not recorded");
+
+    if (newVal == this) {
+        return;
+    }
+
+    // setUsee把链表头的边从本Value移到newVal上
+    while (useList) {
+        useList->setUsee(newVal);
+    }
 }
 
-/*
-/// @brief 获得分配的寄存器编号或ID
-/// @return int32_t 寄存器编号 -1代表无效的寄存器编号
 ///
-
+/// @brief 取得变量所在的作用域层级
+/// @return int32_t 层级
 ///
-/// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-/// @param regId 寄存器编号
-/// @param offset 相对偏移
-/// @return true 是内存型变量
-/// @return false 不是内存型变量
-///*/
-bool Value::getMemoryAddr(int32_t * regId, int64_t * offset)
+int32_t Value::getScopeLevel() const
 {
-    (void) regId;
-    (void) offset;
-    return false;
+    return -1;
 }
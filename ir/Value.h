@@ -3,8 +3,8 @@
 /// @brief 值操作类型，所有的变量、函数、常量都是Value
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.6
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,16 +12,50 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>use链表改为侵入式，增加replaceAllUsesWith、use_begin/use_end与hasOneUse
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>删除后端的寄存器与栈内位置，增加函数内的稠密编号
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>整型常量不记录use链表，共享时只读
+/// <tr><td>2026-10-16 <td>1.6     <td>zenglj  <td>整型常量上查询或替换use链表时断言失败，不再静默返回错误结果
 /// </table>
 ///
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <string>
 
+#include "Casting.h"
 #include "Use.h"
 #include "Type.h"
 
+///
+/// @brief Value的种类，构造时确定，isa/cast/dyn_cast据此判断对象的类
+///
+/// 同一个基类的派生类连续排列，基类的classof按范围判断。
+/// 指令只有一个种类，具体的指令类再按指令操作码区分。
+///
+enum class ValueKind : uint8_t {
+    FormalParam,
+    LocalVariable,
+    TempVariable,
+    MemVariable,
+    RegVariable,
+
+    // User的开始
+    Instruction,
+
+    // Constant的开始
+    ConstInt,
+
+    // GlobalValue的开始
+    GlobalVariable,
+    Function,
+};
+
 ///
 /// @brief 值类，每个值都要有一个类型，全局变量和局部变量可以有名字，
 /// 但通过运算得到的指令类值没有名字，只有在需要输出时给定名字即可
@@ -36,26 +70,35 @@ protected:
     std::string name;
 
     ///
-    /// @brief IR名字，用于文本IR的输出
+    /// @brief IR名字的编号，输出文本IR前由renameIR分配，-1表示尚未命名
+    ///
+    /// 名字字符串只在输出时按编号生成，不输出IR时不产生名字字符串
     ///
-    std::string IRName;
+    int32_t irSlot = -1;
 
     /// @brief 类型
     Type * type;
 
+    /// @brief 种类
+    const ValueKind kind;
+
+    ///
+    /// @brief 函数内的稠密编号，从0开始连续分配，不属于函数的Value为-1
     ///
-    /// @brief define-use链，这个定值被使用的所有边，即所有的User
+    /// 后端的寄存器与栈分配、分析用的向量与位图都以此编号为下标
     ///
-    std::vector<Use *> uses;
+    int32_t valueIndex = -1;
 
+    ///
+    /// @brief define-use链的链表头，这个定值被使用的所有边，即所有的User
+    ///
+    Use * useList = nullptr;
 
-     // --- B1: 新增成员变量来存储由分配器分配的寄存器ID ---
-	 int32_t allocatedRegisterId_ = -1; 
-	 // --- 结束 B1 新增 ---
 public:
     /// @brief 构造函数
-    /// @param _type
-    explicit Value(Type * _type);
+    /// @param _type 类型
+    /// @param _kind 种类
+    Value(Type * _type, ValueKind _kind);
 
     /// @brief 析构函数
     virtual ~Value();
@@ -70,22 +113,51 @@ public:
     ///
     void setName(std::string _name);
 
-    /// @brief 获取名字
-    /// @return 变量名
+    /// @brief 获取IR名字，按IR名字的编号生成
+    /// @return IR名字
     [[nodiscard]] virtual std::string getIRName() const;
 
-    ///
-    /// @brief 设置名字
-    /// @param _name 名字
-    ///
-    void setIRName(std::string _name);
+    /// @brief 获取IR名字的编号
+    /// @return 编号，-1表示尚未命名
+    [[nodiscard]] int32_t getIRSlot() const
+    {
+        return irSlot;
+    }
+
+    /// @brief 设置IR名字的编号，由renameIR分配
+    /// @param slot 编号
+    void setIRSlot(int32_t slot)
+    {
+        irSlot = slot;
+    }
 
     /// @brief 获取类型
     /// @return 变量名
     [[nodiscard]] virtual Type * getType() const;
 
+    /// @brief 获取种类
+    /// @return 种类
+    [[nodiscard]] ValueKind getValueKind() const
+    {
+        return kind;
+    }
+
+    /// @brief 获取函数内的稠密编号
+    /// @return 编号，不属于函数的Value为-1
+    [[nodiscard]] int32_t getValueIndex() const
+    {
+        return valueIndex;
+    }
+
+    /// @brief 设置函数内的稠密编号，由Function::numberValue分配
+    /// @param index 编号
+    void setValueIndex(int32_t index)
+    {
+        valueIndex = index;
+    }
+
     ///
-    /// @brief 增加一条边，增加Value被使用次数
+    /// @brief 增加一条边，增加Value被使用次数。整型常量不记录，其use链表总是空的
     /// @param use
     ///
     void addUse(Use * use);
@@ -97,49 +169,103 @@ public:
     void removeUse(Use * use);
 
     ///
-    /// @brief 取得变量所在的作用域层级
-    /// @return int32_t 层级
+    /// @brief use链表的前向迭代器，解引用得到Use
     ///
-    [[nodiscard]] virtual int32_t getScopeLevel() const;
+    class use_iterator {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Use *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Use * const *;
+        using reference = Use *;
+
+        explicit use_iterator(Use * _use = nullptr) : use(_use)
+        {}
+
+        Use * operator*() const
+        {
+            return use;
+        }
+
+        use_iterator & operator++()
+        {
+            use = use->getNext();
+            return *this;
+        }
+
+        use_iterator operator++(int)
+        {
+            use_iterator old = *this;
+            use = use->getNext();
+            return old;
+        }
 
+        bool operator==(const use_iterator & other) const
+        {
+            return use == other.use;
+        }
+
+        bool operator!=(const use_iterator & other) const
+        {
+            return use != other.use;
+        }
+
+    private:
+        /// @brief 当前的Use，空指针表示结尾
+        Use * use;
+    };
 
-	
-    
     ///
-    /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
+    /// @brief 第一条define-use边，遍历时不能修改当前边指向的Value
+    /// @return use_iterator
     ///
-    // --- B1: 修改这些函数以使用 allocatedRegisterId_ ---
-    // getRegId() 现在也反映由分配器分配的寄存器ID
-    // 子类 (如 LocalVariable) 如果有不同的 regId 概念可以覆盖它
-    virtual int32_t getRegId() { return allocatedRegisterId_; } 
-    // setRegId() 也操作 allocatedRegisterId_
-    virtual void setRegId(int32_t regId) { allocatedRegisterId_ = regId; }
+    [[nodiscard]] use_iterator use_begin() const
+    {
+        return use_iterator(useList);
+    }
+
     ///
+    /// @brief 最后一条define-use边之后的位置
+    /// @return use_iterator
+    ///
+    [[nodiscard]] use_iterator use_end() const
+    {
+        return use_iterator();
+    }
+
     ///
-    // SimpleRegisterAllocator 主要使用 getLoadRegId / setLoadRegId
-    // 让它们也操作 allocatedRegisterId_
-    virtual int32_t getLoadRegId() { return allocatedRegisterId_; }
-    virtual void setLoadRegId(int32_t regId) { allocatedRegisterId_ = regId; }
-    // --- 结束 B1 修改 ---
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
+    /// @brief 是否没有被使用。整型常量不记录use链表，不能查询
+    /// @return true 没有User
     ///
-    virtual bool getMemoryAddr(int32_t * regId = nullptr, int64_t * offset = nullptr);
+    [[nodiscard]] bool use_empty() const
+    {
+        assert(kind != ValueKind::ConstInt && "use_empty() on ConstInt, whose uses are not recorded");
+        return useList == nullptr;
+    }
 
     ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
+    /// @brief 是否恰好被使用一次。整型常量不记录use链表，不能查询
+    /// @return true 只有一条define-use边
     ///
+    [[nodiscard]] bool hasOneUse() const
+    {
+        assert(kind != ValueKind::ConstInt && "hasOneUse() on ConstInt, whose uses are not recorded");
+        return useList != nullptr && useList->getNext() == nullptr;
+    }
 
+    ///
+    /// @brief 所有使用本Value的地方改为使用newVal，每条边O(1)。
+    /// 整型常量不记录use链表，找不到使用它的地方，不能替换
+    /// @param newVal 新的Value
+    ///
+    void replaceAllUsesWith(Value * newVal);
 
     ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
+    /// @brief 取得变量所在的作用域层级
+    /// @return int32_t 层级
     ///
+    [[nodiscard]] virtual int32_t getScopeLevel() const;
 
     [[nodiscard]] virtual bool isConstant() const { return false; }
 };
@@ -4,13 +4,10 @@
 #include <stdexcept> // 用于错误处理
 
 ConstInt::ConstInt(Type* type, int32_t val)
-    : Constant(type), intVal(val) { // 调用 Constant 基类的构造函数
+    : Constant(type, ValueKind::ConstInt), intVal(val) { // 调用 Constant 基类的构造函数
     if (!type || !type->isIntegerType()) { // 确保传入的是整数类型
         throw std::invalid_argument("ConstInt 必须使用整数类型初始化。");
     }
-    // 设置 Value 基类的名字为其字符串表示
-    // 假设 User/Value 有 setName(const std::string&)
-    this->setIRName(std::to_string(val)); 
 }
 
 std::string ConstInt::getName() const {
@@ -3,8 +3,8 @@
 /// @brief int类型的常量
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.4
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,10 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>删除后端的寄存器与栈内位置
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>整型常量不记录use链表，共享时只读
 /// </table>
 ///
 
@@ -25,27 +29,32 @@ class Module;
 ///
 /// @brief 整型常量类
 ///
+/// 同一类型同一值的常量只有一份，由各线程、各模块共享。常量不记录use链表，
+/// 创建后不再修改，因此共享时不需要加锁。
+///
 class ConstInt : public Constant {
 
 	public:
     // 修改构造函数以接受 Type* 和 int32_t 值
     ConstInt(Type* type, int32_t val);
 
-    // getIRName() 应该与 Value 基类中的 getName() 匹配并 override
-    // 如果 Value 中是 getName(), 这里也应该是 getName()
+    /// @brief 用于isa/cast/dyn_cast，判断是否是整型常量
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::ConstInt;
+    }
 
-    [[nodiscard]] std::string getName() const override; // 或者 getIRName() 如果基类是这个
+    [[nodiscard]] std::string getName() const override;
 
-    [[nodiscard]] int32_t getVal() const { // 标记为 const
-        return intVal;
+    /// @brief 获取IR名字，整型常量的IR名字就是其值
+    /// @return IR名字
+    [[nodiscard]] std::string getIRName() const override
+    {
+        return std::to_string(intVal);
     }
 
-    // setLoadRegId 和 getLoadRegId 看起来是从 User/Value 继承的，保持不变
-    int32_t getLoadRegId() override {
-        return this->loadRegNo;
-    }
-    void setLoadRegId(int32_t regId) override {
-        this->loadRegNo = regId;
+    [[nodiscard]] int32_t getVal() const { // 标记为 const
+        return intVal;
     }
 
     // 静态方法用于获取/创建特定类型的整数常量，并由 Module 管理缓存 (推荐)
@@ -57,9 +66,4 @@ private:
     /// @brief 整数值
     ///
     int32_t intVal;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
\ No newline at end of file
@@ -3,8 +3,8 @@
 /// @brief 全局变量描述类
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>删除后端的寄存器与栈内位置
 /// </table>
 ///
 #pragma once
@@ -30,11 +32,17 @@ public:
     /// @param _type 类型
     /// @param _name 名字
     ///
-    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(_type, _name)
+    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(_type, _name, ValueKind::GlobalVariable)
     {
         setAlignment(4);
     }
 
+    /// @brief 用于isa/cast/dyn_cast，判断是否是全局变量
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::GlobalVariable;
+    }
+
     ///
     /// @brief  检查是否是函数
     /// @return true 是函数
@@ -64,24 +72,6 @@ public:
         return 0;
     }
 
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
-    }
-
     ///
     /// @brief Declare指令IR显示
     /// @param str
@@ -92,11 +82,6 @@ public:
     void setInitializer(Constant * initVal);
     [[nodiscard]] Constant * getInitializer() const;
 private:
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
-
     ///
     /// @brief 默认全局变量在BSS段，没有初始化，或者即使初始化过，但都值都为0
     ///
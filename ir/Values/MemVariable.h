@@ -3,8 +3,8 @@
 /// @brief 内存变量，用于栈内变量的描述。用于后端处理
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,9 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>函数内的指令、Use与变量从函数的内存池分配，整体释放
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>删除后端的寄存器与栈内位置
 /// </table>
 ///
 #pragma once
@@ -23,76 +26,18 @@
 class MemVariable : public Value {
 
     friend class Function;
+    friend class Arena;
 
 private:
     /// @brief 创建内存Value
     /// \param val
-    explicit MemVariable(Type * _type) : Value(_type)
+    explicit MemVariable(Type * _type) : Value(_type, ValueKind::MemVariable)
     {}
 
 public:
-    ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
-    ///
-    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) override
+    /// @brief 用于isa/cast/dyn_cast，判断是否是内存变量
+    static bool classof(const Value * val)
     {
-        // 肯定是内存地址
-
-        if (_regId) {
-            *_regId = this->baseRegNo;
-        }
-        if (_offset) {
-            *_offset = this->offset;
-        }
-
-        return true;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
+        return val->getValueKind() == ValueKind::MemVariable;
     }
-
-    ///
-    /// @brief 设置内存寻址的基址寄存器和偏移
-    /// @param _regId 基址寄存器编号
-    /// @param _offset 偏移
-    ///
-    void setMemoryAddr(int32_t _regId, int64_t _offset)
-    {
-        baseRegNo = _regId;
-        offset = _offset;
-    }
-
-private:
-    /// @brief 变量在栈内的偏移量，对于全局变量默认为0，临时变量没有意义
-    int32_t offset = 0;
-
-    /// @brief 栈内寻找时基址寄存器编号
-    int32_t baseRegNo = -1;
-
-    /// @brief 栈内寻找时基址寄存器名字
-    std::string baseRegName;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
@@ -3,8 +3,8 @@
 /// @brief 寄存器变量类，用于后端
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>Value增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>删除后端的寄存器与栈内位置
 /// </table>
 ///
 #pragma once
@@ -24,17 +26,23 @@ class RegVariable : public Value {
 public:
     /// @brief 整型寄存器型Value
     /// \param val
-    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(_type)
+    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(_type, ValueKind::RegVariable)
     {
         this->name = _name;
         regId = _reg_no;
     }
 
+    /// @brief 用于isa/cast/dyn_cast，判断是否是寄存器变量
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::RegVariable;
+    }
+
     ///
-    /// @brief 获得分配的寄存器编号或ID
+    /// @brief 获得寄存器编号
     /// @return int32_t 寄存器编号
     ///
-    int32_t getRegId() override
+    [[nodiscard]] int32_t getRegId() const
     {
         return regId;
     }
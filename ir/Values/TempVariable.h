@@ -5,7 +5,13 @@
 
 class TempVariable : public Value {
 public:
-    TempVariable(Type* type, const std::string& name);
+    explicit TempVariable(Type* type);
+
+    /// @brief 用于isa/cast/dyn_cast，判断是否是临时变量
+    static bool classof(const Value * val)
+    {
+        return val->getValueKind() == ValueKind::TempVariable;
+    }
     //std::string toString() const override; // 或与 Instruction::toString 匹配
     // 如果 Value 有 getName(), 也 override 它
     // std::string getName() const override;
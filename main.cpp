@@ -10,6 +10,7 @@
  */
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <getopt.h>
 
@@ -74,6 +75,9 @@ static bool gFrontEndRecursiveDescentParsing = false;
 ///
 static bool gAsmAlsoShowIR = false;
 
+/// @brief 递归下降分析的线程数，即-j后面的数字，默认为1顺序分析，0按CPU核数
+static unsigned gFrontEndJobs = 1;
+
 /// @brief 优化的级别，即-O后面的数字，默认为0
 static int gOptLevel = 0;
 
@@ -86,6 +90,20 @@ static std::string gInputFile;
 /// @brief 输出文件，不同的选项输出的内容不同
 static std::string gOutputFile;
 
+/// @brief 抽象语法树输出的选项，可只输出指定的函数，或者限制输出的深度
+static ASTOutputOptions gASTOptions;
+
+/// @brief 表达式按Sethi-Ullman寄存器需求数确定操作数的求值次序
+static bool gSethiUllmanOrder = false;
+
+/// @brief 没有短选项的长选项的编号，避免与短选项字符冲突
+enum {
+    OPTION_AST_FUNC = 256,
+    OPTION_AST_DEPTH,
+    OPTION_SETHI_ULLMAN,
+    OPTION_DEBUG_LOG,
+};
+
 static struct option long_options[] = {
     {"help", no_argument, 0, 'h'},
     {"output", required_argument, 0, 'o'},
@@ -97,6 +115,11 @@ static struct option long_options[] = {
     {"optimize", required_argument, 0, 'O'},
     {"target", required_argument, 0, 't'},
     {"asmir", no_argument, 0, 'c'},
+    {"jobs", required_argument, 0, 'j'},
+    {"ast-func", required_argument, 0, OPTION_AST_FUNC},
+    {"ast-depth", required_argument, 0, OPTION_AST_DEPTH},
+    {"sethi-ullman", no_argument, 0, OPTION_SETHI_ULLMAN},
+    {"debug", no_argument, 0, OPTION_DEBUG_LOG},
     {0, 0, 0, 0}
 };
 
@@ -116,6 +139,13 @@ static void showHelp(const std::string & exeName)
     std::cout << "  -O, --optimize=LEVEL       Set optimization level\n";
     std::cout << "  -t, --target=CPU           Specify target CPU architecture\n";
     std::cout << "  -c, --asmir                Show IR instructions as comments in assembly output\n";
+    std::cout << "  -j, --jobs=N               Parse top-level definitions on N threads (0: one per CPU), implies -D\n";
+    std::cout << "      --ast-func=NAME        With -T, output only the AST of function NAME\n";
+    std::cout << "      --ast-depth=N          With -T, output the AST down to depth N only\n";
+    std::cout << "      --sethi-ullman         Evaluate the operand needing more registers first\n";
+    std::cout << "      --debug                Output debug logs\n";
+    std::cout << "AST output format with -T follows the output file suffix: .txt/.ast indented text, .json JSON,\n";
+    std::cout << ".dot/.gv DOT text, written without layout; other suffixes such as png/svg/pdf render an image\n";
 }
 
 /// @brief 参数解析与有效性检查
@@ -134,7 +164,10 @@ static int ArgsAnalysis(int argc, char * argv[])
     // -O要求必须带有附加整数，指明优化的级别
     // -t要求必须带有目标CPU，指明目标CPU的汇编
     // -c选项在输出汇编时有效，附带输出IR指令内容
-    const char options[] = "ho:STIADO:t:c";
+    // -j要求必须带有附加整数，指定递归下降分析的线程数，同时选择递归下降分析法
+    // --ast-func与--ast-depth在输出抽象语法树时有效，只输出指定函数的子树或者限制深度
+    // --debug输出调试日志
+    const char options[] = "ho:STIADO:t:cj:";
     int option_index = 0;
 
     opterr = 1;
@@ -172,7 +205,7 @@ lb_check:
                 gFrontEndRecursiveDescentParsing = true;
                 break;
             case 'O':
-                // 优化级别分析，暂时没有用，如开启优化时请使用
+                // 优化级别，1及以上时IR生成阶段折叠常量表达式与常量条件
                 gOptLevel = std::stoi(optarg);
                 break;
             case 't':
@@ -181,6 +214,29 @@ lb_check:
             case 'c':
                 gAsmAlsoShowIR = true;
                 break;
+            case 'j':
+                // 全局声明与函数定义之间相互独立，切分后多线程递归下降分析
+                gFrontEndJobs = (unsigned) std::stoul(optarg);
+                gFrontEndAntlr4 = false;
+                gFrontEndFlexBison = false;
+                gFrontEndRecursiveDescentParsing = true;
+                break;
+            case OPTION_AST_FUNC:
+                // 只输出指定函数的抽象语法树
+                gASTOptions.funcName = optarg;
+                break;
+            case OPTION_AST_DEPTH:
+                // 抽象语法树输出的最大深度
+                gASTOptions.maxDepth = std::stoi(optarg);
+                break;
+            case OPTION_SETHI_ULLMAN:
+                // 寄存器需求数多的操作数先求值，减少寄存器溢出
+                gSethiUllmanOrder = true;
+                break;
+            case OPTION_DEBUG_LOG:
+                // 输出调试日志，缺省时调试日志不生成也不输出
+                minic_log_level = LOG_DEBUG;
+                break;
             default:
                 return -1;
                 break; /* no break */
@@ -276,13 +332,13 @@ static int compile(std::string inputFile, std::string outputFile)
             frontEndExecutor = new Antlr4Executor(inputFile);
         } else if (gFrontEndRecursiveDescentParsing) {
             // 递归下降分析法
-            frontEndExecutor = new RecursiveDescentExecutor(inputFile);
+            frontEndExecutor = new RecursiveDescentExecutor(inputFile, gFrontEndJobs);
         } else {
             // 默认为Flex+Bison
             frontEndExecutor = new FlexBisonExecutor(inputFile);
         }
 
-        // 前端执行：词法分析、语法分析后产生抽象语法树，其root为全局变量ast_root
+        // 前端执行：词法分析、语法分析后产生抽象语法树，其root保存在执行器中
         subResult = frontEndExecutor->run();
         if (!subResult) {
 
@@ -291,8 +347,9 @@ static int compile(std::string inputFile, std::string outputFile)
             break;
         }
 
-        // 获取抽象语法树的根节点
+        // 获取抽象语法树的根节点与其所在的上下文，上下文释放时整体释放AST
         ast_node * astRoot = frontEndExecutor->getASTRoot();
+        std::unique_ptr<ASTContext> astContext = frontEndExecutor->takeASTContext();
 
         // 清理前端资源
         delete frontEndExecutor;
@@ -301,14 +358,14 @@ static int compile(std::string inputFile, std::string outputFile)
 
         if (gShowAST) {
 
-            // 遍历抽象语法树，生成抽象语法树图片
-            OutputAST(astRoot, outputFile);
+            // 遍历抽象语法树，按输出文件的后缀输出图片或者文本
+            subResult = OutputAST(astRoot, outputFile, gASTOptions);
 
             // 清理抽象语法树
-            free_ast(astRoot);
+            astContext.reset();
 
-            // 设置返回结果：正常
-            result = 0;
+            // 设置返回结果
+            result = subResult ? 0 : -1;
 
             break;
         }
@@ -319,7 +376,8 @@ static int compile(std::string inputFile, std::string outputFile)
         // 符号表，保存所有的变量以及函数等信息
         module_ptr = new Module(inputFile); 
         // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
-        IRGenerator ast2IR(astRoot, module_ptr);
+        IRGenerator ast2IR(astRoot, *astContext, module_ptr, gOptLevel);
+        ast2IR.setSethiUllmanOrder(gSethiUllmanOrder);
         subResult = ast2IR.run();
         if (!subResult) {
 
@@ -330,7 +388,17 @@ static int compile(std::string inputFile, std::string outputFile)
         }
 
         // 清理抽象语法树
-        free_ast(astRoot);
+        astContext.reset();
+
+        // 优化时建立各函数的控制流图，删除入口不可达的基本块，再拼接回线性IR供后端使用
+        if (gOptLevel >= 1) {
+            for (auto func: module_ptr->getFunctionList()) {
+                if (!func->isBuiltin() && func->buildCFG()) {
+                    (void) func->removeUnreachableBlocks();
+                    func->flattenCFG();
+                }
+            }
+        }
 
         if (gShowLineIR) {
 
@@ -2,8 +2,8 @@
 /// @file Module.cpp
 /// @brief  符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.5
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,11 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>名字查找改为按标识符驻留编号
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>整型常量统一为按(类型, 值)的加锁常量表，预建小整数常量
+/// <tr><td>2026-10-16 <td>1.3     <td>zenglj  <td>指令从函数的内存池分配
+/// <tr><td>2026-10-16 <td>1.4     <td>zenglj  <td>形参与函数内临时变量在函数内稠密编号
+/// <tr><td>2026-10-16 <td>1.5     <td>zenglj  <td>IR名字改为按编号在输出时生成，不输出IR时不产生名字字符串
 /// </table>
 ///
 #include "Module.h"
@@ -74,7 +79,7 @@ void Module::setCurrentFunction(Function * current)
 Function * Module::newFunction(std::string name, Type * returnType, std::vector<FormalParam *> params, bool builtin)
 {
     // 先根据函数名查找函数，若找到则出错
-    Function * tempFunc = findFunction(name);
+    Function * tempFunc = findFunction(intern_symbol(name));
     if (tempFunc) {
         // 函数已存在
         return nullptr;
@@ -93,8 +98,11 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
     // 新建函数对象
     tempFunc = new Function(name, type, builtin);
 
-    // 设置参数
+    // 设置参数，形参在函数内最先编号
     tempFunc->getParams().assign(params.begin(), params.end());
+    for (auto * param: tempFunc->getParams()) {
+        tempFunc->numberValue(param);
+    }
 
     insertFunctionDirectly(tempFunc);
 
@@ -102,9 +110,9 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
 }
 
 /// @brief 根据函数名查找函数信息
-/// @param name 函数名
+/// @param name 函数名的驻留编号
 /// @return 函数信息
-Function * Module::findFunction(std::string name)
+Function * Module::findFunction(SymbolId name)
 {
     // 根据名字查找
     auto pIter = funcMap.find(name);
@@ -122,7 +130,7 @@ Function * Module::findFunction(std::string name)
 ///
 void Module::insertFunctionDirectly(Function * func)
 {
-    funcMap.insert({func->getName(), func});
+    funcMap.insert({intern_symbol(func->getName()), func});
     funcVector.emplace_back(func);
 }
 
@@ -131,31 +139,35 @@ void Module::insertFunctionDirectly(Function * func)
 /// @param val Value信息
 void Module::insertGlobalValueDirectly(GlobalVariable * val)
 {
-    globalVariableMap.emplace(val->getName(), val);
+    globalVariableMap.emplace(intern_symbol(val->getName()), val);
     globalVariableVector.push_back(val);
 }
 
-/// @brief Value直接插入到符号表中的全局变量中
-/// @param name Value的名称
-/// @param val Value信息
+/// @brief ConstInt直接插入到常量表中，已存在同类型同值的常量时不插入
+/// @param val 常量
 void Module::insertConstIntDirectly(ConstInt * val)
 {
-    constIntMap.emplace(val->getVal(), val);
-}
+    std::lock_guard<std::mutex> lock(constIntMutex);
 
-/// @brief 新建一个整型数值的Value，并加入到符号表，用于后续释放空间
-/// @param intVal 整数值
-/// @return 常量Value
+    constIntTable.emplace(ConstIntKey{val->getType(), val->getVal()}, val);
+}
 
-/// @brief 根据整数值获取当前符号
-/// \param name 变量名
-/// \return 变量对应的值
+/// @brief 根据整数值查找int类型的常量
+/// \param val 整数值
+/// \return 常量，不存在时为空
 ConstInt * Module::findConstInt(int32_t val)
 {
-    ConstInt * temp = nullptr;
+    IntegerType * type = IntegerType::getTypeInt();
+
+    ConstInt * temp = type->getSmallConstant(val);
+    if (temp) {
+        return temp;
+    }
 
-    auto pIter = constIntMap.find(val);
-    if (pIter != constIntMap.end()) {
+    std::lock_guard<std::mutex> lock(constIntMutex);
+
+    auto pIter = constIntTable.find(ConstIntKey{type, val});
+    if (pIter != constIntTable.end()) {
         // 查找到
         temp = pIter->second;
     }
@@ -168,18 +180,17 @@ ConstInt * Module::findConstInt(int32_t val)
 /// @param type 变量类型
 /// @param name 变量ID 局部变量时可以为空，目的为了SSA时创建临时的局部变量，
 /// @return nullptr则说明变量已存在，否则为新建的变量
-Value * Module::newVarValue(Type * type, std::string name)
+Value * Module::newVarValue(Type * type, SymbolId name)
 {
     Value * retVal;
-    std::string varName;
 
     // 若变量名有效，检查当前作用域中是否存在变量，如存在则语义错误
     // 反之，因无效需创建新的变量名，肯定不现在的不同，不需要查找
-    if (!name.empty()) {
+    if (name != SYMBOL_NONE) {
         Value * tempValue = scopeStack->findCurrentScope(name);
         if (tempValue) {
             // 变量存在，语义错误
-            minic_log(LOG_ERROR, "变量(%s)已经存在", name.c_str());
+            minic_log(LOG_ERROR, "变量(%s)已经存在", symbol_name(name).c_str());
             return nullptr;
         }
     } else if (!currentFunc) {
@@ -192,20 +203,20 @@ Value * Module::newVarValue(Type * type, std::string name)
 
         // 获取变量作用域的层级
         int32_t scope_level;
-        if (name.empty()) {
+        if (name == SYMBOL_NONE) {
             scope_level = 1;
         } else {
             scope_level = scopeStack->getCurrentScopeLevel();
         }
 
-        retVal = currentFunc->newLocalVarValue(type, name, scope_level);
+        retVal = currentFunc->newLocalVarValue(type, symbol_name(name), scope_level);
 
     } else {
         retVal = newGlobalVariable(type, name);
     }
 
     // 增加做作用域中
-    scopeStack->insertValue(retVal);
+    scopeStack->insertValue(name, retVal);
 
     return retVal;
 }
@@ -215,7 +226,7 @@ Value * Module::newVarValue(Type * type, std::string name)
 ///
 /// @param name 变量ID
 /// @return 指针有效则找到，空指针未找到
-Value * Module::findVarValue(std::string name)
+Value * Module::findVarValue(SymbolId name)
 {
     // 逐层级作用域查找
     Value * tempValue = scopeStack->findAllScope(name);
@@ -229,9 +240,9 @@ Value * Module::findVarValue(std::string name)
 /// @param name 名字
 /// @return Value* 全局变量
 ///
-GlobalVariable * Module::newGlobalVariable(Type * type, std::string name)
+GlobalVariable * Module::newGlobalVariable(Type * type, SymbolId name)
 {
-    GlobalVariable * val = new GlobalVariable(type, name);
+    GlobalVariable * val = new GlobalVariable(type, symbol_name(name));
 
     insertGlobalValueDirectly(val);
 
@@ -242,7 +253,7 @@ GlobalVariable * Module::newGlobalVariable(Type * type, std::string name)
 /// @param name 变量名或者常量名
 /// @param create 变量查找不到时若为true则自动创建变量型Value，否则不创建
 /// @return 变量对应的值
-GlobalVariable * Module::findGlobalVariable(std::string name)
+GlobalVariable * Module::findGlobalVariable(SymbolId name)
 {
     GlobalVariable * temp = nullptr;
 
@@ -268,6 +279,12 @@ void Module::Delete()
         delete var;
     }
 
+    // 清理常量，预先创建的小整数常量随类型一直保留
+    for (auto & [key, val]: constIntTable) {
+        delete val;
+    }
+    constIntTable.clear();
+
     // 相关列表清空
     globalVariableMap.clear();
     globalVariableVector.clear();
@@ -302,19 +319,24 @@ void Module::outputIR(const std::string & filePath)
         return;
     }
 
+    // 所有的输出共用一个缓冲区，每次输出后清空内容但保留已申请的空间
+    std::string str;
+
     // 全局变量遍历输出对应的declare指令
     for (auto var: globalVariableVector) {
 
-        std::string str;
+        str.clear();
         var->toDeclareString(str);
-        fprintf(fp, "%s\n", str.c_str());
+        str += "\n";
+        fwrite(str.data(), 1, str.size(), fp);
     }
 
     // 遍历所有的线性IR指令，文本输出
     for (auto func: funcVector) {
 
-        std::string func_ir = func->toString(); // <--- 新调用
-        fprintf(fp, "%s", func_ir.c_str());   
+        str.clear();
+        func->toString(str);
+        fwrite(str.data(), 1, str.size(), fp);
     }
 
     fclose(fp);
@@ -322,49 +344,58 @@ void Module::outputIR(const std::string & filePath)
 // Module.cpp
 // Module.cpp
 Value* Module::newTemporary(Type* type, const std::string& prefix) { // prefix 可以用于生成占位符，但不是必须的
-    // 我们将传递一个空字符串作为初始的 IRName。
-    // 最终的、唯一的 IRName 将由 Function::renameIR() 设置。
-    std::string initial_ir_name; // 或者: initial_ir_name = "%temp_placeholder_" + prefix;
-    
-    auto temp_val = new TempVariable(type, initial_ir_name); // 调用双参数构造函数
-
+    // 临时变量创建时不命名，IR名字的编号在输出IR前由 Function::renameIR() 分配。
     Function* currentFunc = getCurrentFunction();
-    if (currentFunc) {
-        currentFunc->addTempVar(temp_val);
+    if (!currentFunc) {
+        return new TempVariable(type);
     }
+
+    // 函数内的临时变量从函数的内存池中分配，随函数一起释放
+    auto temp_val = currentFunc->getArena().create<TempVariable>(type);
+    currentFunc->numberValue(temp_val);
+    currentFunc->addTempVar(temp_val);
     return temp_val;
 }
 
 ConstInt* Module::newConstInt(int32_t val, Type* type) {
     if (!type) {
         // 默认创建 i32 类型的常量
-        type = IntegerType::get(32); // 确保 IntegerType::get(32) 可用
+        type = IntegerType::getTypeInt();
     }
     // 注意这里返回类型是 ConstInt*，所以需要 static_cast
     return static_cast<ConstInt*>(getOrCreateIntegerConstant(type, val));
 }
 
+/// @brief 获取整型常量，同一类型同一值只有一份，可多线程调用，常量共享后只读
+/// @param type 整数类型
+/// @param value 整数值
+/// @return Constant* 常量，类型不是整数类型时为空
 Constant* Module::getOrCreateIntegerConstant(Type* type, int32_t value) {
     if (!type || !type->isIntegerType()) {
          minic_log(LOG_ERROR,"请求创建非整数类型的整数常量。");
         return nullptr; 
     }
+
+    auto * intType = static_cast<IntegerType*>(type);
+
+    // 常用的小整数常量随类型预先创建，不需要查表加锁
+    ConstInt * small = intType->getSmallConstant(value);
+    if (small) {
+        return small;
+    }
+
     // 对于i1，值通常是0或1
-    if (static_cast<IntegerType*>(type)->getBitWidth() == 1 && (value != 0 && value != 1)) {
+    if (intType->getBitWidth() == 1) {
         minic_log(LOG_WARNING,"为i1类型创建了非0/1的常量值: %d", value);
-        // 可以选择将其规范化为0或1，或者允许
     }
 
-    std::pair<Type*, int32_t> cache_key = {type, value};
-    auto it = integer_constant_cache_.find(cache_key);
-    if (it != integer_constant_cache_.end()) {
-        return it->second;
+    std::lock_guard<std::mutex> lock(constIntMutex);
+
+    ConstInt *& slot = constIntTable[ConstIntKey{type, value}];
+    if (!slot) {
+        slot = new ConstInt(type, value);
     }
-    
-    ConstInt* new_const = new ConstInt(type, value); // 使用修改后的 ConstInt 构造函数
-    integer_constant_cache_[cache_key] = new_const;
-    // 你可能还需要将 new_const 添加到总的 values 列表或其他管理结构中
-    return new_const;
+    return slot;
 }
 ScopeStack * Module::getScopeStack()
 {
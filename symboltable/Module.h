@@ -2,8 +2,8 @@
 /// @file Module.h
 /// @brief 符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,20 +11,22 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>名字查找改为按标识符驻留编号
+/// <tr><td>2026-10-16 <td>1.2     <td>zenglj  <td>整型常量统一为按(类型, 值)的加锁常量表，预建小整数常量
 /// </table>
 ///
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "ConstInt.h"
+#include "Symbol.h"
 #include "Type.h"
 #include "GlobalVariable.h"
 #include "Function.h"
-#include <map>
-#include <utility>
 
 class ScopeStack;
 
@@ -89,9 +91,9 @@ public:
     newFunction(std::string name, Type * returnType, std::vector<FormalParam *> params = {}, bool builtin = false);
 
     /// @brief 根据函数名查找函数信息
-    /// @param name 函数名
+    /// @param name 函数名的驻留编号
     /// @return 函数信息
-    Function * findFunction(std::string name);
+    Function * findFunction(SymbolId name);
 
     ///
     /// @brief 获取全局变量列表，用于外部遍历全局变量
@@ -108,22 +110,22 @@ public:
         return funcVector;
     }
 
-    /// @brief 新建一个整型数值的Value，并加入到符号表，用于后续释放空间
-    /// \param intVal 整数值
-    /// \return 临时Value
-    
+    /// @brief 获取整型常量，同一类型同一值只有一份，可多线程调用，常量共享后只读
+    /// @param type 整数类型
+    /// @param value 整数值
+    /// @return Constant* 常量，类型不是整数类型时为空
 	Constant* getOrCreateIntegerConstant(Type* type, int32_t value); 
     /// @brief 新建变量型Value，会根据currentFunc的值进行判断创建全局或者局部变量
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
-    /// @param name 变量ID
+    /// @param name 变量ID，SYMBOL_NONE表示匿名变量
     /// @param type 变量类型
-    Value * newVarValue(Type * type, std::string name = "");
+    Value * newVarValue(Type * type, SymbolId name = SYMBOL_NONE);
 
     /// @brief 查找变量（全局变量或局部变量），会根据作用域栈进行逐级查找。
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
     /// @param name 变量ID
     /// @return 指针有效则找到，空指针未找到
-    Value * findVarValue(std::string name);
+    Value * findVarValue(SymbolId name);
 
     /// @brief 清理Module中管理的所有信息资源
     void Delete();
@@ -146,17 +148,17 @@ public:
     /// @param name 名字
     /// @return Value* 全局变量
     ///
-    GlobalVariable * newGlobalVariable(Type * type, std::string name);
+    GlobalVariable * newGlobalVariable(Type * type, SymbolId name);
 
     /// @brief 根据变量名获取当前符号（只管理全局变量）
     /// \param name 变量名
     /// \return 变量对应的值
-    GlobalVariable * findGlobalVariable(std::string name);
+    GlobalVariable * findGlobalVariable(SymbolId name);
     
 protected:
-    /// @brief 根据整数值获取当前符号
-    /// \param name 变量名
-    /// \return 变量对应的值
+    /// @brief 根据整数值查找int类型的常量
+    /// \param val 整数值
+    /// \return 常量，不存在时为空
     ConstInt * findConstInt(int32_t val);
 
    
@@ -192,23 +194,43 @@ private:
     /// @brief 遍历抽象树过程中的当前处理函数
     Function * currentFunc = nullptr;
 
-    /// @brief 函数映射表，函数名-函数，便于检索
-    std::unordered_map<std::string, Function *> funcMap;
+    /// @brief 函数映射表，函数名的驻留编号-函数，便于检索
+    std::unordered_map<SymbolId, Function *> funcMap;
 
     /// @brief  函数列表
     std::vector<Function *> funcVector;
 
-    /// @brief 变量名映射表，变量名-变量，只保存全局变量
-    std::unordered_map<std::string, GlobalVariable *> globalVariableMap;
+    /// @brief 变量名映射表，变量名的驻留编号-变量，只保存全局变量
+    std::unordered_map<SymbolId, GlobalVariable *> globalVariableMap;
 
     /// @brief 只保存全局变量
     std::vector<GlobalVariable *> globalVariableVector;
 
-    /// @brief 常量表
-    std::unordered_map<int32_t, ConstInt *> constIntMap;
+    /// @brief 整型常量表的键，类型与值
+    struct ConstIntKey {
+        Type * type;
+        int32_t val;
 
-    int temp_var_counter_ = 0; // 用于生成唯一的临时变量名
+        bool operator==(const ConstIntKey & other) const
+        {
+            return type == other.type && val == other.val;
+        }
+    };
+
+    /// @brief 整型常量表键的散列函数
+    struct ConstIntKeyHash {
+        size_t operator()(const ConstIntKey & key) const
+        {
+            return std::hash<const void *>()(key.type) ^ ((size_t) (uint32_t) key.val * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    /// @brief 保护整型常量表
+    std::mutex constIntMutex;
 
-    std::map<std::pair<Type*, int32_t>, ConstInt*> integer_constant_cache_;
+    /// @brief 整型常量表，(类型, 值)-常量，预先创建的小整数常量不在表中
+    std::unordered_map<ConstIntKey, ConstInt *, ConstIntKeyHash> constIntTable;
+
+    int temp_var_counter_ = 0; // 用于生成唯一的临时变量名
 };
 
@@ -2,8 +2,8 @@
 /// @file ScopeStack.cpp
 /// @brief 作用域栈管理
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-19
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-19 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>名字查找改为按标识符驻留编号
 /// </table>
 ///
 #include "ScopeStack.h"
@@ -21,7 +22,7 @@
 void ScopeStack::enterScope()
 {
     // 在栈顶新加入一层，没有变量
-    std::unordered_map<std::string, Value *> valueMap;
+    std::unordered_map<SymbolId, Value *> valueMap;
     valueStack.emplace_back(valueMap);
 }
 
@@ -35,11 +36,15 @@ void ScopeStack::leaveScope()
 
 ///
 /// @brief 向当前的作用域中加入变量
+/// @param name 变量名
 /// @param value 变量
 ///
-void ScopeStack::insertValue(Value * value)
+void ScopeStack::insertValue(SymbolId name, Value * value)
 {
-    valueStack.back().insert(make_pair(value->getName(), value));
+    // 匿名变量不会按名字查找，不需要加入
+    if (name != SYMBOL_NONE) {
+        valueStack.back().insert(std::make_pair(name, value));
+    }
 }
 
 ///
@@ -47,7 +52,7 @@ void ScopeStack::insertValue(Value * value)
 /// @param  name 变量名
 /// @return Value* 变量对象，若没有，则返回空指针
 ///
-Value * ScopeStack::findCurrentScope(std::string name)
+Value * ScopeStack::findCurrentScope(SymbolId name)
 {
     // 在栈顶的作用域中查找，即当前作用域
     auto it = valueStack.back().find(name);
@@ -62,7 +67,7 @@ Value * ScopeStack::findCurrentScope(std::string name)
 /// @param  name 变量名
 /// @return Value* 变量对象。若没有，则返回空指针
 ///
-Value * ScopeStack::findAllScope(std::string name)
+Value * ScopeStack::findAllScope(SymbolId name)
 {
     // 模拟栈操作，从栈顶开始查找
     for (auto it = valueStack.rbegin(); it != valueStack.rend(); ++it) {
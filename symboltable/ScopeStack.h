@@ -2,8 +2,8 @@
 /// @file ScopeStack.h
 /// @brief 作用域栈管理
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-19
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-19 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>名字查找改为按标识符驻留编号
 /// </table>
 ///
 #pragma once
@@ -18,6 +19,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Symbol.h"
 #include "Value.h"
 
 ///
@@ -29,16 +31,17 @@ class ScopeStack {
 public:
     ///
     /// @brief 向当前的作用域中加入变量
+    /// @param name 变量名
     /// @param value 变量
     ///
-    void insertValue(Value * value);
+    void insertValue(SymbolId name, Value * value);
 
     ///
     /// @brief 从当前的作用域中查找指定的变量名
     /// @param  name 变量名
     /// @return Value* 变量对象，若没有，则返回空指针
     ///
-    Value * findCurrentScope(std::string name);
+    Value * findCurrentScope(SymbolId name);
 
     ///
     /// @brief 获取当前的作用域栈的层号
@@ -51,7 +54,7 @@ public:
     /// @param  name 变量名
     /// @return Value* 变量对象。若没有，则返回空指针
     ///
-    Value * findAllScope(std::string name);
+    Value * findAllScope(SymbolId name);
 
     ///
     /// @brief 进入作用域
@@ -65,7 +68,7 @@ public:
 
 protected:
     ///
-    /// @brief 变量作用域栈，最外层用vector来模拟栈，每一层用unordered_map来实现，变量名为key，变量为value
+    /// @brief 变量作用域栈，最外层用vector来模拟栈，每一层用unordered_map来实现，变量名的驻留编号为key，变量为value
     ///
-    std::vector<std::unordered_map<std::string, Value *>> valueStack;
+    std::vector<std::unordered_map<SymbolId, Value *>> valueStack;
 };
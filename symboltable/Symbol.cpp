@@ -0,0 +1,165 @@
+///
+/// @file Symbol.cpp
+/// @brief 标识符驻留池，标识符只保存一份，以32位编号引用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>散列表按标识符分片加锁，编号超过上限时报错
+/// </table>
+///
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "Common.h"
+#include "Symbol.h"
+
+/// @brief 每个分块中的标识符个数，按2的幂次便于用移位计算下标
+#define SYMBOL_CHUNK_BITS 12
+#define SYMBOL_CHUNK_SIZE (1u << SYMBOL_CHUNK_BITS)
+
+/// @brief 最大分块个数，共可驻留16M个标识符
+#define SYMBOL_MAX_CHUNKS 4096
+
+/// @brief 散列表的分片个数，按标识符的散列值选择分片，减少多线程驻留时的锁竞争
+#define SYMBOL_SHARD_COUNT 16
+
+///
+/// @brief 标识符驻留池的一个分片，各自有独立的锁与散列表
+///
+struct SymbolShard {
+
+    /// @brief 保护index
+    std::mutex mutex;
+
+    /// @brief 标识符到编号的映射
+    std::unordered_map<std::string_view, SymbolId> index;
+};
+
+///
+/// @brief 标识符驻留池
+///
+/// 标识符按编号存放在分块数组中，分块一旦分配就不再移动，因此symbol_name无需加锁，
+/// 返回的引用也一直有效。散列表的键直接引用分块中的字符串，标识符的内容只保存一份。
+/// 同一个标识符总落在同一个分片，编号由原子计数器分配，分块用CAS安装。
+///
+struct SymbolPool {
+
+    /// @brief 散列表分片
+    SymbolShard shards[SYMBOL_SHARD_COUNT];
+
+    /// @brief 分块数组，第0号编号保留给空串
+    std::atomic<std::string *> chunks[SYMBOL_MAX_CHUNKS] = {};
+
+    /// @brief 已分配的编号个数
+    std::atomic<uint32_t> count{1};
+
+    SymbolPool()
+    {
+        chunks[0].store(new std::string[SYMBOL_CHUNK_SIZE], std::memory_order_release);
+    }
+};
+
+/// @brief 获取进程唯一的驻留池，首次使用时创建，进程结束前不释放
+/// @return SymbolPool& 驻留池
+static SymbolPool & symbolPool()
+{
+    static SymbolPool * pool = new SymbolPool();
+    return *pool;
+}
+
+/// @brief 获取编号所在的分块，不存在时分配，多个线程同时分配时只保留一个
+/// @param pool 驻留池
+/// @param chunkNo 分块序号
+/// @return std::string* 分块
+static std::string * symbolChunk(SymbolPool & pool, uint32_t chunkNo)
+{
+    std::string * chunk = pool.chunks[chunkNo].load(std::memory_order_acquire);
+    if (chunk != nullptr) {
+        return chunk;
+    }
+
+    std::string * fresh = new std::string[SYMBOL_CHUNK_SIZE];
+    if (pool.chunks[chunkNo].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+        return fresh;
+    }
+
+    // 其它线程已经安装了分块，chunk为其安装的分块
+    delete[] fresh;
+    return chunk;
+}
+
+///
+/// @brief 驻留标识符，若已存在则返回已有的编号。可在多个线程中同时调用
+/// @param str 标识符首地址，不要求以0结尾
+/// @param len 标识符长度
+/// @return SymbolId 编号，空串为SYMBOL_NONE
+///
+SymbolId intern_symbol(const char * str, size_t len)
+{
+    if (len == 0) {
+        return SYMBOL_NONE;
+    }
+
+    SymbolPool & pool = symbolPool();
+    std::string_view key(str, len);
+    SymbolShard & shard = pool.shards[std::hash<std::string_view>()(key) % SYMBOL_SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        return it->second;
+    }
+
+    SymbolId id = pool.count.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t chunkNo = id >> SYMBOL_CHUNK_BITS;
+    if (chunkNo >= SYMBOL_MAX_CHUNKS) {
+        minic_log(LOG_ERROR,
+                  "标识符个数超过上限%u，不能驻留标识符(%.*s)",
+                  SYMBOL_MAX_CHUNKS * SYMBOL_CHUNK_SIZE,
+                  (int) len,
+                  str);
+        throw std::length_error("symbol pool exhausted");
+    }
+
+    // 分片的锁保证其它线程经散列表拿到编号时，分块中的字符串已经写好
+    std::string & slot = symbolChunk(pool, chunkNo)[id & (SYMBOL_CHUNK_SIZE - 1)];
+    slot.assign(str, len);
+
+    shard.index.emplace(std::string_view(slot), id);
+
+    return id;
+}
+
+///
+/// @brief 驻留标识符
+/// @param str 标识符
+/// @return SymbolId 编号，空串为SYMBOL_NONE
+///
+SymbolId intern_symbol(const std::string & str)
+{
+    return intern_symbol(str.data(), str.size());
+}
+
+///
+/// @brief 获取编号对应的标识符，返回的引用在整个进程内有效
+/// @param id 由intern_symbol返回的编号
+/// @return const std::string& 标识符
+///
+const std::string & symbol_name(SymbolId id)
+{
+    std::string * chunk = symbolPool().chunks[id >> SYMBOL_CHUNK_BITS].load(std::memory_order_acquire);
+
+    return chunk[id & (SYMBOL_CHUNK_SIZE - 1)];
+}
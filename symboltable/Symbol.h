@@ -0,0 +1,50 @@
+///
+/// @file Symbol.h
+/// @brief 标识符驻留池，标识符只保存一份，以32位编号引用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///
+/// @brief 驻留后的标识符编号，相同的标识符编号相同，比较与散列都是整数运算
+///
+typedef uint32_t SymbolId;
+
+/// @brief 空标识符的编号，用于匿名的变量等
+#define SYMBOL_NONE ((SymbolId) 0)
+
+///
+/// @brief 驻留标识符，若已存在则返回已有的编号。可在多个线程中同时调用
+/// @param str 标识符首地址，不要求以0结尾
+/// @param len 标识符长度
+/// @return SymbolId 编号，空串为SYMBOL_NONE
+///
+SymbolId intern_symbol(const char * str, size_t len);
+
+///
+/// @brief 驻留标识符
+/// @param str 标识符
+/// @return SymbolId 编号，空串为SYMBOL_NONE
+///
+SymbolId intern_symbol(const std::string & str);
+
+///
+/// @brief 获取编号对应的标识符，返回的引用在整个进程内有效
+/// @param id 由intern_symbol返回的编号
+/// @return const std::string& 标识符
+///
+const std::string & symbol_name(SymbolId id);
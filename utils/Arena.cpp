@@ -0,0 +1,136 @@
+///
+/// @file Arena.cpp
+/// @brief 内存池，按块分配、整体释放
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>增加adopt，接管其它内存池
+/// </table>
+///
+#include <cstdlib>
+
+#include "Arena.h"
+
+///
+/// @brief 当前内存块空间不足时申请新的内存块
+/// @param size 字节数
+/// @param align 对齐要求
+/// @return void* 内存首地址
+///
+void * Arena::allocateSlow(size_t size, size_t align)
+{
+    // 超过块大小四分之一的大对象单独申请一块，避免浪费当前块的剩余空间
+    size_t header = (sizeof(Block) + align - 1) & ~(align - 1);
+    bool large = size > blockSize / 4;
+    size_t bytes = large ? header + size : blockSize;
+
+    Block * block = static_cast<Block *>(malloc(bytes));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    bytesReserved += bytes;
+
+    char * p = (char *) block + header;
+
+    if (large && blocks != nullptr) {
+        // 大对象的块插在当前块之后，当前块继续用于后续的分配
+        block->prev = blocks->prev;
+        blocks->prev = block;
+        return p;
+    }
+
+    block->prev = blocks;
+    blocks = block;
+    cur = p + size;
+    end = (char *) block + bytes;
+
+    return p;
+}
+
+///
+/// @brief 登记对象的析构函数
+/// @param destroy 析构函数
+/// @param obj 对象
+///
+void Arena::addFinalizer(void (*destroy)(void *), void * obj)
+{
+    Finalizer * fin = static_cast<Finalizer *>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+    fin->destroy = destroy;
+    fin->obj = obj;
+    fin->next = finalizers;
+    finalizers = fin;
+}
+
+///
+/// @brief 释放所有对象与内存块，内存池可继续使用
+///
+void Arena::reset()
+{
+    // 先按创建的逆序析构对象，析构时对象所在的内存还有效
+    for (Finalizer * fin = finalizers; fin != nullptr; fin = fin->next) {
+        fin->destroy(fin->obj);
+    }
+    finalizers = nullptr;
+
+    while (blocks != nullptr) {
+        Block * prev = blocks->prev;
+        free(blocks);
+        blocks = prev;
+    }
+
+    cur = end = nullptr;
+    bytesReserved = 0;
+}
+
+///
+/// @brief 接管另一个内存池的所有内存块与待析构对象，other变为空
+/// @param other 被接管的内存池
+///
+void Arena::adopt(Arena & other)
+{
+    if (&other == this || other.blocks == nullptr) {
+        return;
+    }
+
+    if (blocks == nullptr) {
+        // 本内存池为空，直接继续使用other的当前块
+        blocks = other.blocks;
+        cur = other.cur;
+        end = other.end;
+    } else {
+        // other的内存块链表插在当前块之后，当前块继续用于后续的分配
+        Block * tail = other.blocks;
+        while (tail->prev != nullptr) {
+            tail = tail->prev;
+        }
+
+        tail->prev = blocks->prev;
+        blocks->prev = other.blocks;
+    }
+
+    // other的对象创建得较晚，析构记录放在前面，保持逆序析构
+    if (other.finalizers != nullptr) {
+        Finalizer * last = other.finalizers;
+        while (last->next != nullptr) {
+            last = last->next;
+        }
+
+        last->next = finalizers;
+        finalizers = other.finalizers;
+    }
+
+    bytesReserved += other.bytesReserved;
+
+    other.blocks = nullptr;
+    other.cur = other.end = nullptr;
+    other.finalizers = nullptr;
+    other.bytesReserved = 0;
+}
@@ -0,0 +1,173 @@
+///
+/// @file Arena.h
+/// @brief 内存池，按块分配、整体释放
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>增加adopt，接管其它内存池
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+///
+/// @brief 内存池
+///
+/// 从大块内存中顺序切分（bump allocation），不支持单个对象的释放，
+/// 所有对象在reset或析构时一起释放，释放的代价只与内存块的个数相关。
+/// 对于析构函数不平凡的对象，create会记录其析构函数，释放前按创建的逆序调用。
+///
+class Arena {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _blockSize 每次向系统申请的内存块大小
+    ///
+    explicit Arena(size_t _blockSize = 64 * 1024) : blockSize(_blockSize)
+    {}
+
+    ///
+    /// @brief 析构函数，释放所有内存块
+    ///
+    ~Arena()
+    {
+        reset();
+    }
+
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    ///
+    /// @brief 分配内存
+    /// @param size 字节数
+    /// @param align 对齐要求，必须是2的幂次
+    /// @return void* 内存首地址
+    ///
+    void * allocate(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        uintptr_t p = ((uintptr_t) cur + align - 1) & ~(uintptr_t) (align - 1);
+        if (p + size <= (uintptr_t) end) {
+            cur = (char *) (p + size);
+            return (void *) p;
+        }
+
+        return allocateSlow(size, align);
+    }
+
+    ///
+    /// @brief 分配n个T类型元素的数组空间，不调用构造函数
+    /// @tparam T 元素类型
+    /// @param n 元素个数
+    /// @return T* 数组首地址
+    ///
+    template <typename T>
+    T * allocateArray(size_t n)
+    {
+        return static_cast<T *>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    ///
+    /// @brief 在内存池中创建对象
+    /// @tparam T 对象类型
+    /// @param args 构造函数的参数
+    /// @return T* 对象
+    ///
+    template <typename T, typename... Args>
+    T * create(Args &&... args)
+    {
+        T * obj = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            addFinalizer([](void * p) { static_cast<T *>(p)->~T(); }, obj);
+        }
+
+        return obj;
+    }
+
+    ///
+    /// @brief 释放所有对象与内存块，内存池可继续使用
+    ///
+    void reset();
+
+    ///
+    /// @brief 接管另一个内存池的所有内存块与待析构对象，other变为空
+    ///
+    /// 用于把其它线程中创建的对象并入本内存池，之后随本内存池一起释放。
+    /// 调用时other所属的线程不能再在other中分配。
+    ///
+    /// @param other 被接管的内存池
+    ///
+    void adopt(Arena & other);
+
+    ///
+    /// @brief 获取已向系统申请的内存字节数
+    /// @return size_t 字节数
+    ///
+    size_t getBytesReserved() const
+    {
+        return bytesReserved;
+    }
+
+private:
+    ///
+    /// @brief 内存块头部，内存块通过prev组成链表
+    ///
+    struct Block {
+        Block * prev;
+    };
+
+    ///
+    /// @brief 需要析构的对象，记录本身也从内存池中分配
+    ///
+    struct Finalizer {
+        void (*destroy)(void *);
+        void * obj;
+        Finalizer * next;
+    };
+
+    ///
+    /// @brief 当前内存块空间不足时申请新的内存块
+    /// @param size 字节数
+    /// @param align 对齐要求
+    /// @return void* 内存首地址
+    ///
+    void * allocateSlow(size_t size, size_t align);
+
+    ///
+    /// @brief 登记对象的析构函数
+    /// @param destroy 析构函数
+    /// @param obj 对象
+    ///
+    void addFinalizer(void (*destroy)(void *), void * obj);
+
+    /// @brief 内存块的缺省大小
+    size_t blockSize;
+
+    /// @brief 最近申请的内存块
+    Block * blocks = nullptr;
+
+    /// @brief 当前内存块中的空闲位置
+    char * cur = nullptr;
+
+    /// @brief 当前内存块的结束位置
+    char * end = nullptr;
+
+    /// @brief 需要析构的对象链表，后创建的在前
+    Finalizer * finalizers = nullptr;
+
+    /// @brief 已向系统申请的内存字节数
+    size_t bytesReserved = 0;
+};
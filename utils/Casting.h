@@ -0,0 +1,88 @@
+///
+/// @file Casting.h
+/// @brief 基于种类标记的isa、cast与dyn_cast，代替dynamic_cast
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 目标类要提供静态函数classof，根据对象中保存的种类标记判断对象是否属于该类，
+/// 判断只是整数比较，不需要像dynamic_cast那样遍历RTTI的继承层次。
+///
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+///
+/// @brief 判断对象是否属于类To，对象不能为空
+/// @tparam To 目标类
+/// @tparam From 对象的静态类型
+/// @param val 对象
+/// @return true 属于 false 不属于
+///
+template <typename To, typename From>
+inline bool isa(const From * val)
+{
+    assert(val && "isa<> used on a null pointer");
+
+    if constexpr (std::is_base_of_v<To, From>) {
+        // 向上转换总是成立
+        return true;
+    } else {
+        return To::classof(val);
+    }
+}
+
+///
+/// @brief 转换后的指针类型，保持源指针的const属性
+///
+template <typename To, typename From>
+using cast_result_t = std::conditional_t<std::is_const_v<From>, const To *, To *>;
+
+///
+/// @brief 转换为类To，调用者保证对象属于类To
+/// @tparam To 目标类
+/// @tparam From 对象的静态类型
+/// @param val 对象，不能为空
+/// @return 转换后的指针
+///
+template <typename To, typename From>
+inline cast_result_t<To, From> cast(From * val)
+{
+    assert(isa<To>(val) && "cast<> argument of incompatible type");
+    return static_cast<cast_result_t<To, From>>(val);
+}
+
+///
+/// @brief 对象属于类To时转换，否则返回空指针
+/// @tparam To 目标类
+/// @tparam From 对象的静态类型
+/// @param val 对象，不能为空
+/// @return 转换后的指针，不属于类To时为空
+///
+template <typename To, typename From>
+inline cast_result_t<To, From> dyn_cast(From * val)
+{
+    return isa<To>(val) ? static_cast<cast_result_t<To, From>>(val) : nullptr;
+}
+
+///
+/// @brief 同dyn_cast，但对象可以为空，为空时返回空指针
+/// @tparam To 目标类
+/// @tparam From 对象的静态类型
+/// @param val 对象
+/// @return 转换后的指针，对象为空或不属于类To时为空
+///
+template <typename To, typename From>
+inline cast_result_t<To, From> dyn_cast_or_null(From * val)
+{
+    return (val && isa<To>(val)) ? static_cast<cast_result_t<To, From>>(val) : nullptr;
+}
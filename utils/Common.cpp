@@ -2,8 +2,8 @@
 /// @file Common.cpp
 /// @brief 共通函数
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>日志按级别过滤，不输出的日志不求值参数
 /// </table>
 ///
 #include <cstdint>
@@ -95,6 +96,9 @@ std::string trim(const std::string & str)
     return str.substr(pos);
 }
 
+/// @brief 日志的输出级别，级别低于它的日志不输出，缺省不输出调试日志
+int minic_log_level = LOG_INFO;
+
 void minic_log_common(int level, const char * content)
 {
     if (level != LOG_ERROR) {
@@ -2,8 +2,8 @@
 /// @file Common.cpp
 /// @brief 共通函数头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-16
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-16 <td>1.1     <td>zenglj  <td>日志按级别过滤，不输出的日志不求值参数
 /// </table>
 ///
 #pragma once
@@ -63,11 +64,20 @@ std::string trim(const std::string & str);
 #define LOG_ERROR 2
 #define LOG_WARNING 3
 
+/// @brief 日志的输出级别，级别低于它的日志不输出，缺省不输出调试日志
+extern int minic_log_level;
+
 void minic_log_common(int level, const char * content);
 
+/// @brief 判断指定级别的日志是否输出，日志内容需要单独生成时先用它判断
+#define minic_log_enabled(level) ((level) >= minic_log_level)
+
+/// @brief 输出日志，级别不输出时不求值参数，也不格式化日志内容
 #define minic_log(level, fmt, args...)                                                                                 \
     do {                                                                                                               \
-        char max_buf[1024];                                                                                            \
-        snprintf(max_buf, sizeof(max_buf), "%s:%d " fmt "\n", __FILE__, __LINE__, ##args);                             \
-        minic_log_common(level, max_buf);                                                                              \
+        if (minic_log_enabled(level)) {                                                                                \
+            char max_buf[1024];                                                                                        \
+            snprintf(max_buf, sizeof(max_buf), "%s:%d " fmt "\n", __FILE__, __LINE__, ##args);                         \
+            minic_log_common(level, max_buf);                                                                          \
+        }                                                                                                              \
     } while (0)
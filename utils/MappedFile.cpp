@@ -0,0 +1,92 @@
+///
+/// @file MappedFile.cpp
+/// @brief 基于mmap的只读源文件映射
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+///
+/// @brief 映射文件
+/// @param path 文件路径
+/// @param padding 文件内容后需要保证的0字节个数
+/// @return true：成功 false：不是普通文件、空文件或映射失败
+///
+bool MappedFile::open(const std::string & path, size_t padding)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // 管道、终端以及空文件都不映射，交给调用者按流方式读取
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t fileSize = (size_t) st.st_size;
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t total = (fileSize + padding + pageSize - 1) / pageSize * pageSize;
+
+    // 先保留一段匿名的全0区域，再把文件覆盖映射到其开头。
+    // 文件最后一页中超出文件长度的部分由内核清0，其后的页来自匿名映射，
+    // 这样即使文件长度恰好是页大小的整数倍，padding部分也是可访问的0字节。
+    void * region = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    void * mapped = mmap(region, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        munmap(region, total);
+        return false;
+    }
+
+    // 词法分析是顺序扫描，提示内核提前预读
+    (void) madvise(region, total, MADV_SEQUENTIAL);
+
+    base = static_cast<char *>(region);
+    length = fileSize;
+    mapLength = total;
+
+    return true;
+}
+
+///
+/// @brief 解除映射
+///
+void MappedFile::close()
+{
+    if (base) {
+        munmap(base, mapLength);
+        base = nullptr;
+        length = 0;
+        mapLength = 0;
+    }
+}
@@ -0,0 +1,86 @@
+///
+/// @file MappedFile.h
+/// @brief 基于mmap的只读源文件映射
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+///
+/// @brief 把整个源文件一次性映射到内存中，供词法分析器直接扫描
+///
+/// 映射采用MAP_PRIVATE方式，可写但写入不会回写文件；文件内容之后额外保证有
+/// padding个值为0的字节，便于flex的yy_scan_buffer或者手写扫描器作为结束哨兵。
+/// 只支持普通文件，管道、终端等无法映射的输入由调用者回退到stdio方式。
+///
+class MappedFile {
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ///
+    /// @brief 映射文件
+    /// @param path 文件路径
+    /// @param padding 文件内容后需要保证的0字节个数
+    /// @return true：成功 false：不是普通文件、空文件或映射失败
+    ///
+    bool open(const std::string & path, size_t padding = 2);
+
+    ///
+    /// @brief 解除映射
+    ///
+    void close();
+
+    ///
+    /// @brief 映射区首地址，后跟padding个0字节
+    /// @return char* 首地址，未映射时为nullptr
+    ///
+    char * data() const
+    {
+        return base;
+    }
+
+    ///
+    /// @brief 文件内容的字节数，不含padding
+    /// @return size_t 字节数
+    ///
+    size_t size() const
+    {
+        return length;
+    }
+
+    ///
+    /// @brief 是否已映射
+    /// @return true：已映射 false：未映射
+    ///
+    bool isMapped() const
+    {
+        return base != nullptr;
+    }
+
+private:
+    /// @brief 映射区首地址
+    char * base = nullptr;
+
+    /// @brief 文件内容长度
+    size_t length = 0;
+
+    /// @brief 整个映射区长度（按页对齐，包含padding）
+    size_t mapLength = 0;
+};